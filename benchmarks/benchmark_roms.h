@@ -0,0 +1,32 @@
+// Shared helpers for loading the example programs in benchmarks
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace EaterEmulator::benchmarks
+{
+    // Reads <rom dir>/<name>.bin, returns an empty vector if the ROM was not assembled.
+    // EATER_ROM_DIR in the environment overrides the directory configured by CMake.
+    inline std::vector<uint8_t> loadRom(const std::string& name)
+    {
+        std::filesystem::path dir = EATER_ROM_DIR;
+        if (const char* overrideDir = std::getenv("EATER_ROM_DIR"))
+        {
+            dir = overrideDir;
+        }
+        const auto path = dir / (name + ".bin");
+
+        std::vector<uint8_t> rom;
+        if (auto ifs = std::ifstream { path, std::ios::binary })
+        {
+            rom.resize(std::filesystem::file_size(path));
+            ifs.read(reinterpret_cast<char*>(rom.data()), rom.size());
+        }
+        return rom;
+    }
+}
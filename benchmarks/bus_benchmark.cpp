@@ -0,0 +1,96 @@
+// Benchmarks for Bus::notifySlaves dispatch
+#include "core/bus.h"
+#include "core/bus_slave.h"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace EaterEmulator;
+
+namespace
+{
+    // Slave that answers reads with the low address byte, as cheap as a device can be
+    class NullSlave : public core::BusSlave
+    {
+    public:
+        NullSlave(std::shared_ptr<core::Bus> bus, std::vector<core::AddressRange> ranges)
+            : core::BusSlave(bus), _ranges(std::move(ranges)) {}
+
+        void handleBusNotification(uint16_t address, uint8_t rwb) override
+        {
+            if (rwb == core::READ)
+            {
+                _bus->setData(static_cast<uint8_t>(address));
+            }
+        }
+
+        std::vector<core::AddressRange> getAddressRanges() const override { return _ranges; }
+        std::string getName() const override { return "NullSlave"; }
+
+    private:
+        std::vector<core::AddressRange> _ranges;
+    };
+
+    // Addresses spread over the first page of every slave so each access goes to a different one
+    std::vector<uint16_t> slaveAddresses(size_t slaveCount)
+    {
+        std::vector<uint16_t> addresses;
+        for (size_t i = 0; i < slaveCount; ++i)
+        {
+            addresses.push_back(static_cast<uint16_t>((i << 12) | 0x42));
+        }
+        return addresses;
+    }
+}
+
+// Slaves owning a 4K block each, dispatched through the page table
+static void BM_NotifySlaves(benchmark::State& state)
+{
+    const auto slaveCount = static_cast<size_t>(state.range(0));
+    auto bus = std::make_shared<core::Bus>();
+    std::vector<std::unique_ptr<NullSlave>> slaves;
+    for (size_t i = 0; i < slaveCount; ++i)
+    {
+        const auto start = static_cast<uint16_t>(i << 12);
+        slaves.push_back(std::make_unique<NullSlave>(bus, std::vector<core::AddressRange>{ { start, static_cast<uint16_t>(start + 0x0FFF) } }));
+        bus->addSlave(slaves.back().get());
+    }
+
+    const auto addresses = slaveAddresses(slaveCount);
+    size_t next = 0;
+    for (auto _ : state)
+    {
+        bus->setAddress(addresses[next]);
+        bus->notifySlaves(core::READ);
+        next = next + 1 == addresses.size() ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_NotifySlaves)->Arg(1)->Arg(4)->Arg(16);
+
+// Slaves without address ranges, each one is notified of every access
+static void BM_NotifyMonitors(benchmark::State& state)
+{
+    const auto slaveCount = static_cast<size_t>(state.range(0));
+    auto bus = std::make_shared<core::Bus>();
+    std::vector<std::unique_ptr<NullSlave>> slaves;
+    for (size_t i = 0; i < slaveCount; ++i)
+    {
+        slaves.push_back(std::make_unique<NullSlave>(bus, std::vector<core::AddressRange>{}));
+        bus->addSlave(slaves.back().get());
+    }
+
+    const auto addresses = slaveAddresses(slaveCount);
+    size_t next = 0;
+    for (auto _ : state)
+    {
+        bus->setAddress(addresses[next]);
+        bus->notifySlaves(core::READ);
+        next = next + 1 == addresses.size() ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_NotifyMonitors)->Arg(1)->Arg(4)->Arg(16);
@@ -0,0 +1,146 @@
+// Full-system benchmarks for the W65C02S half-cycle and instruction-stepped cores
+#include "benchmark_roms.h"
+
+#include "core/machine.h"
+#include "devices/W65C02S/W65C02S.h"
+#include "devices/W65C02S/opcodes.h"
+#include "devices/W65C51N/SerialSink.h"
+
+#include "benchmark/benchmark.h"
+#include "spdlog/spdlog.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace EaterEmulator;
+
+static void BM_DecodeOpcode(benchmark::State& state)
+{
+    uint8_t opcode = 0;
+    for (auto _ : state)
+    {
+        const auto& info = decodeOpcode(static_cast<Opcode>(opcode++));
+        benchmark::DoNotOptimize(info.cycles);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DecodeOpcode);
+
+namespace
+{
+    // The whole board running the program's ROM with the ACIA output captured in memory.
+    // Skips the benchmark and returns nullptr if the ROM is not found.
+    std::unique_ptr<core::Machine> makeMachine(benchmark::State& state, const std::string& program)
+    {
+        auto rom = benchmarks::loadRom(program);
+        if (rom.empty())
+        {
+            state.SkipWithError((program + ".bin not found, set EATER_ROM_DIR").c_str());
+            return nullptr;
+        }
+        spdlog::set_level(spdlog::level::info);
+
+        auto machine = std::make_unique<core::Machine>(rom);
+        machine->getACIA().setTransmitSink(std::make_shared<devices::MemorySink>());
+        return machine;
+    }
+}
+
+// Runs a program on the clock-phase core. wozmon prints its prompt and then polls the ACIA for input,
+// hello-world-final writes to the LCD and then spins.
+static void BM_SystemCycles(benchmark::State& state, const std::string& program)
+{
+    auto machine = makeMachine(state, program);
+    if (!machine)
+    {
+        return;
+    }
+    auto& cpu = machine->getCPU();
+    for (auto _ : state)
+    {
+        cpu.onClockStateChange(core::LOW);
+        cpu.onClockStateChange(core::HIGH);
+    }
+    state.counters["cycles/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_SystemCycles, wozmon, std::string("wozmon"));
+BENCHMARK_CAPTURE(BM_SystemCycles, hello_world, std::string("hello-world-final"));
+
+// Same machine as BM_SystemCycles, driven one instruction at a time through step()
+static void BM_SystemInstructions(benchmark::State& state, const std::string& program)
+{
+    auto machine = makeMachine(state, program);
+    if (!machine)
+    {
+        return;
+    }
+    auto& cpu = machine->getCPU();
+    uint64_t cycles = 0;
+    for (auto _ : state)
+    {
+        cycles += cpu.step();
+    }
+    state.counters["cycles/s"] = benchmark::Counter(static_cast<double>(cycles), benchmark::Counter::kIsRate);
+    state.counters["instructions/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_SystemInstructions, wozmon, std::string("wozmon"));
+BENCHMARK_CAPTURE(BM_SystemInstructions, hello_world, std::string("hello-world-final"));
+
+// Same again through the threaded interpreter, in batches of 1000 instructions
+static void BM_SystemThreaded(benchmark::State& state, const std::string& program)
+{
+    constexpr uint64_t BATCH = 1000;
+    auto machine = makeMachine(state, program);
+    if (!machine)
+    {
+        return;
+    }
+    auto& cpu = machine->getCPU();
+    uint64_t cycles = 0;
+    for (auto _ : state)
+    {
+        cycles += cpu.runInstructionsThreaded(BATCH);
+    }
+    state.counters["cycles/s"] = benchmark::Counter(static_cast<double>(cycles), benchmark::Counter::kIsRate);
+    state.counters["instructions/s"] = benchmark::Counter(static_cast<double>(state.iterations() * BATCH), benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_SystemThreaded, wozmon, std::string("wozmon"));
+BENCHMARK_CAPTURE(BM_SystemThreaded, hello_world, std::string("hello-world-final"));
+
+// Restores a booted machine, the starting point for forking many runs from one checkpoint
+static void BM_SystemRestore(benchmark::State& state, const std::string& program)
+{
+    auto machine = makeMachine(state, program);
+    if (!machine)
+    {
+        return;
+    }
+    machine->getCPU().runInstructions(100'000);
+    const auto checkpoint = machine->saveState();
+    for (auto _ : state)
+    {
+        machine->loadState(checkpoint);
+    }
+    state.counters["bytes"] = static_cast<double>(checkpoint.size());
+}
+BENCHMARK_CAPTURE(BM_SystemRestore, wozmon, std::string("wozmon"));
+
+// Forks a booted machine and runs the fork for a while, the alternative to restoring a checkpoint
+static void BM_SystemFork(benchmark::State& state, const std::string& program)
+{
+    auto machine = makeMachine(state, program);
+    if (!machine)
+    {
+        return;
+    }
+    machine->getCPU().runInstructions(100'000);
+    const auto sink = std::make_shared<devices::MemorySink>();
+    for (auto _ : state)
+    {
+        auto fork = machine->fork();
+        fork->getACIA().setTransmitSink(sink);
+        fork->getCPU().runInstructions(state.range(0));
+    }
+}
+BENCHMARK_CAPTURE(BM_SystemFork, wozmon, std::string("wozmon"))->Arg(0)->Arg(1000);
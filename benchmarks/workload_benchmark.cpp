@@ -0,0 +1,193 @@
+// Synthetic workloads exercising one kind of instruction each, on both W65C02S cores and both dispatches of
+// the instruction-stepped one
+#include "core/bus.h"
+#include "devices/EEPROM28C256/EEPROM28C256.h"
+#include "devices/SRAM62256/SRAM62256.h"
+#include "devices/W65C02S/W65C02S.h"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace EaterEmulator;
+
+namespace
+{
+    constexpr uint16_t ROM_BASE = 0x8000;
+
+    // Each program starts at 0x8000 and loops forever
+
+    // Register arithmetic and logic only
+    const std::vector<uint8_t> ALU_LOOP = {
+        0xA9, 0x00,         // 8000:       LDA #$00
+        0x18,               // 8002: loop: CLC
+        0x69, 0x07,         //             ADC #$07
+        0x49, 0x5A,         //             EOR #$5A
+        0x0A,               //             ASL A
+        0x09, 0x01,         //             ORA #$01
+        0x29, 0x7F,         //             AND #$7F
+        0xAA,               //             TAX
+        0xE8,               //             INX
+        0x8A,               //             TXA
+        0x4C, 0x02, 0x80,   //             JMP loop
+    };
+
+    // Loads, stores and read-modify-write across zero page, absolute and indirect addressing
+    const std::vector<uint8_t> MEMORY_LOOP = {
+        0xA2, 0x00,         // 8000:       LDX #$00
+        0xBD, 0x00, 0x02,   // 8002: loop: LDA $0200,X
+        0x9D, 0x00, 0x03,   //             STA $0300,X
+        0xE6, 0x10,         //             INC $10
+        0xB1, 0x20,         //             LDA ($20),Y
+        0x95, 0x40,         //             STA $40,X
+        0xE8,               //             INX
+        0x4C, 0x02, 0x80,   //             JMP loop
+    };
+
+    // A tight countdown loop followed by taken and untaken conditional branches
+    const std::vector<uint8_t> BRANCH_LOOP = {
+        0xA2, 0x00,         // 8000:       LDX #$00
+        0xCA,               // 8002: loop: DEX
+        0xD0, 0xFD,         //             BNE loop
+        0xA0, 0x03,         //             LDY #$03
+        0xC0, 0x03,         //             CPY #$03
+        0xF0, 0x01,         //             BEQ skip
+        0xEA,               //             NOP
+        0x90, 0x00,         // 800C: skip: BCC next
+        0x4C, 0x02, 0x80,   // 800E: next: JMP loop
+    };
+
+    // Nested subroutine calls
+    const std::vector<uint8_t> JSR_LOOP = {
+        0xA2, 0xFF,         // 8000:       LDX #$FF
+        0x9A,               //             TXS
+        0x20, 0x0A, 0x80,   // 8003: loop: JSR sub
+        0x4C, 0x03, 0x80,   //             JMP loop
+        0xEA,               //             NOP
+        0xE8,               // 800A: sub:  INX
+        0x20, 0x10, 0x80,   //             JSR sub2
+        0x60,               //             RTS
+        0xEA,               //             NOP
+        0x60,               // 8010: sub2: RTS
+    };
+
+    // A decimal mode BCD counter and a shift-and-add 8x8 multiply
+    const std::vector<uint8_t> ARITHMETIC_LOOP = {
+        0xA2, 0x00,         // 8000:       LDX #$00
+        0xF8,               // 8002: loop: SED
+        0x18,               //             CLC
+        0xA5, 0x10,         //             LDA $10
+        0x69, 0x01,         //             ADC #$01
+        0x85, 0x10,         //             STA $10
+        0xA5, 0x11,         //             LDA $11
+        0x69, 0x00,         //             ADC #$00
+        0x85, 0x11,         //             STA $11
+        0xD8,               //             CLD
+        0x86, 0x12,         //             STX $12
+        0x86, 0x13,         //             STX $13
+        0xA9, 0x00,         //             LDA #$00
+        0xA0, 0x08,         //             LDY #$08
+        0x46, 0x12,         // 8019: mul:  LSR $12
+        0x90, 0x03,         //             BCC skip
+        0x18,               //             CLC
+        0x65, 0x13,         //             ADC $13
+        0x6A,               // 8020: skip: ROR A
+        0x66, 0x14,         //             ROR $14
+        0x88,               //             DEY
+        0xD0, 0xF3,         //             BNE mul
+        0xE8,               //             INX
+        0x4C, 0x02, 0x80,   //             JMP loop
+    };
+
+    // ROM and RAM only, the workloads never touch I/O
+    struct Machine
+    {
+        explicit Machine(const std::vector<uint8_t>& program)
+        {
+            std::vector<uint8_t> image(0x8000, 0xEA);
+            std::copy(program.begin(), program.end(), image.begin());
+            image[0xFFFC - ROM_BASE] = ROM_BASE & 0xFF;
+            image[0xFFFD - ROM_BASE] = ROM_BASE >> 8;
+
+            eeprom = std::make_unique<devices::EEPROM28C256>(image, bus);
+            bus->addSlave(eeprom.get());
+            sram = std::make_unique<devices::SRAM62256>(bus);
+            bus->addSlave(sram.get());
+            cpu->reset();
+        }
+
+        std::shared_ptr<core::Bus> bus = std::make_shared<core::Bus>();
+        std::shared_ptr<devices::W65C02S> cpu = std::make_shared<devices::W65C02S>(bus);
+        std::unique_ptr<devices::EEPROM28C256> eeprom;
+        std::unique_ptr<devices::SRAM62256> sram;
+    };
+
+    // Cycles per instruction of a workload, measured on the stepped core
+    double averageCyclesPerInstruction(const std::vector<uint8_t>& program)
+    {
+        constexpr uint64_t INSTRUCTIONS = 100'000;
+        Machine machine(program);
+        machine.cpu->step(); // Reset
+        return static_cast<double>(machine.cpu->runInstructions(INSTRUCTIONS)) / INSTRUCTIONS;
+    }
+}
+
+// Clock-phase core, one iteration is a full clock cycle
+static void BM_WorkloadCycles(benchmark::State& state, const std::vector<uint8_t>& program)
+{
+    Machine machine(program);
+    for (auto _ : state)
+    {
+        machine.cpu->onClockStateChange(core::LOW);
+        machine.cpu->onClockStateChange(core::HIGH);
+    }
+    // This core does not count instructions, they are derived from the workload's average instruction length
+    const auto cycles = static_cast<double>(state.iterations());
+    state.counters["cycles/s"] = benchmark::Counter(cycles, benchmark::Counter::kIsRate);
+    state.counters["instructions/s"] = benchmark::Counter(cycles / averageCyclesPerInstruction(program), benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_WorkloadCycles, alu, ALU_LOOP);
+BENCHMARK_CAPTURE(BM_WorkloadCycles, memory, MEMORY_LOOP);
+BENCHMARK_CAPTURE(BM_WorkloadCycles, branch, BRANCH_LOOP);
+BENCHMARK_CAPTURE(BM_WorkloadCycles, jsr, JSR_LOOP);
+BENCHMARK_CAPTURE(BM_WorkloadCycles, arithmetic, ARITHMETIC_LOOP);
+
+// Instruction-stepped core, one iteration is a whole instruction
+static void BM_WorkloadInstructions(benchmark::State& state, const std::vector<uint8_t>& program)
+{
+    Machine machine(program);
+    uint64_t cycles = 0;
+    for (auto _ : state)
+    {
+        cycles += machine.cpu->step();
+    }
+    state.counters["cycles/s"] = benchmark::Counter(static_cast<double>(cycles), benchmark::Counter::kIsRate);
+    state.counters["instructions/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_WorkloadInstructions, alu, ALU_LOOP);
+BENCHMARK_CAPTURE(BM_WorkloadInstructions, memory, MEMORY_LOOP);
+BENCHMARK_CAPTURE(BM_WorkloadInstructions, branch, BRANCH_LOOP);
+BENCHMARK_CAPTURE(BM_WorkloadInstructions, jsr, JSR_LOOP);
+BENCHMARK_CAPTURE(BM_WorkloadInstructions, arithmetic, ARITHMETIC_LOOP);
+
+// Instruction-stepped core through the threaded interpreter, one iteration is a batch of instructions
+static void BM_WorkloadThreaded(benchmark::State& state, const std::vector<uint8_t>& program)
+{
+    constexpr uint64_t BATCH = 1000;
+    Machine machine(program);
+    uint64_t cycles = 0;
+    for (auto _ : state)
+    {
+        cycles += machine.cpu->runInstructionsThreaded(BATCH);
+    }
+    state.counters["cycles/s"] = benchmark::Counter(static_cast<double>(cycles), benchmark::Counter::kIsRate);
+    state.counters["instructions/s"] = benchmark::Counter(static_cast<double>(state.iterations() * BATCH), benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_WorkloadThreaded, alu, ALU_LOOP);
+BENCHMARK_CAPTURE(BM_WorkloadThreaded, memory, MEMORY_LOOP);
+BENCHMARK_CAPTURE(BM_WorkloadThreaded, branch, BRANCH_LOOP);
+BENCHMARK_CAPTURE(BM_WorkloadThreaded, jsr, JSR_LOOP);
+BENCHMARK_CAPTURE(BM_WorkloadThreaded, arithmetic, ARITHMETIC_LOOP);
@@ -3,6 +3,8 @@
 #include "core/bus_slave.h"
 #include "spdlog/spdlog.h"
 
+#include <stdexcept>
+
 namespace EaterEmulator::core
 {
     void Bus::setAddress(uint16_t address)
@@ -25,21 +27,118 @@ namespace EaterEmulator::core
         data = _data;
     }
 
+    void Bus::saveState(StateWriter& writer) const
+    {
+        writer.write(_address);
+        writer.write(_data);
+        writer.write(_scheduler.now());
+    }
+
+    void Bus::loadState(StateReader& reader)
+    {
+        _address = reader.read<uint16_t>();
+        _data = reader.read<uint8_t>();
+        _scheduler.reset(reader.read<uint64_t>());
+    }
+
     void Bus::addSlave(BusSlave* slave)
     {
         if (!slave) {
             spdlog::error("Bus: Attempted to add a null slave");
             return;
         }
+
+        auto ranges = slave->getAddressRanges();
+        if (ranges.empty())
+        {
+            // Monitors must observe every access, so no page may bypass notifySlaves any more
+            _monitors.push_back(slave);
+            _readPages.fill(nullptr);
+            _writePages.fill(nullptr);
+            _constantPages.fill(nullptr);
+            ++_mapGeneration;
+        }
+        else
+        {
+            // Validate every range before touching the page table so a rejected slave leaves no mapping behind
+            for (const auto& range : ranges)
+            {
+                if (range.start > range.end || (range.start & 0xFF) != 0x00 || (range.end & 0xFF) != 0xFF)
+                {
+                    throw std::runtime_error(fmt::format("Bus: {} range {:#06x}-{:#06x} is not page aligned",
+                        slave->getName(), range.start, range.end));
+                }
+                for (size_t page = range.start >> PAGE_SHIFT; page <= (range.end >> PAGE_SHIFT); ++page)
+                {
+                    if (_pages[page] != nullptr)
+                    {
+                        throw std::runtime_error(fmt::format("Bus: {} range {:#06x}-{:#06x} overlaps {} at {:#06x}",
+                            slave->getName(), range.start, range.end, _pages[page]->getName(), page << PAGE_SHIFT));
+                    }
+                }
+            }
+            for (const auto& range : ranges)
+            {
+                for (size_t page = range.start >> PAGE_SHIFT; page <= (range.end >> PAGE_SHIFT); ++page)
+                {
+                    _pages[page] = slave;
+                    remapPage(static_cast<uint8_t>(page));
+                }
+            }
+        }
         _slaves.push_back(slave);
         spdlog::debug("Bus: Slave {} added", slave->getName());
     }
 
-    void Bus::notifySlaves(uint8_t rwb) const
+    uint64_t Bus::getReadStableUntil(uint16_t address) const
+    {
+        const uint8_t page = static_cast<uint8_t>(address >> PAGE_SHIFT);
+        if (_readPages[page])
+        {
+            return Scheduler::NEVER;
+        }
+        // Monitors would miss the reads that are skipped
+        if (!_monitors.empty() || !_pages[page])
+        {
+            return 0;
+        }
+        return _pages[page]->getReadStableUntil(address);
+    }
+
+    void Bus::remapPage(uint8_t page)
+    {
+        auto* owner = _pages[page];
+        const auto direct = owner != nullptr && _monitors.empty() ? owner->getDirectPage(page) : std::nullopt;
+        _readPages[page] = direct ? direct->read : nullptr;
+        _writePages[page] = direct ? direct->write : nullptr;
+        const uint8_t* constant = direct && direct->constant ? direct->read : nullptr;
+        if (_constantPages[page] != nullptr && _constantPages[page] != constant)
+        {
+            ++_mapGeneration;
+        }
+        _constantPages[page] = constant;
+    }
+
+    void Bus::notifySlaves(uint8_t rwb)
     {
-        for (const auto& slave : _slaves)
+        const auto page = _address >> PAGE_SHIFT;
+        if (rwb == READ && _readPages[page] != nullptr)
+        {
+            _data = _readPages[page][_address & PAGE_MASK];
+            return;
+        }
+        if (rwb == WRITE && _writePages[page] != nullptr)
+        {
+            _writePages[page][_address & PAGE_MASK] = _data;
+            return;
+        }
+        if (auto* owner = _pages[_address >> PAGE_SHIFT])
+        {
+            owner->handleBusNotification(_address, rwb);
+        }
+        for (const auto& monitor : _monitors)
         {
-            slave->handleBusNotification(_address, rwb);
+            monitor->handleBusNotification(_address, rwb);
         }
     }
 
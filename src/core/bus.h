@@ -1,13 +1,37 @@
 #pragma once
 
+#include "core/defines.h"
+#include "core/scheduler.h"
+#include "core/state.h"
+
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 namespace EaterEmulator::core
 {
     class BusSlave;
 
-    class Bus
+    // Inclusive address range decoded by a bus slave. Ranges are mapped in whole 256-byte pages.
+    struct AddressRange
+    {
+        uint16_t start;
+        uint16_t end;
+    };
+
+    // Host memory backing one 256-byte page, read and written by the bus without notifying the slave.
+    // Without write memory, writes are still notified, e.g. for ROM or a page that is copied on write.
+    // Constant pages never change while mapped, so the CPU may keep code it decoded from them.
+    struct DirectPage
+    {
+        const uint8_t* read;
+        uint8_t* write;
+        bool constant = false;
+    };
+
+    class Bus : public Stateful
     {
     public:
         Bus() = default;
@@ -24,14 +48,84 @@ namespace EaterEmulator::core
         void setData(uint8_t data);
         void getData(uint8_t& data) const;
 
-        void notifySlaves(uint8_t rwb) const;
+        // Pages backed by direct memory are served without notifying the owning slave
+        void notifySlaves(uint8_t rwb);
+
+        // Set the address and perform a full bus read or write
+        uint8_t read(uint16_t address)
+        {
+            _address = address;
+            if (const uint8_t* page = _readPages[address >> PAGE_SHIFT])
+            {
+                _data = page[address & PAGE_MASK];
+            }
+            else
+            {
+                notifySlaves(READ);
+            }
+            return _data;
+        }
+
+        void write(uint16_t address, uint8_t data)
+        {
+            _address = address;
+            _data = data;
+            if (uint8_t* page = _writePages[address >> PAGE_SHIFT])
+            {
+                page[address & PAGE_MASK] = data;
+            }
+            else
+            {
+                notifySlaves(WRITE);
+            }
+        }
+
+        // Maps the slave's address ranges into the page table. Slaves without ranges are
+        // notified of every access, which turns off the direct memory path for all pages.
+        // Throws std::runtime_error if a range overlaps another slave.
         void addSlave(BusSlave* slave);
-        
+
+        // Asks the owner of the page for its direct memory again, e.g. after it replaced a copy-on-write page
+        void remapPage(uint8_t page);
+
+        // Host memory of a constant page, nullptr if the page may change or must be read through the bus
+        const uint8_t* getConstantPage(uint8_t page) const { return _constantPages[page]; }
+        // Changes whenever a constant page is unmapped or moved, which invalidates anything decoded from it
+        uint64_t getMapGeneration() const { return _mapGeneration; }
+
+        // Cycle before which reading the address returns the same value, see BusSlave::getReadStableUntil.
+        // Memory read directly is stable for good, nothing but the CPU writes it.
+        uint64_t getReadStableUntil(uint16_t address) const;
+
+        // Slave that owns the page containing the address, nullptr if unmapped
+        BusSlave* getSlaveForAddress(uint16_t address) const { return _pages[address >> PAGE_SHIFT]; }
+
+        // Event scheduler for the devices on this bus, advanced by the CPU between instructions
+        Scheduler& getScheduler() { return _scheduler; }
+
+        // Saves the address and data lines and the scheduler cycle. Restoring drops every scheduled event.
+        std::string getName() const override { return "Bus"; }
+        void saveState(StateWriter& writer) const override;
+        void loadState(StateReader& reader) override;
+
+        static constexpr size_t PAGE_COUNT = 256;
+        static constexpr size_t PAGE_SIZE = 256;
+        static constexpr uint8_t PAGE_SHIFT = 8;
+        static constexpr uint16_t PAGE_MASK = 0xFF;
 
     private:
         uint16_t _address{0}; // Current address
         uint8_t _data{0}; // Current data
 
         std::vector<BusSlave*> _slaves; // List of slaves connected to this bus
+        std::array<BusSlave*, PAGE_COUNT> _pages{}; // Owning slave of each 256-byte page
+        std::vector<BusSlave*> _monitors; // Slaves notified of every access
+        std::array<const uint8_t*, PAGE_COUNT> _readPages{}; // Host memory of directly readable pages
+        std::array<uint8_t*, PAGE_COUNT> _writePages{}; // Host memory of directly writable pages
+        std::array<const uint8_t*, PAGE_COUNT> _constantPages{}; // Host memory of pages that never change
+        uint64_t _mapGeneration = 0;
+
+        Scheduler _scheduler;
+
     };
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "core/device.h"
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace EaterEmulator::core
 {
@@ -20,6 +22,18 @@ namespace EaterEmulator::core
 
         virtual void handleBusNotification(uint16_t address, uint8_t rwb) = 0;
 
+        // Address ranges decoded by this slave, registered in the bus page table.
+        // Slaves returning no ranges (e.g. bus loggers) are notified of every access.
+        virtual std::vector<AddressRange> getAddressRanges() const { return {}; }
+
+        // Plain memory devices return the backing storage of each of their pages so the bus can read and
+        // write it without a notification. Devices with side effects on access keep the default.
+        virtual std::optional<DirectPage> getDirectPage([[maybe_unused]] uint8_t page) { return std::nullopt; }
+
+        // For skipping idle loops that poll the slave: the cycle before which reading the address keeps
+        // returning what it returns now without side effects that matter. 0 (the default) promises nothing.
+        virtual uint64_t getReadStableUntil([[maybe_unused]] uint16_t address) const { return 0; }
+
         void addBusSlave(BusSlave* slave)
         {
             _bus->addSlave(slave);
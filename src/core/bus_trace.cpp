@@ -0,0 +1,195 @@
+#include "core/bus_trace.h"
+#include "core/defines.h"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+namespace EaterEmulator::core
+{
+    namespace
+    {
+        constexpr size_t RECORDS_PER_BLOCK = 4096;
+
+        template<typename T>
+        void putLittleEndian(uint8_t* out, T value)
+        {
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                out[i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+
+        template<typename T>
+        T getLittleEndian(const uint8_t* in)
+        {
+            T value = 0;
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                value |= static_cast<T>(static_cast<T>(in[i]) << (8 * i));
+            }
+            return value;
+        }
+    }
+
+    namespace bus_trace
+    {
+        void encode(const BusTraceRecord& record, uint8_t* out)
+        {
+            putLittleEndian(out, record.cycle);
+            putLittleEndian(out + 8, record.address);
+            putLittleEndian(out + 10, record.pc);
+            out[12] = record.data;
+            out[13] = record.rwb == READ ? FLAG_READ : 0;
+            out[14] = 0;
+            out[15] = 0;
+        }
+
+        BusTraceRecord decode(const uint8_t* in)
+        {
+            BusTraceRecord record;
+            record.cycle = getLittleEndian<uint64_t>(in);
+            record.address = getLittleEndian<uint16_t>(in + 8);
+            record.pc = getLittleEndian<uint16_t>(in + 10);
+            record.data = in[12];
+            record.rwb = (in[13] & FLAG_READ) ? READ : WRITE;
+            return record;
+        }
+
+        std::string formatArduino(const BusTraceRecord& record)
+        {
+            return fmt::format("{:016b}   {:04x}  {} {:02x}   {:08b}", record.address, record.address,
+                record.rwb == READ ? 'r' : 'W', record.data, record.data);
+        }
+    }
+
+    BusTraceWriter::BusTraceWriter(const std::string& path)
+        : _ring(std::make_unique<SpscRing<BusTraceRecord, RING_CAPACITY>>())
+    {
+        _file = std::fopen(path.c_str(), "wb");
+        if (!_file)
+        {
+            throw std::runtime_error(fmt::format("BusTraceWriter: cannot open {}: {}", path, std::strerror(errno)));
+        }
+
+        std::array<uint8_t, bus_trace::HEADER_SIZE> header{};
+        std::copy(bus_trace::MAGIC.begin(), bus_trace::MAGIC.end(), header.begin());
+        putLittleEndian(header.data() + 8, bus_trace::VERSION);
+        putLittleEndian(header.data() + 10, static_cast<uint16_t>(bus_trace::RECORD_SIZE));
+        std::fwrite(header.data(), 1, header.size(), _file);
+
+        _block.resize(RECORDS_PER_BLOCK * bus_trace::RECORD_SIZE);
+        _writerThread = std::jthread([this](std::stop_token stopToken) { writeLoop(stopToken); });
+    }
+
+    BusTraceWriter::~BusTraceWriter()
+    {
+        close();
+    }
+
+    void BusTraceWriter::close()
+    {
+        if (_writerThread.joinable())
+        {
+            _writerThread.request_stop();
+            _writerThread.join();
+        }
+        if (_file)
+        {
+            while (writePending() > 0) {}
+            std::fclose(_file);
+            _file = nullptr;
+            spdlog::debug("BusTraceWriter: {} records written", getRecordCount());
+        }
+    }
+
+    void BusTraceWriter::writeLoop(std::stop_token stopToken)
+    {
+        std::mutex mutex;
+        std::condition_variable_any wakeup;
+        while (!stopToken.stop_requested())
+        {
+            if (writePending() < RECORDS_PER_BLOCK)
+            {
+                // Less than a full block waiting, give the producer time to fill the ring
+                std::unique_lock lock(mutex);
+                wakeup.wait_for(lock, stopToken, std::chrono::milliseconds(5), []() { return false; });
+            }
+        }
+    }
+
+    size_t BusTraceWriter::writePending()
+    {
+        size_t count = 0;
+        while (count < RECORDS_PER_BLOCK)
+        {
+            auto record = _ring->pop();
+            if (!record) break;
+            bus_trace::encode(*record, _block.data() + count * bus_trace::RECORD_SIZE);
+            ++count;
+        }
+        if (count > 0)
+        {
+            if (std::fwrite(_block.data(), bus_trace::RECORD_SIZE, count, _file) != count)
+            {
+                spdlog::error("BusTraceWriter: write failed: {}", std::strerror(errno));
+            }
+            _written.fetch_add(count, std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    BusTraceReader::BusTraceReader(const std::string& path)
+    {
+        _file = std::fopen(path.c_str(), "rb");
+        if (!_file)
+        {
+            throw std::runtime_error(fmt::format("BusTraceReader: cannot open {}: {}", path, std::strerror(errno)));
+        }
+
+        std::array<uint8_t, bus_trace::HEADER_SIZE> header{};
+        if (std::fread(header.data(), 1, header.size(), _file) != header.size()
+            || !std::equal(bus_trace::MAGIC.begin(), bus_trace::MAGIC.end(), header.begin()))
+        {
+            std::fclose(_file);
+            throw std::runtime_error(fmt::format("BusTraceReader: {} is not a bus trace", path));
+        }
+        const auto version = getLittleEndian<uint16_t>(header.data() + 8);
+        const auto recordSize = getLittleEndian<uint16_t>(header.data() + 10);
+        if (version != bus_trace::VERSION || recordSize != bus_trace::RECORD_SIZE)
+        {
+            std::fclose(_file);
+            throw std::runtime_error(fmt::format("BusTraceReader: {} has unsupported version {} or record size {}",
+                path, version, recordSize));
+        }
+        _block.resize(RECORDS_PER_BLOCK * bus_trace::RECORD_SIZE);
+    }
+
+    BusTraceReader::~BusTraceReader()
+    {
+        if (_file)
+        {
+            std::fclose(_file);
+        }
+    }
+
+    std::optional<BusTraceRecord> BusTraceReader::next()
+    {
+        if (_position == _size)
+        {
+            _size = std::fread(_block.data(), bus_trace::RECORD_SIZE, RECORDS_PER_BLOCK, _file);
+            _position = 0;
+            if (_size == 0)
+            {
+                return std::nullopt;
+            }
+        }
+        return bus_trace::decode(_block.data() + bus_trace::RECORD_SIZE * _position++);
+    }
+}
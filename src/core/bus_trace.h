@@ -0,0 +1,116 @@
+#pragma once
+
+#include "core/spsc_ring.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace EaterEmulator::core
+{
+    // One bus transaction as seen by a logic analyser
+    struct BusTraceRecord
+    {
+        uint64_t cycle = 0;
+        uint16_t address = 0;
+        uint16_t pc = 0; // Program counter of the CPU at the time of the access
+        uint8_t data = 0;
+        uint8_t rwb = 0;
+
+        bool operator==(const BusTraceRecord&) const = default;
+    };
+
+    // Binary trace files start with a 16-byte header: the magic "6502BTR" and a NUL, then the format version
+    // and record size as little-endian uint16 and 4 reserved bytes. Records follow back to back, each one
+    // the cycle as little-endian uint64, address and PC as uint16, data, flags (bit 0 set for a read)
+    // and 2 reserved bytes.
+    namespace bus_trace
+    {
+        static constexpr std::array<char, 8> MAGIC = { '6', '5', '0', '2', 'B', 'T', 'R', '\0' };
+        static constexpr uint16_t VERSION = 1;
+        static constexpr size_t HEADER_SIZE = 16;
+        static constexpr size_t RECORD_SIZE = 16;
+        static constexpr uint8_t FLAG_READ = 0x01;
+
+        void encode(const BusTraceRecord& record, uint8_t* out);
+        BusTraceRecord decode(const uint8_t* in);
+
+        // The line the Arduino Mega bus monitor prints: address in binary and hex, r or W, data in hex and binary
+        std::string formatArduino(const BusTraceRecord& record);
+    }
+
+    // Streams bus records to a binary file. record() only copies into a preallocated ring on the calling
+    // thread, a background thread encodes and writes them in large blocks. Nothing is dropped: if the writer
+    // falls a whole ring behind, record() waits for it.
+    class BusTraceWriter
+    {
+    public:
+        static constexpr size_t RING_CAPACITY = 1 << 16;
+
+        // Creates or truncates the file. Throws std::runtime_error if it cannot be opened.
+        explicit BusTraceWriter(const std::string& path);
+        ~BusTraceWriter();
+
+        BusTraceWriter(const BusTraceWriter&) = delete;
+        BusTraceWriter& operator=(const BusTraceWriter&) = delete;
+        BusTraceWriter(BusTraceWriter&&) = delete;
+        BusTraceWriter& operator=(BusTraceWriter&&) = delete;
+
+        // Single producer, normally the thread running the CPU
+        void record(const BusTraceRecord& record)
+        {
+            while (!_ring->push(record))
+            {
+                _stalls.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::yield();
+            }
+        }
+
+        // Write out everything recorded so far and close the file. Called by the destructor.
+        void close();
+
+        uint64_t getRecordCount() const { return _written.load(std::memory_order_relaxed); }
+        // Times record() had to wait for the writer
+        uint64_t getStallCount() const { return _stalls.load(std::memory_order_relaxed); }
+
+    private:
+        void writeLoop(std::stop_token stopToken);
+        size_t writePending();
+
+        std::unique_ptr<SpscRing<BusTraceRecord, RING_CAPACITY>> _ring;
+        std::FILE* _file = nullptr;
+        std::vector<uint8_t> _block;
+        std::atomic<uint64_t> _written{0};
+        std::atomic<uint64_t> _stalls{0};
+        std::jthread _writerThread;
+    };
+
+    // Reads a file written by BusTraceWriter
+    class BusTraceReader
+    {
+    public:
+        // Throws std::runtime_error if the file cannot be opened or is not a bus trace
+        explicit BusTraceReader(const std::string& path);
+        ~BusTraceReader();
+
+        BusTraceReader(const BusTraceReader&) = delete;
+        BusTraceReader& operator=(const BusTraceReader&) = delete;
+        BusTraceReader(BusTraceReader&&) = delete;
+        BusTraceReader& operator=(BusTraceReader&&) = delete;
+
+        // std::nullopt at the end of the file. A truncated last record is ignored.
+        std::optional<BusTraceRecord> next();
+
+    private:
+        std::FILE* _file = nullptr;
+        std::vector<uint8_t> _block;
+        size_t _position = 0;
+        size_t _size = 0;
+    };
+}
@@ -8,52 +8,100 @@
 #include <vector>
 #include <atomic>
 #include <thread>
+#include <stop_token>
 #include <chrono>
 #include <algorithm>
+#include <cstdint>
 
 namespace EaterEmulator::core
 {
 
-    class ClockObserver;
+    // Base class for all clock-dependent devices
+    class ClockObserver {
+    public:
+        virtual ~ClockObserver() = default;
+        virtual void onClockStateChange(State newState) = 0;
+
+        // Runs full LOW/HIGH cycles back to back and returns how many it ran, which may be a few more than
+        // asked for, e.g. to finish an instruction. Called instead of onClockStateChange when this is the
+        // only observer of the clock, so nothing else needs to see the cycles in between.
+        virtual uint64_t runCycles(uint64_t cycles)
+        {
+            for (uint64_t i = 0; i < cycles; ++i) {
+                onClockStateChange(LOW);
+                onClockStateChange(HIGH);
+            }
+            return cycles;
+        }
+
+        // Called by the clock thread between batches. An observer that can do nothing until another thread
+        // changes its inputs, such as a CPU parked by WAI, may block here until then or until stop is
+        // requested. Returns whether it blocked, pacing then restarts from the time it returns.
+        virtual bool waitWhileIdle([[maybe_unused]] std::stop_token stop) { return false; }
+    };
 
-    template<auto Hz>
     class Clock
     {
     public:
 
-        static constexpr auto frequency = Hz;
-        static constexpr auto period = std::chrono::nanoseconds{1'000'000'000 / Hz};
-        static constexpr auto half_period = period / 2;
+        // Frequency of 0 runs the clock unthrottled, as fast as the observers allow
+        static constexpr uint64_t UNTHROTTLED = 0;
 
-        Clock() = default;
-        ~Clock() = default;
+        explicit Clock(uint64_t frequency = 1'000'000) : _frequency(frequency) {}
+        ~Clock() { stop(); }
 
-        // Non-copyable, movable
+        // Non-copyable, non-movable since the clock thread captures this
         Clock(const Clock&) = delete;
         Clock& operator=(const Clock&) = delete;
-        Clock(Clock&&) = default;
-        Clock& operator=(Clock&&) = default;
+        Clock(Clock&&) = delete;
+        Clock& operator=(Clock&&) = delete;
+
+        // Frequency, batch duration and cycle limit only take effect on the next start()
+        void setFrequency(uint64_t frequency) { _frequency = frequency; }
+        uint64_t getFrequency() const { return _frequency; }
+
+        // Wall-clock time worth of cycles run back to back between two sleeps when throttled.
+        // Shorter batches track real time more closely at the cost of more wakeups.
+        void setBatchDuration(std::chrono::nanoseconds duration) { _batchDuration = duration; }
+
+        // Stop on its own after this many full cycles, 0 runs until stop(). With a limit the clock keeps
+        // ticking through idle observers so the limit is reached in bounded time.
+        void setCycleLimit(uint64_t cycles) { _cycleLimit = cycles; }
+
+        // Full cycles (LOW to HIGH transitions) generated since construction
+        uint64_t getCycleCount() const { return _cycles.load(std::memory_order_relaxed); }
+
+        // How far the last batch finished ahead of (positive) or behind (negative) its deadline
+        std::chrono::nanoseconds getDrift() const { return std::chrono::nanoseconds{_drift.load(std::memory_order_relaxed)}; }
+
+        bool isRunning() const { return _running.load(std::memory_order_acquire); }
 
         void start() {
             if (!_running.exchange(true, std::memory_order_acq_rel)) {
+                if (_clockThread.joinable()) {
+                    _clockThread.join();
+                }
                 _clockThread = std::jthread([this](std::stop_token stop_token) {
                     clockLoop(stop_token);
+                    _running.store(false, std::memory_order_release);
                 });
             }
         }
 
         void stop() {
-            if (_running.exchange(false, std::memory_order_acq_rel)) {
+            if (_clockThread.joinable()) {
                 _clockThread.request_stop();
                 _cv.notify_all();
+                _clockThread.join();
             }
+            _running.store(false, std::memory_order_release);
         }
-        
+
         void registerObserver(ClockObserver* observer) {
             std::lock_guard lock(_observerMutex);
             _observers.push_back(observer);
         }
-        
+
         void unregisterObserver(ClockObserver* observer) {
             std::lock_guard lock(_observerMutex);
             auto it = std::ranges::find(_observers, observer);
@@ -61,52 +109,105 @@ namespace EaterEmulator::core
                 _observers.erase(it);
             }
         }
-        
+
     private:
-    void clockLoop(std::stop_token stop_token) {
+        // Unthrottled batches only bound how often the stop token and cycle limit are checked
+        static constexpr uint64_t UNTHROTTLED_BATCH_CYCLES = 4096;
+        // Falling further behind than this drops the lost time instead of racing to catch up
+        static constexpr auto MAX_CATCH_UP = std::chrono::milliseconds{50};
+
+        void clockLoop(std::stop_token stop_token) {
             using namespace std::chrono;
-            
-            auto next_tick = steady_clock::now();
-            
+
+            const bool throttled = _frequency != UNTHROTTLED;
+            const uint64_t batchCycles = throttled
+                ? std::max<uint64_t>(1, _frequency * static_cast<uint64_t>(_batchDuration.count()) / 1'000'000'000)
+                : UNTHROTTLED_BATCH_CYCLES;
+
+            // Deadlines are computed from the cycles run since the reference point so rounding never accumulates
+            auto reference = steady_clock::now();
+            uint64_t referenceCycles = 0;
+
             while (!stop_token.stop_requested()) {
-                next_tick += half_period;
-                
-                // Toggle state with memory ordering
-                const auto current_state = _state.load(std::memory_order_acquire);
-                const auto new_state = (current_state == LOW) ? HIGH : LOW;
-                _state.store(new_state, std::memory_order_release);
-                
-                // Notify all observers
-                notifyObservers(new_state);
-                
-                // Sleep until next tick or stop requested
-                if (stop_token.stop_requested()) break;
-                std::this_thread::sleep_until(next_tick);
+                uint64_t cycles = batchCycles;
+                if (_cycleLimit != 0) {
+                    const auto done = _cycles.load(std::memory_order_relaxed);
+                    if (done >= _cycleLimit) break;
+                    cycles = std::min(cycles, _cycleLimit - done);
+                }
+
+                cycles = runBatch(cycles);
+                _cycles.fetch_add(cycles, std::memory_order_relaxed);
+
+                if (_cycleLimit == 0 && waitWhileIdle(stop_token)) {
+                    reference = steady_clock::now();
+                    referenceCycles = 0;
+                    continue;
+                }
+
+                if (!throttled) continue;
+
+                referenceCycles += cycles;
+                if (referenceCycles >= _frequency) {
+                    // Fold whole seconds into the reference to keep the multiplication below from overflowing
+                    reference += seconds{referenceCycles / _frequency};
+                    referenceCycles %= _frequency;
+                }
+                const auto deadline = reference + nanoseconds{referenceCycles * 1'000'000'000 / _frequency};
+                const auto now = steady_clock::now();
+                const auto drift = duration_cast<nanoseconds>(deadline - now);
+                _drift.store(drift.count(), std::memory_order_relaxed);
+
+                if (drift > nanoseconds::zero()) {
+                    std::this_thread::sleep_until(deadline);
+                }
+                else if (-drift > MAX_CATCH_UP) {
+                    // Too far behind, e.g. after the host stalled; restart pacing from now
+                    reference = now;
+                    referenceCycles = 0;
+                }
+                // Otherwise run the next batch immediately to catch up
+            }
+        }
+
+        bool waitWhileIdle(std::stop_token stop_token) {
+            std::shared_lock lock(_observerMutex);
+            bool waited = false;
+            for (auto* observer : _observers) {
+                waited |= observer->waitWhileIdle(stop_token);
             }
+            return waited;
         }
 
-        void notifyObservers(State new_state) {
+        // Run full LOW/HIGH cycles back to back, taking the observer lock once for the whole batch.
+        // A lone observer runs the whole batch itself. Returns the cycles run.
+        uint64_t runBatch(uint64_t cycles) {
             std::shared_lock lock(_observerMutex);
-            
-            // Use ranges for-each
-            std::ranges::for_each(_observers, [new_state](auto* observer) {
-                observer->onClockStateChange(new_state);
-            });
+            if (_observers.size() == 1) {
+                return _observers.front()->runCycles(cycles);
+            }
+            for (uint64_t i = 0; i < cycles; ++i) {
+                for (auto* observer : _observers) {
+                    observer->onClockStateChange(LOW);
+                }
+                for (auto* observer : _observers) {
+                    observer->onClockStateChange(HIGH);
+                }
+            }
+            return cycles;
         }
 
+        uint64_t _frequency = 0;
+        std::chrono::nanoseconds _batchDuration = std::chrono::milliseconds{1};
+        uint64_t _cycleLimit = 0;
+
         std::condition_variable _cv;
         mutable std::shared_mutex _observerMutex;
-        
+
         std::vector<ClockObserver*> _observers;
-        std::atomic<State> _state{LOW};
+        std::atomic<uint64_t> _cycles{0};
+        std::atomic<int64_t> _drift{0};
         std::atomic<bool> _running{false};
         std::jthread _clockThread;
     };
-    
-    // Base class for all clock-dependent devices    
-    class ClockObserver {
-    public:
-        virtual ~ClockObserver() = default;
-        virtual void onClockStateChange(State newState) = 0;
-    };
-}
\ No newline at end of file
+}
@@ -1,13 +1,14 @@
 #pragma once
 
 #include "core/bus.h"
+#include "core/logging.h"
 
 #include <memory>
 #include <string>
 
 namespace EaterEmulator::core
 {
-    class Device
+    class Device : public Loggable
     {
     public:
         Device(std::shared_ptr<Bus> bus, uint16_t offset = 0) : _bus(bus), _offset(offset) {}
@@ -0,0 +1,11 @@
+#include "core/logging.h"
+
+#include "spdlog/spdlog.h"
+
+namespace EaterEmulator::core
+{
+    spdlog::logger& Loggable::log() const
+    {
+        return _logger ? *_logger : *spdlog::default_logger_raw();
+    }
+}
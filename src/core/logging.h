@@ -0,0 +1,25 @@
+#pragma once
+
+#include <memory>
+
+namespace spdlog
+{
+    class logger;
+}
+
+namespace EaterEmulator::core
+{
+    // Components log through the default spdlog logger unless given their own, so machines running
+    // side by side, e.g. in a batch, can keep their messages apart
+    class Loggable
+    {
+    public:
+        void setLogger(std::shared_ptr<spdlog::logger> logger) { _logger = std::move(logger); }
+
+    protected:
+        spdlog::logger& log() const;
+
+    private:
+        std::shared_ptr<spdlog::logger> _logger;
+    };
+}
@@ -0,0 +1,123 @@
+#include "core/machine.h"
+
+#include "spdlog/spdlog.h"
+
+#include <stdexcept>
+
+namespace EaterEmulator::core
+{
+    namespace
+    {
+        std::shared_ptr<const devices::EEPROM28C256::Image> loadROM(const MachineConfig& config)
+        {
+            if (config.romPath.empty())
+            {
+                throw std::runtime_error("Machine config has no ROM file");
+            }
+            return devices::EEPROM28C256::loadImage(config.romPath);
+        }
+    }
+
+    Machine::Machine(const std::vector<uint8_t>& rom, const MachineConfig& config)
+        : _config(config), _rom(rom, _bus, config.rom), _ram(std::make_unique<devices::SRAM62256>(_bus, config.ram)),
+          _via(_bus, config.via), _acia(_bus, config.acia)
+    {
+        connectDevices();
+        _acia.setClockFrequency(config.clockFrequency);
+        _cpu->reset();
+    }
+
+    Machine::Machine(std::shared_ptr<const devices::EEPROM28C256::Image> rom, const MachineConfig& config)
+        : _config(config), _rom(std::move(rom), _bus, config.rom), _ram(std::make_unique<devices::SRAM62256>(_bus, config.ram)),
+          _via(_bus, config.via), _acia(_bus, config.acia)
+    {
+        connectDevices();
+        _acia.setClockFrequency(config.clockFrequency);
+        _cpu->reset();
+    }
+
+    Machine::Machine(const MachineConfig& config)
+        : Machine(loadROM(config), config)
+    {
+    }
+
+    Machine::Machine(Machine& source)
+        : _config(source._config), _rom(source._rom.getImage(), _bus, source._config.rom),
+          _ram(std::make_unique<devices::SRAM62256>(_bus, *source._ram)), _via(_bus, source._config.via), _acia(_bus, source._config.acia)
+    {
+        connectDevices();
+        _acia.setClockFrequency(source._acia.getClockFrequency());
+        _acia.setFlowControl(source._acia.getFlowControl());
+
+        // Everything but the memories is small enough to go through a saved state
+        const auto state = machine_state::save(source.deviceState());
+        machine_state::load(state, deviceState());
+    }
+
+    Machine::~Machine()
+    {
+        spdlog::debug("Machine destroyed.");
+    }
+
+    std::unique_ptr<Machine> Machine::fork()
+    {
+        return std::unique_ptr<Machine>(new Machine(*this));
+    }
+
+    void Machine::setLogger(const std::shared_ptr<spdlog::logger>& logger)
+    {
+        _cpu->setLogger(logger);
+        _rom.setLogger(logger);
+        _ram->setLogger(logger);
+        _via.setLogger(logger);
+        _acia.setLogger(logger);
+        _lcd->setLogger(logger);
+        if (_busMonitor)
+        {
+            _busMonitor->setLogger(logger);
+        }
+    }
+
+    void Machine::attachBusTrace(const std::string& path)
+    {
+        if (_busMonitor)
+        {
+            throw std::runtime_error("Machine already has a bus trace");
+        }
+        _busMonitor = std::make_unique<devices::ArduinoMega>(_bus, path);
+        _busMonitor->attachCPU(_cpu);
+        _bus->addSlave(_busMonitor.get());
+    }
+
+    uint64_t Machine::run(uint64_t cycles)
+    {
+        return _cpu->runCycles(cycles);
+    }
+
+    std::vector<uint8_t> Machine::saveState() const
+    {
+        const std::array<const Stateful*, 6> components = { _bus.get(), _cpu.get(), _ram.get(), &_via, &_acia, _lcd.get() };
+        return machine_state::save(components);
+    }
+
+    void Machine::loadState(std::span<const uint8_t> state)
+    {
+        const std::array<Stateful*, 6> components = { _bus.get(), _cpu.get(), _ram.get(), &_via, &_acia, _lcd.get() };
+        machine_state::load(state, components);
+    }
+
+    void Machine::connectDevices()
+    {
+        _bus->addSlave(&_rom);
+        _bus->addSlave(_ram.get());
+        _bus->addSlave(&_via);
+        _bus->addSlave(&_acia);
+
+        devices::LCDAdapter lcdAdapter(_lcd);
+        _via.connect(devices::W65C22S::Port::A, lcdAdapter, devices::LCDAdapter::CONTROL_PORT);
+        _via.connect(devices::W65C22S::Port::B, lcdAdapter, devices::LCDAdapter::DATA_PORT);
+        _via.connect(devices::W65C22S::Port::IRQ, devices::CPUAdapter(_cpu), devices::CPUAdapter::IRQ_PORT);
+        // Wired-OR with the VIA on IRQB
+        _acia.connect(devices::W65C51N::Port::IRQ, devices::CPUAdapter(_cpu), devices::CPUAdapter::IRQ_PORT + 1);
+    }
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "core/bus.h"
+#include "core/machine_config.h"
+#include "core/state.h"
+
+#include "devices/ArduinoMega/ArduinoMega.h"
+#include "devices/EEPROM28C256/EEPROM28C256.h"
+#include "devices/HD44780LCD/HD44780LCD.h"
+#include "devices/HD44780LCD/LCDAdapter.h"
+#include "devices/SRAM62256/SRAM62256.h"
+#include "devices/W65C02S/CPUAdapter.h"
+#include "devices/W65C02S/W65C02S.h"
+#include "devices/W65C22S/W65C22S.h"
+#include "devices/W65C51N/W65C51N.h"
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace EaterEmulator::core
+{
+    // Ben Eater's 6502 board: RAM at 0x0000, the ACIA at 0x5000, the VIA at 0x6000 driving the LCD,
+    // both of them on the CPU's IRQ line, and the ROM at 0x8000, or the memory map of a MachineConfig.
+    // Owns every device, so a whole emulator can be embedded without any wiring of its own.
+    class Machine
+    {
+    public:
+        // Starts with the CPU reset
+        explicit Machine(const std::vector<uint8_t>& rom, const MachineConfig& config = {});
+        explicit Machine(std::shared_ptr<const devices::EEPROM28C256::Image> rom, const MachineConfig& config = {});
+        // Loads the ROM from config.romPath. Throws std::runtime_error if there is none or it cannot be read.
+        explicit Machine(const MachineConfig& config);
+        ~Machine();
+
+        // Non-copyable, non-movable since the devices keep pointers to each other
+        Machine(const Machine&) = delete;
+        Machine& operator=(const Machine&) = delete;
+        Machine(Machine&&) = delete;
+        Machine& operator=(Machine&&) = delete;
+
+        // Independent copy of the machine in its current state. The ROM image is shared and RAM pages are
+        // copied on write, so a fork costs a few hundred bytes plus the pages it dirties. The fork's ACIA
+        // writes to standard output until given its own sink.
+        // Must be called while this machine is not running; the fork can then run on any thread.
+        std::unique_ptr<Machine> fork();
+
+        // Logger for every device of this machine, see core::Loggable
+        void setLogger(const std::shared_ptr<spdlog::logger>& logger);
+
+        // Records every bus access to a binary trace, see devices::ArduinoMega. Memory then goes through
+        // bus notifications rather than the direct pages, so expect a slowdown. Forks are not traced.
+        // Throws std::runtime_error if the trace file cannot be created.
+        void attachBusTrace(const std::string& path);
+
+        // Runs whole instructions until at least cycles clock cycles have passed and returns how many did.
+        // Idle loops are fast-forwarded, see W65C02S::runCycles.
+        uint64_t run(uint64_t cycles);
+
+        // Runs whole instructions until until() returns true, checked before each instruction, or
+        // maxCycles have passed. Returns whether until() was met.
+        template<typename Predicate>
+            requires std::invocable<Predicate&>
+        bool runUntil(Predicate&& until, uint64_t maxCycles = std::numeric_limits<uint64_t>::max())
+        {
+            const uint64_t start = _cpu->getCycleCount();
+            while (!until())
+            {
+                if (_cpu->getCycleCount() - start >= maxCycles)
+                {
+                    return false;
+                }
+                _cpu->step();
+            }
+            return true;
+        }
+
+        uint64_t getCycleCount() const { return _cpu->getCycleCount(); }
+
+        // Full bus accesses, with the side effects of the CPU making them, e.g. reading the ACIA data
+        // register clears its receive flag
+        uint8_t read(uint16_t address) { return _bus->read(address); }
+        void write(uint16_t address, uint8_t data) { _bus->write(address, data); }
+
+        std::vector<uint8_t> saveState() const;
+        // Throws std::runtime_error if the state was not saved from this kind of machine
+        void loadState(std::span<const uint8_t> state);
+
+        const MachineConfig& getConfig() const { return _config; }
+        Bus& getBus() { return *_bus; }
+        devices::W65C02S& getCPU() { return *_cpu; }
+        devices::EEPROM28C256& getROM() { return _rom; }
+        devices::SRAM62256& getRAM() { return *_ram; }
+        devices::W65C22S& getVIA() { return _via; }
+        devices::W65C51N& getACIA() { return _acia; }
+        const std::shared_ptr<devices::HD44780LCD>& getLCD() { return _lcd; }
+
+    private:
+        // Fork of source
+        Machine(Machine& source);
+
+        void connectDevices();
+
+        // Everything but the memories, in restore order with the bus first
+        std::array<const Stateful*, 5> deviceState() const { return { _bus.get(), _cpu.get(), &_via, &_acia, _lcd.get() }; }
+        std::array<Stateful*, 5> deviceState() { return { _bus.get(), _cpu.get(), &_via, &_acia, _lcd.get() }; }
+
+        MachineConfig _config;
+        std::shared_ptr<Bus> _bus = std::make_shared<Bus>();
+        std::shared_ptr<devices::W65C02S> _cpu = std::make_shared<devices::W65C02S>(_bus);
+        devices::EEPROM28C256 _rom;
+        std::unique_ptr<devices::SRAM62256> _ram;
+        devices::W65C22S _via;
+        devices::W65C51N _acia;
+        std::shared_ptr<devices::HD44780LCD> _lcd = std::make_shared<devices::HD44780LCD>();
+        std::unique_ptr<devices::ArduinoMega> _busMonitor; // Only with attachBusTrace
+    };
+}
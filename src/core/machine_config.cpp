@@ -0,0 +1,101 @@
+#include "core/machine_config.h"
+
+#include "spdlog/spdlog.h"
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace EaterEmulator::core
+{
+    namespace
+    {
+        std::string_view trim(std::string_view text)
+        {
+            const auto start = text.find_first_not_of(" \t\r");
+            if (start == std::string_view::npos)
+            {
+                return {};
+            }
+            return text.substr(start, text.find_last_not_of(" \t\r") - start + 1);
+        }
+
+        template<typename T>
+        bool parseNumber(std::string_view text, T& value, int base)
+        {
+            const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value, base);
+            return error == std::errc() && end == text.data() + text.size();
+        }
+
+        // "8000-FFFF"
+        bool parseRange(std::string_view text, AddressRange& range)
+        {
+            const auto separator = text.find('-');
+            return separator != std::string_view::npos
+                && parseNumber(trim(text.substr(0, separator)), range.start, 16)
+                && parseNumber(trim(text.substr(separator + 1)), range.end, 16)
+                && range.start <= range.end;
+        }
+    }
+
+    MachineConfig MachineConfig::parse(std::string_view text, const std::string& baseDirectory)
+    {
+        MachineConfig config;
+        size_t lineNumber = 0;
+        while (!text.empty())
+        {
+            ++lineNumber;
+            const auto newline = text.find('\n');
+            auto line = text.substr(0, newline);
+            text = newline == std::string_view::npos ? std::string_view() : text.substr(newline + 1);
+
+            line = trim(line.substr(0, line.find('#')));
+            if (line.empty())
+            {
+                continue;
+            }
+            const auto equals = line.find('=');
+            if (equals == std::string_view::npos)
+            {
+                throw std::runtime_error(fmt::format("Machine config line {}: expected key = value", lineNumber));
+            }
+            const auto key = trim(line.substr(0, equals));
+            const auto value = trim(line.substr(equals + 1));
+
+            bool valid = true;
+            if (key == "rom") valid = parseRange(value, config.rom);
+            else if (key == "ram") valid = parseRange(value, config.ram);
+            else if (key == "acia") valid = parseRange(value, config.acia);
+            else if (key == "via") valid = parseRange(value, config.via);
+            else if (key == "clock") valid = parseNumber(value, config.clockFrequency, 10) && config.clockFrequency > 0;
+            else if (key == "rom_file")
+            {
+                valid = !value.empty();
+                config.romPath = (std::filesystem::path(baseDirectory) / value).string();
+            }
+            else
+            {
+                throw std::runtime_error(fmt::format("Machine config line {}: unknown key {}", lineNumber, key));
+            }
+
+            if (!valid)
+            {
+                throw std::runtime_error(fmt::format("Machine config line {}: invalid value for {}: {}", lineNumber, key, value));
+            }
+        }
+        return config;
+    }
+
+    MachineConfig MachineConfig::load(const std::string& path)
+    {
+        std::ifstream ifs(path);
+        if (!ifs)
+        {
+            throw std::runtime_error(fmt::format("Error reading machine config: {}", path));
+        }
+        const std::string text((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        return parse(text, std::filesystem::path(path).parent_path().string());
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "core/bus.h"
+
+#include "devices/EEPROM28C256/EEPROM28C256.h"
+#include "devices/SRAM62256/SRAM62256.h"
+#include "devices/W65C22S/W65C22S.h"
+#include "devices/W65C51N/W65C51N.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace EaterEmulator::core
+{
+    // Memory map and clock of a Machine. The defaults are Ben Eater's board.
+    //
+    // A config file holds one "key = value" per line, with # starting a comment:
+    //
+    //     rom   = 8000-FFFF      # address ranges in hex, each a whole number of 256-byte pages
+    //     ram   = 0000-3FFF
+    //     acia  = 5000-5FFF
+    //     via   = 6000-6FFF
+    //     clock = 1000000        # Hz, sets the ACIA's character timing
+    //     rom_file = wozmon.bin  # relative to the config file
+    //
+    // Keys left out keep their default.
+    struct MachineConfig
+    {
+        AddressRange rom = devices::EEPROM28C256::DEFAULT_RANGE;
+        AddressRange ram = devices::SRAM62256::DEFAULT_RANGE;
+        AddressRange acia = devices::W65C51N::DEFAULT_RANGE;
+        AddressRange via = devices::W65C22S::DEFAULT_RANGE;
+        uint64_t clockFrequency = 1'000'000;
+        std::string romPath; // Empty when the ROM is given to the Machine directly
+
+        // Throws std::runtime_error naming the offending line
+        static MachineConfig parse(std::string_view text, const std::string& baseDirectory = "");
+        static MachineConfig load(const std::string& path);
+    };
+}
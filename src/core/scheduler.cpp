@@ -0,0 +1,61 @@
+#include "core/scheduler.h"
+
+#include <algorithm>
+
+namespace EaterEmulator::core
+{
+    Scheduler::EventId Scheduler::schedule(uint64_t cycle, Callback callback)
+    {
+        const auto id = _nextId++;
+        _events.push_back({cycle, id, std::move(callback)});
+        std::push_heap(_events.begin(), _events.end(), later);
+        _nextCycle = _events.front().cycle;
+        return id;
+    }
+
+    bool Scheduler::cancel(EventId id)
+    {
+        const bool pending = std::ranges::any_of(_events, [id](const Event& event) { return event.id == id; });
+        if (!pending || !_cancelled.insert(id).second)
+        {
+            return false;
+        }
+        dropCancelledTop();
+        return true;
+    }
+
+    void Scheduler::reset(uint64_t now)
+    {
+        _events.clear();
+        _cancelled.clear();
+        _now = now;
+        _nextCycle = NEVER;
+    }
+
+    void Scheduler::fireDueEvents()
+    {
+        while (!_events.empty() && _events.front().cycle <= _now)
+        {
+            std::pop_heap(_events.begin(), _events.end(), later);
+            Event event = std::move(_events.back());
+            _events.pop_back();
+            if (_cancelled.erase(event.id) == 0)
+            {
+                event.callback(event.cycle);
+            }
+        }
+        dropCancelledTop();
+    }
+
+    void Scheduler::dropCancelledTop()
+    {
+        // Cancelled events are removed lazily, but never left at the top where they would hold _nextCycle
+        while (!_events.empty() && _cancelled.contains(_events.front().id))
+        {
+            _cancelled.erase(_events.front().id);
+            std::pop_heap(_events.begin(), _events.end(), later);
+            _events.pop_back();
+        }
+        _nextCycle = _events.empty() ? NEVER : _events.front().cycle;
+    }
+}
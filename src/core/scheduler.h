@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_set>
+#include <vector>
+
+namespace EaterEmulator::core
+{
+    // Cycle-stamped event queue shared by the devices on a bus.
+    // The CPU advances it to its cycle count at every instruction boundary, so events fire
+    // at the first boundary at or after their cycle instead of being polled on every clock edge.
+    class Scheduler
+    {
+    public:
+        using EventId = uint64_t;
+        using Callback = std::function<void(uint64_t cycle)>;
+
+        static constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+
+        Scheduler() = default;
+        ~Scheduler() = default;
+
+        // Non-copyable, non-movable since devices keep references to it
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+        Scheduler(Scheduler&&) = delete;
+        Scheduler& operator=(Scheduler&&) = delete;
+
+        // Fire the callback once the cycle count reaches cycle. Events due on the same cycle fire in the order
+        // they were scheduled. Callbacks may schedule or cancel events.
+        EventId schedule(uint64_t cycle, Callback callback);
+        EventId scheduleIn(uint64_t delay, Callback callback) { return schedule(_now + delay, std::move(callback)); }
+
+        // Returns false if the event already fired or was cancelled
+        bool cancel(EventId id);
+
+        // Move to cycle now and fire every event that is due
+        void advance(uint64_t now)
+        {
+            _now = now;
+            if (now >= _nextCycle)
+            {
+                fireDueEvents();
+            }
+        }
+
+        // Cycle count at the start of the current instruction
+        uint64_t now() const { return _now; }
+
+        // Cycle of the earliest pending event, NEVER if none
+        uint64_t nextEventCycle() const { return _nextCycle; }
+
+        bool empty() const { return _events.empty(); }
+
+        // Drop every pending event and move to cycle now, e.g. when a saved machine is restored.
+        // Owners of the dropped events are expected to schedule them again.
+        void reset(uint64_t now);
+
+    private:
+        struct Event
+        {
+            uint64_t cycle;
+            EventId id; // Increasing, so it also orders events due on the same cycle
+            Callback callback;
+        };
+
+        // Min-heap order for std::push_heap/std::pop_heap
+        static bool later(const Event& a, const Event& b)
+        {
+            return a.cycle != b.cycle ? a.cycle > b.cycle : a.id > b.id;
+        }
+
+        void fireDueEvents();
+        void dropCancelledTop();
+
+        std::vector<Event> _events; // Min-heap on (cycle, id)
+        std::unordered_set<EventId> _cancelled; // Cancelled but still in the heap
+        uint64_t _now = 0;
+        uint64_t _nextCycle = NEVER; // Cached cycle of the heap top
+        EventId _nextId = 0;
+    };
+}
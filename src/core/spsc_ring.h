@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+namespace EaterEmulator::core
+{
+    // Lock-free single-producer/single-consumer ring buffer. One thread may push and one other thread may pop
+    // concurrently without locks. Capacity must be a power of two.
+    template<typename T, size_t Capacity>
+    class SpscRing
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        SpscRing() = default;
+
+        // Non-copyable, non-movable since both threads hold references to it
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+        SpscRing(SpscRing&&) = delete;
+        SpscRing& operator=(SpscRing&&) = delete;
+
+        // Producer side. Returns false if the ring is full.
+        bool push(const T& value)
+        {
+            const auto head = _head.load(std::memory_order_relaxed);
+            if (head - _tail.load(std::memory_order_acquire) == Capacity)
+            {
+                return false;
+            }
+            _buffer[head & MASK] = value;
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side. Returns std::nullopt if the ring is empty.
+        std::optional<T> pop()
+        {
+            const auto tail = _tail.load(std::memory_order_relaxed);
+            if (tail == _head.load(std::memory_order_acquire))
+            {
+                return std::nullopt;
+            }
+            T value = _buffer[tail & MASK];
+            _tail.store(tail + 1, std::memory_order_release);
+            return value;
+        }
+
+        // Exact from either side when the other side is idle, otherwise a snapshot
+        bool empty() const { return size() == 0; }
+        size_t size() const { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire); }
+        static constexpr size_t capacity() { return Capacity; }
+
+    private:
+        static constexpr size_t MASK = Capacity - 1;
+
+        std::array<T, Capacity> _buffer{};
+        // Head and tail live on separate cache lines so the two threads do not false-share
+        alignas(64) std::atomic<size_t> _head{0}; // Next slot to write, only stored by the producer
+        alignas(64) std::atomic<size_t> _tail{0}; // Next slot to read, only stored by the consumer
+    };
+}
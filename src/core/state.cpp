@@ -0,0 +1,71 @@
+#include "core/state.h"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+namespace EaterEmulator::core::machine_state
+{
+    std::vector<uint8_t> save(std::span<const Stateful* const> components)
+    {
+        std::vector<uint8_t> state(std::begin(MAGIC), std::end(MAGIC));
+        StateWriter writer(state);
+        writer.write(VERSION);
+        writer.write(static_cast<uint16_t>(components.size()));
+
+        for (const auto* component : components)
+        {
+            const auto name = component->getName();
+            writer.write(static_cast<uint8_t>(name.size()));
+            writer.writeBytes({ reinterpret_cast<const uint8_t*>(name.data()), name.size() });
+
+            // The payload length is patched in once the component has written its state
+            const auto lengthOffset = writer.size();
+            writer.write(uint32_t{0});
+            component->saveState(writer);
+            const auto length = static_cast<uint32_t>(writer.size() - lengthOffset - sizeof(uint32_t));
+            for (size_t i = 0; i < sizeof(uint32_t); ++i)
+            {
+                state[lengthOffset + i] = static_cast<uint8_t>(length >> (8 * i));
+            }
+        }
+        return state;
+    }
+
+    void load(std::span<const uint8_t> state, std::span<Stateful* const> components)
+    {
+        StateReader reader(state);
+        std::array<uint8_t, sizeof(MAGIC)> magic{};
+        reader.readBytes(magic);
+        if (!std::equal(magic.begin(), magic.end(), MAGIC))
+        {
+            throw std::runtime_error("Not a saved machine state");
+        }
+        if (const auto version = reader.read<uint16_t>(); version != VERSION)
+        {
+            throw std::runtime_error(fmt::format("Machine state version {} is not supported, expected {}", version, VERSION));
+        }
+        if (const auto count = reader.read<uint16_t>(); count != components.size())
+        {
+            throw std::runtime_error(fmt::format("Machine state has {} components, the machine has {}", count, components.size()));
+        }
+
+        for (auto* component : components)
+        {
+            std::string name(reader.read<uint8_t>(), '\0');
+            reader.readBytes({ reinterpret_cast<uint8_t*>(name.data()), name.size() });
+            if (name != component->getName())
+            {
+                throw std::runtime_error(fmt::format("Machine state has {} where the machine has {}", name, component->getName()));
+            }
+            auto section = reader.sub(reader.read<uint32_t>());
+            component->loadState(section);
+            if (section.remaining() != 0)
+            {
+                throw std::runtime_error(fmt::format("Machine state for {} has {} unexpected bytes", name, section.remaining()));
+            }
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace EaterEmulator::core
+{
+    // Appends little-endian values to a byte buffer
+    class StateWriter
+    {
+    public:
+        explicit StateWriter(std::vector<uint8_t>& buffer) : _buffer(buffer) {}
+
+        template<typename T>
+            requires std::is_integral_v<T>
+        void write(T value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                _buffer.push_back(value ? 1 : 0);
+            }
+            else
+            {
+                for (size_t i = 0; i < sizeof(T); ++i)
+                {
+                    _buffer.push_back(static_cast<uint8_t>(static_cast<std::make_unsigned_t<T>>(value) >> (8 * i)));
+                }
+            }
+        }
+
+        void writeBytes(std::span<const uint8_t> bytes)
+        {
+            _buffer.insert(_buffer.end(), bytes.begin(), bytes.end());
+        }
+
+        size_t size() const { return _buffer.size(); }
+
+    private:
+        std::vector<uint8_t>& _buffer;
+    };
+
+    // Reads what StateWriter wrote. Throws std::runtime_error when reading past the end.
+    class StateReader
+    {
+    public:
+        explicit StateReader(std::span<const uint8_t> data) : _data(data) {}
+
+        template<typename T>
+            requires std::is_integral_v<T>
+        T read()
+        {
+            require(sizeof(T));
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                return _data[_position++] != 0;
+            }
+            else
+            {
+                std::make_unsigned_t<T> value = 0;
+                for (size_t i = 0; i < sizeof(T); ++i)
+                {
+                    value |= static_cast<std::make_unsigned_t<T>>(static_cast<std::make_unsigned_t<T>>(_data[_position + i]) << (8 * i));
+                }
+                _position += sizeof(T);
+                return static_cast<T>(value);
+            }
+        }
+
+        void readBytes(std::span<uint8_t> out)
+        {
+            require(out.size());
+            std::memcpy(out.data(), _data.data() + _position, out.size());
+            _position += out.size();
+        }
+
+        // Reader over the next size bytes, which are skipped in this one
+        StateReader sub(size_t size)
+        {
+            require(size);
+            StateReader reader(_data.subspan(_position, size));
+            _position += size;
+            return reader;
+        }
+
+        size_t remaining() const { return _data.size() - _position; }
+
+    private:
+        void require(size_t size) const
+        {
+            if (_data.size() - _position < size)
+            {
+                throw std::runtime_error("Machine state is truncated");
+            }
+        }
+
+        std::span<const uint8_t> _data;
+        size_t _position = 0;
+    };
+
+    // Component whose state can be saved and restored, e.g. to checkpoint a booted machine
+    class Stateful
+    {
+    public:
+        virtual ~Stateful() = default;
+
+        // Identifies the component's section in a saved state
+        virtual std::string getName() const = 0;
+
+        virtual void saveState(StateWriter& writer) const = 0;
+        // Called with exactly the bytes saveState wrote. Restoring the Bus drops every scheduled event,
+        // so it has to come first and devices re-schedule their own events from the restored state.
+        virtual void loadState(StateReader& reader) = 0;
+    };
+
+    // A saved state starts with the magic "6502SNAP", the format version and the number of sections as
+    // little-endian uint16. Each section is the component name as a uint8 length and characters, the
+    // payload length as uint32 and the payload. Any change to a component's layout bumps the version.
+    namespace machine_state
+    {
+        static constexpr char MAGIC[8] = { '6', '5', '0', '2', 'S', 'N', 'A', 'P' };
+        static constexpr uint16_t VERSION = 5;
+
+        std::vector<uint8_t> save(std::span<const Stateful* const> components);
+
+        // The components must be the same kinds, in the same order, as when saving.
+        // Throws std::runtime_error if the state does not match them.
+        void load(std::span<const uint8_t> state, std::span<Stateful* const> components);
+    }
+}
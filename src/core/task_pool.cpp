@@ -0,0 +1,140 @@
+#include "core/task_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace EaterEmulator::core
+{
+    namespace
+    {
+        // Pool and queue of the worker running on this thread, if any
+        thread_local const TaskPool* currentPool = nullptr;
+        thread_local size_t currentWorker = 0;
+    }
+
+    TaskPool::TaskPool(size_t threads)
+    {
+        if (threads == 0)
+        {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (size_t i = 0; i < threads; ++i)
+        {
+            _workers.push_back(std::make_unique<Worker>());
+        }
+        for (size_t i = 0; i < threads; ++i)
+        {
+            _threads.emplace_back([this, i](std::stop_token stopToken) { run(i, stopToken); });
+        }
+    }
+
+    TaskPool::~TaskPool()
+    {
+        {
+            std::unique_lock lock(_mutex);
+            _done.wait(lock, [this] { return _pending == 0; });
+        }
+        for (auto& thread : _threads)
+        {
+            thread.request_stop();
+        }
+        _wake.notify_all();
+    }
+
+    void TaskPool::submit(Task task)
+    {
+        size_t index;
+        {
+            std::lock_guard lock(_mutex);
+            index = currentPool == this ? currentWorker : _nextWorker++ % _workers.size();
+            ++_pending;
+            // Counted before it is queued so it is never taken before it is counted
+            ++_queued;
+        }
+        {
+            std::lock_guard lock(_workers[index]->mutex);
+            _workers[index]->tasks.push_back(std::move(task));
+        }
+        _wake.notify_one();
+    }
+
+    void TaskPool::wait()
+    {
+        std::unique_lock lock(_mutex);
+        _done.wait(lock, [this] { return _pending == 0; });
+        if (_error)
+        {
+            std::rethrow_exception(std::exchange(_error, nullptr));
+        }
+    }
+
+    void TaskPool::run(size_t index, std::stop_token stopToken)
+    {
+        currentPool = this;
+        currentWorker = index;
+        Task task;
+        while (true)
+        {
+            {
+                std::unique_lock lock(_mutex);
+                if (!_wake.wait(lock, stopToken, [this] { return _queued > 0; }))
+                {
+                    return; // Stopped with nothing left to do
+                }
+            }
+            if (!take(index, task))
+            {
+                continue; // Another worker got there first
+            }
+
+            std::exception_ptr error;
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            task = nullptr;
+
+            std::lock_guard lock(_mutex);
+            if (error && !_error)
+            {
+                _error = error;
+            }
+            if (--_pending == 0)
+            {
+                _done.notify_all();
+            }
+        }
+    }
+
+    bool TaskPool::take(size_t index, Task& task)
+    {
+        // Own queue from the back, then the other queues from the front
+        for (size_t i = 0; i < _workers.size(); ++i)
+        {
+            auto& worker = *_workers[(index + i) % _workers.size()];
+            std::lock_guard lock(worker.mutex);
+            if (worker.tasks.empty())
+            {
+                continue;
+            }
+            if (i == 0)
+            {
+                task = std::move(worker.tasks.back());
+                worker.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(worker.tasks.front());
+                worker.tasks.pop_front();
+            }
+            std::lock_guard queuedLock(_mutex);
+            --_queued;
+            return true;
+        }
+        return false;
+    }
+}
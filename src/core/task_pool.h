@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EaterEmulator::core
+{
+    // Work-stealing thread pool for coarse tasks, e.g. one machine per task.
+    // Every worker has its own queue. Tasks submitted from a worker go to the back of its queue and it
+    // takes its newest task first; an idle worker steals the oldest task from another worker's queue.
+    class TaskPool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        // 0 threads uses one per hardware thread
+        explicit TaskPool(size_t threads = 0);
+        // Finishes the queued tasks
+        ~TaskPool();
+
+        TaskPool(const TaskPool&) = delete;
+        TaskPool& operator=(const TaskPool&) = delete;
+        TaskPool(TaskPool&&) = delete;
+        TaskPool& operator=(TaskPool&&) = delete;
+
+        void submit(Task task);
+
+        // Blocks until every submitted task has finished. Rethrows the first exception a task threw.
+        // Not to be called from a task.
+        void wait();
+
+        size_t getThreadCount() const { return _threads.size(); }
+
+    private:
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void run(size_t index, std::stop_token stopToken);
+        bool take(size_t index, Task& task);
+
+        std::vector<std::unique_ptr<Worker>> _workers;
+        size_t _nextWorker = 0; // Queue for the next task submitted from outside the pool, guarded by _mutex
+
+        std::mutex _mutex;
+        std::condition_variable_any _wake; // Signalled when a task is queued or the pool stops
+        std::condition_variable _done; // Signalled when the last pending task finishes
+        size_t _queued = 0; // Tasks in any queue
+        size_t _pending = 0; // Tasks submitted and not finished
+        std::exception_ptr _error;
+
+        std::vector<std::jthread> _threads; // Last, so the workers stop before the queues go away
+    };
+}
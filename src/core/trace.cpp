@@ -0,0 +1,119 @@
+#include "core/trace.h"
+#include "core/spsc_ring.h"
+
+#include "spdlog/spdlog.h"
+#include "spdlog/fmt/fmt.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace EaterEmulator::core::trace
+{
+    namespace
+    {
+        using Ring = SpscRing<Record, RING_CAPACITY>;
+
+        // Every producing thread gets its own ring on its first record, the drain side walks all of them
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<std::shared_ptr<Ring>> rings;
+        };
+
+        Registry& registry()
+        {
+            static Registry instance;
+            return instance;
+        }
+
+        thread_local std::shared_ptr<Ring> localRing;
+        std::atomic<uint64_t> dropped{0};
+
+        std::string format(const Record& record)
+        {
+            const auto& args = record.args;
+            switch (record.argCount)
+            {
+                case 0: return record.format;
+                case 1: return fmt::format(fmt::runtime(record.format), args[0]);
+                case 2: return fmt::format(fmt::runtime(record.format), args[0], args[1]);
+                default: return fmt::format(fmt::runtime(record.format), args[0], args[1], args[2]);
+            }
+        }
+    }
+
+    void push(const Record& record)
+    {
+        if (!localRing)
+        {
+            localRing = std::make_shared<Ring>();
+            std::lock_guard lock(registry().mutex);
+            registry().rings.push_back(localRing);
+        }
+        if (!localRing->push(record))
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    size_t drain(const std::function<void(std::string_view)>& output)
+    {
+        auto& instance = registry();
+        std::lock_guard lock(instance.mutex);
+        size_t count = 0;
+        for (auto& ring : instance.rings)
+        {
+            while (auto record = ring->pop())
+            {
+                output(format(*record));
+                ++count;
+            }
+        }
+        // Rings of threads that have exited are only referenced here once emptied
+        std::erase_if(instance.rings, [](const auto& ring) { return ring.use_count() == 1 && ring->empty(); });
+        return count;
+    }
+
+    uint64_t droppedCount()
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    Writer::Writer(std::FILE* file) : _file(file)
+    {
+        _thread = std::jthread([this](std::stop_token stopToken) {
+            std::mutex mutex;
+            std::condition_variable_any wakeup;
+            while (!stopToken.stop_requested())
+            {
+                writeAll();
+                std::unique_lock lock(mutex);
+                wakeup.wait_for(lock, stopToken, std::chrono::milliseconds(10), []() { return false; });
+            }
+        });
+    }
+
+    Writer::~Writer()
+    {
+        _thread.request_stop();
+        _thread.join();
+        writeAll();
+        if (const auto lost = droppedCount())
+        {
+            spdlog::warn("Trace: {} records dropped, the writer could not keep up", lost);
+        }
+    }
+
+    void Writer::writeAll()
+    {
+        drain([this](std::string_view line) {
+            std::fwrite(line.data(), 1, line.size(), _file);
+            std::fputc('\n', _file);
+        });
+        std::fflush(_file);
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+// Per-access trace points for the emulation hot path.
+//
+// EATER_TRACE compiles to nothing unless the build defines EATER_TRACE_ENABLED (Debug builds, or the
+// ENABLE_TRACE CMake option), so Release builds pay nothing for them, not even argument evaluation.
+// When compiled in they are still off until trace::setEnabled(true), and then only store the format
+// string and arguments in a lock-free per-thread ring. Formatting and output happen on the thread
+// draining the channel, usually a trace::Writer.
+//
+// The format must be a string literal and the arguments integers, at most trace::MAX_ARGS of them.
+#ifdef EATER_TRACE_ENABLED
+#define EATER_TRACE(format, ...) \
+    do { \
+        if (::EaterEmulator::core::trace::isEnabled()) \
+        { \
+            ::EaterEmulator::core::trace::emit(format __VA_OPT__(,) __VA_ARGS__); \
+        } \
+    } while (0)
+#else
+#define EATER_TRACE(format, ...) do {} while (0)
+#endif
+
+namespace EaterEmulator::core::trace
+{
+    static constexpr size_t MAX_ARGS = 3;
+    static constexpr size_t RING_CAPACITY = 8192; // Records buffered per producing thread
+
+    // Whether trace points were compiled into this build
+    constexpr bool isCompiledIn()
+    {
+#ifdef EATER_TRACE_ENABLED
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    struct Record
+    {
+        const char* format = nullptr;
+        uint8_t argCount = 0;
+        std::array<uint64_t, MAX_ARGS> args{};
+    };
+
+    inline std::atomic<bool> enabled{false};
+
+    inline bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    inline void setEnabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+
+    // Queue a record from the calling thread. Never blocks, a record that does not fit is counted as dropped.
+    void push(const Record& record);
+
+    template<typename... Args>
+    void emit(const char* format, Args... args)
+    {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "Too many trace arguments");
+        static_assert((std::is_integral_v<Args> && ...), "Trace arguments must be integers");
+        push(Record{ format, static_cast<uint8_t>(sizeof...(Args)), { static_cast<uint64_t>(args)... } });
+    }
+
+    // Format every queued record and pass it to output, one line at a time. Only one thread may drain at a time.
+    // Returns the number of records drained.
+    size_t drain(const std::function<void(std::string_view)>& output);
+
+    // Records lost because a ring was full
+    uint64_t droppedCount();
+
+    // Drains the channel into a file from a background thread while it exists
+    class Writer
+    {
+    public:
+        explicit Writer(std::FILE* file = stderr);
+        ~Writer();
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+        Writer(Writer&&) = delete;
+        Writer& operator=(Writer&&) = delete;
+
+    private:
+        void writeAll();
+
+        std::FILE* _file;
+        std::jthread _thread;
+    };
+}
@@ -1,36 +1,53 @@
-
 #include "devices/ArduinoMega/ArduinoMega.h"
 
 #include "core/bus.h"
 #include "core/defines.h"
+#include "devices/W65C02S/W65C02S.h"
 #include "spdlog/spdlog.h"
-#include "spdlog/sinks/basic_file_sink.h"
+#include <filesystem>
 #include <sys/types.h>
 
 namespace EaterEmulator::devices
 {
-    ArduinoMega::ArduinoMega(std::shared_ptr<core::Bus> bus) 
-        : core::BusSlave(bus, 0x0000)
+    namespace
+    {
+        const std::string& createParentDirectory(const std::string& path)
+        {
+            const auto parent = std::filesystem::path(path).parent_path();
+            if (!parent.empty())
+            {
+                std::filesystem::create_directories(parent);
+            }
+            return path;
+        }
+    }
+
+    ArduinoMega::ArduinoMega(std::shared_ptr<core::Bus> bus, const std::string& tracePath) 
+        : core::BusSlave(bus, 0x0000), _trace(createParentDirectory(tracePath))
     {
-        spdlog::debug("ArduinoMega initialized.");
-        _logger = spdlog::basic_logger_mt("basic_logger", "logs/basic-log.txt", true);
+        log().debug("ArduinoMega initialized.");
     }
 
     ArduinoMega::~ArduinoMega() 
     {
-        spdlog::debug("ArduinoMega destroyed.");
+        log().debug("ArduinoMega destroyed.");
     }
 
     void ArduinoMega::handleBusNotification(uint16_t address, uint8_t rwb)
     {
         uint8_t data;
         _bus->getData(data);
-        _logger->info("{:016b}   {:04x}  {} {:02x}   {:08b}", address, address, rwb == core::HIGH ? 'r' : 'W', data, data);
-        _logger->flush();
+        _trace.record({
+            _cpu ? _cpu->getCycleCount() : _bus->getScheduler().now(),
+            address,
+            _cpu ? _cpu->getProgramCounter() : uint16_t{0},
+            data,
+            rwb,
+        });
     }
 
     bool ArduinoMega::shouldHandleAddress([[maybe_unused]]const uint16_t& address) const
     {
         return true;
     }
-} // namespace EaterEmulator
\ No newline at end of file
+} // namespace EaterEmulator
@@ -1,16 +1,21 @@
 #pragma once
 
 #include "core/bus_slave.h"
-#include "spdlog/spdlog.h"
+#include "core/bus_trace.h"
 #include <memory>
+#include <string>
 
 namespace EaterEmulator::devices
 {
-    // Arduino Mega used for logging
+    // Forward declarations
+    class W65C02S;
+
+    // Arduino Mega used for logging. Watches every bus access and records it to a binary trace file,
+    // which tools/bus_trace_decode turns back into the Arduino monitor's text output.
     class ArduinoMega : public core::BusSlave
     {
     public:
-        ArduinoMega(std::shared_ptr<core::Bus> bus);
+        ArduinoMega(std::shared_ptr<core::Bus> bus, const std::string& tracePath = "logs/bus-trace.bin");
         virtual ~ArduinoMega();
 
         ArduinoMega(const ArduinoMega&) = delete;
@@ -25,7 +30,14 @@ namespace EaterEmulator::devices
         
         std::string getName() const override { return "ArduinoMega"; }
 
+        // CPU providing the cycle count and program counter of each record. Without one, records carry
+        // the scheduler's cycle and a PC of 0.
+        void attachCPU(std::shared_ptr<const W65C02S> cpu) { _cpu = std::move(cpu); }
+
+        const core::BusTraceWriter& getTraceWriter() const { return _trace; }
+
     private:
-        std::shared_ptr<spdlog::logger> _logger;
+        core::BusTraceWriter _trace;
+        std::shared_ptr<const W65C02S> _cpu;
     };
-} // namespace EaterEmulator
\ No newline at end of file
+} // namespace EaterEmulator
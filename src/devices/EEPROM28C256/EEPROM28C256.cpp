@@ -3,45 +3,102 @@
 
 #include "core/bus.h"
 #include "core/defines.h"
+#include "core/trace.h"
 #include "spdlog/spdlog.h"
+#include <fstream>
+#include <iterator>
 #include <sys/types.h>
 
 namespace EaterEmulator::devices
 {
-    EEPROM28C256::EEPROM28C256(const std::vector<uint8_t>& rom, std::shared_ptr<core::Bus> bus) 
-        : core::BusSlave(bus, 0x8000), _memory{}
+    namespace
     {
+        // The chip decodes A0-A14 itself, whatever selects it
+        constexpr uint16_t CHIP_ADDRESS_MASK = sizeof(EEPROM28C256::Image) - 1;
+
+        void checkRange(core::AddressRange range)
+        {
+            if (range.start > range.end || static_cast<size_t>(range.end - range.start) >= sizeof(EEPROM28C256::Image))
+            {
+                throw std::runtime_error(fmt::format("EEPROM28C256 range {:#06x}-{:#06x} is larger than the chip", range.start, range.end));
+            }
+        }
+    }
+
+    EEPROM28C256::EEPROM28C256(const std::vector<uint8_t>& rom, std::shared_ptr<core::Bus> bus, core::AddressRange range) 
+        : core::BusSlave(bus, range.start), _range(range)
+    {
+        checkRange(range);
         if (rom.size() != 0x8000) 
         {
             throw std::runtime_error("ROM size must be exactly 32K (0x8000 bytes)");
         }
         // Initialize memory with the contents of the ROM
-        std::copy(rom.begin(), rom.end(), _memory.begin());
-        spdlog::debug("EEPROM28C256 initialized with ROM data.");
+        auto image = std::make_shared<Image>();
+        std::copy(rom.begin(), rom.end(), image->begin());
+        _image = std::move(image);
+        log().debug("EEPROM28C256 initialized with ROM data.");
+    }
+
+    EEPROM28C256::EEPROM28C256(std::shared_ptr<const Image> image, std::shared_ptr<core::Bus> bus, core::AddressRange range)
+        : core::BusSlave(bus, range.start), _image(std::move(image)), _range(range)
+    {
+        checkRange(range);
+        if (!_image)
+        {
+            throw std::runtime_error("EEPROM28C256 needs a ROM image");
+        }
     }
 
     EEPROM28C256::~EEPROM28C256() 
     {
-        spdlog::debug("EEPROM28C256 destroyed.");
+        log().debug("EEPROM28C256 destroyed.");
     }
 
     void EEPROM28C256::handleBusNotification(uint16_t address, uint8_t rwb)
     {
         if (!shouldHandleAddress(address)) {
-            spdlog::debug("EEPROM28C256: Address {:#04x} not handled by this device", address);
+            EATER_TRACE("EEPROM28C256: Address {:#04x} not handled by this device", address);
             return; // If the pins are not for this device, do nothing
         }
         if (rwb == core::HIGH)
         {
             // EEPROM Only handles when clock is HIGH
-            _bus->setData(_memory[address - _offset]);
+            _bus->setData((*_image)[address & CHIP_ADDRESS_MASK]);
         }
     }
 
     bool EEPROM28C256::shouldHandleAddress(const uint16_t& address) const
     {
-        // Decode address from the address bus and check if it falls within the range of this EEPROM
-        // EEPROM is mapped to addresses 0x8000 to 0xFFFF so only if A15 is HIGH
-        return (address & (1 << 15)) != 0; 
+        // On Ben Eater's board the EEPROM is selected when A15 is HIGH
+        return address >= _range.start && address <= _range.end;
+    }
+
+    std::vector<core::AddressRange> EEPROM28C256::getAddressRanges() const
+    {
+        return { _range };
+    }
+
+    std::optional<core::DirectPage> EEPROM28C256::getDirectPage(uint8_t page)
+    {
+        // Writes are still notified, and ignored
+        return core::DirectPage{ _image->data() + ((page << core::Bus::PAGE_SHIFT) & CHIP_ADDRESS_MASK), nullptr, true };
+    }
+
+    std::shared_ptr<const EEPROM28C256::Image> EEPROM28C256::loadImage(const std::string& path)
+    {
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs)
+        {
+            throw std::runtime_error(fmt::format("Error reading ROM file: {}", path));
+        }
+        const std::vector<uint8_t> data((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        if (data.size() != sizeof(Image))
+        {
+            throw std::runtime_error(fmt::format("ROM size must be exactly 32K (0x8000 bytes): {}", path));
+        }
+        auto image = std::make_shared<Image>();
+        std::copy(data.begin(), data.end(), image->begin());
+        return image;
     }
 } // namespace EaterEmulator
\ No newline at end of file
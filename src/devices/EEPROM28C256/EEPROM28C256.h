@@ -12,7 +12,15 @@ namespace EaterEmulator::devices
     class EEPROM28C256 : public core::BusSlave
     {
     public:
-        EEPROM28C256(const std::vector<uint8_t>& rom, std::shared_ptr<core::Bus> bus);
+        using Image = std::array<uint8_t, 0x8000>;
+
+        // Where Ben Eater's board decodes the EEPROM. Any range of at most 32K works; the low 15 address
+        // bits select the byte as on the chip, so the vectors at 0xFFFA-0xFFFF come from the end of the image.
+        static constexpr core::AddressRange DEFAULT_RANGE{0x8000, 0xFFFF};
+
+        EEPROM28C256(const std::vector<uint8_t>& rom, std::shared_ptr<core::Bus> bus, core::AddressRange range = DEFAULT_RANGE);
+        // Shares an image with other EEPROMs, e.g. those of forked machines, instead of copying it
+        EEPROM28C256(std::shared_ptr<const Image> image, std::shared_ptr<core::Bus> bus, core::AddressRange range = DEFAULT_RANGE);
         virtual ~EEPROM28C256();
 
         EEPROM28C256(const EEPROM28C256&) = delete;
@@ -24,14 +32,24 @@ namespace EaterEmulator::devices
         void handleBusNotification(uint16_t address, uint8_t rwb) override;
 
         bool shouldHandleAddress(const uint16_t& address) const override;
+
+        std::vector<core::AddressRange> getAddressRanges() const override;
+
+        std::optional<core::DirectPage> getDirectPage(uint8_t page) override;
         
         std::string getName() const override { return "EEPROM28C256"; }
 
+        const std::shared_ptr<const Image>& getImage() const { return _image; }
+
+        // Reads a ROM file. Throws std::runtime_error if it cannot be read or is not exactly 32K.
+        static std::shared_ptr<const Image> loadImage(const std::string& path);
+
 #ifdef UNIT_TEST
-        const std::array<uint8_t, 0x8000>& getMemory() const { return _memory; }
+        const Image& getMemory() const { return *_image; }
 #endif 
 
     private:
-        std::array<uint8_t, 0x8000> _memory; // 32K x 8-bit memory
+        std::shared_ptr<const Image> _image; // 32K x 8-bit memory, never written
+        core::AddressRange _range;
     };
 } // namespace EaterEmulator
\ No newline at end of file
@@ -4,18 +4,29 @@
 #include "spdlog/spdlog.h"
 
 #include <sys/types.h>
-#include <iostream>
 #include <bit>
 
 namespace EaterEmulator::devices
 {
-    HD44780LCD::HD44780LCD() 
+    uint8_t HD44780LCD::Snapshot::addressAt(const Geometry& geometry, uint8_t row, uint8_t column) const
     {
+        // Rows 2 and 3 of a four-row module continue lines 1 and 2, so on a 20x4 glass row 2 starts at 0x14
+        // and row 3 at 0x54. In one-line mode the single line is 80 characters long.
+        const auto line = row % 2;
+        const auto lineLength = twoLines ? LINE_LENGTH : 2 * LINE_LENGTH;
+        const auto position = ((row / 2) * geometry.columns + column + displayShift) % lineLength;
+        return static_cast<uint8_t>(line * SECOND_LINE + position);
     }
 
-    HD44780LCD::~HD44780LCD() 
+    HD44780LCD::HD44780LCD()
     {
-        spdlog::debug("HD44780LCD destroyed.");
+        _state.ddram.fill(' ');
+        markAllDirty();
+    }
+
+    HD44780LCD::~HD44780LCD()
+    {
+        log().debug("HD44780LCD destroyed.");
     }
 
     void HD44780LCD::setControlLines(uint8_t rs, uint8_t rw, bool enable)
@@ -30,6 +41,67 @@ namespace EaterEmulator::devices
         _data = data;
     }
 
+    HD44780LCD::Snapshot HD44780LCD::takeSnapshot()
+    {
+        std::lock_guard lock(_mutex);
+        Snapshot snapshot = _state;
+        snapshot.generation = _generation.load(std::memory_order_relaxed);
+        _state.dirtyCells.reset();
+        _state.dirtyCharacters = 0;
+        return snapshot;
+    }
+
+    void HD44780LCD::saveState(core::StateWriter& writer) const
+    {
+        // The renderer only clears dirty marks, so the display state is read without the lock
+        writer.write(_rs);
+        writer.write(_rw);
+        writer.write(_enable);
+        writer.write(_data);
+        writer.write(_dataRegister);
+        writer.write(_instructionRegister);
+        writer.write(static_cast<uint8_t>(_bitsMode));
+        writer.write(static_cast<uint8_t>(_linesMode));
+        writer.write(_increment);
+        writer.write(_shiftOnWrite);
+        writer.write(_cgramSelected);
+        writer.write(_cgramAddress);
+        writer.writeBytes(_state.ddram);
+        writer.writeBytes(_state.cgram);
+        writer.write(_state.addressCounter);
+        writer.write(_state.displayShift);
+        writer.write(_state.displayOn);
+        writer.write(_state.cursorOn);
+        writer.write(_state.blinkOn);
+    }
+
+    void HD44780LCD::loadState(core::StateReader& reader)
+    {
+        std::lock_guard lock(_mutex);
+        _rs = reader.read<uint8_t>();
+        _rw = reader.read<uint8_t>();
+        _enable = reader.read<bool>();
+        _data = reader.read<uint8_t>();
+        _dataRegister = reader.read<uint8_t>();
+        _instructionRegister = reader.read<uint8_t>();
+        _bitsMode = static_cast<BitsMode>(reader.read<uint8_t>());
+        _linesMode = static_cast<LinesMode>(reader.read<uint8_t>());
+        _increment = reader.read<bool>();
+        _shiftOnWrite = reader.read<bool>();
+        _cgramSelected = reader.read<bool>();
+        _cgramAddress = reader.read<uint8_t>();
+        reader.readBytes(_state.ddram);
+        reader.readBytes(_state.cgram);
+        _state.addressCounter = reader.read<uint8_t>();
+        _state.displayShift = reader.read<uint8_t>();
+        _state.displayOn = reader.read<bool>();
+        _state.cursorOn = reader.read<bool>();
+        _state.blinkOn = reader.read<bool>();
+        _state.twoLines = _linesMode == LinesMode::LINES_2;
+        markAllDirty();
+        _generation.fetch_add(1, std::memory_order_release);
+    }
+
     void HD44780LCD::checkEnableToggled(bool newEnabled)
     {
         // Data/contol are updated on the falling edge of the enable signal. If it was high and now low, we should process the current state of the LCD
@@ -48,6 +120,8 @@ namespace EaterEmulator::devices
 
     void HD44780LCD::handleWrite()
     {
+        // Only the state update is done here, drawing is left to whoever polls the snapshot
+        std::lock_guard lock(_mutex);
         if (_rs == 0)
         {
             _instructionRegister = _data;
@@ -58,65 +132,127 @@ namespace EaterEmulator::devices
             switch(instruction)
             {
                 case 0: // Clear display
-                    _ddram.fill(0);
-                    _addressCounter = 0;
+                    _state.ddram.fill(' ');
+                    _state.addressCounter = 0;
+                    _state.displayShift = 0;
+                    _increment = true;
+                    _cgramSelected = false;
+                    markAllDirty();
                     break;
                 case 1: // Return home
-                    _addressCounter = 0;
+                    _state.addressCounter = 0;
+                    _state.displayShift = 0;
+                    _cgramSelected = false;
+                    markAllDirty();
                     break;
                 case 2: // Entry mode set
-
+                    _increment = (_instructionRegister & 0b00000010) != 0;
+                    _shiftOnWrite = (_instructionRegister & 0b00000001) != 0;
                     break;
                 case 3: // Display on/off control
-                    _displayOn = (_instructionRegister & 0b00000100) != 0;
-                    _cursorOn = (_instructionRegister & 0b00000010) != 0;
-                    _blinkOn = (_instructionRegister & 0b00000001) != 0;
+                    _state.displayOn = (_instructionRegister & 0b00000100) != 0;
+                    _state.cursorOn = (_instructionRegister & 0b00000010) != 0;
+                    _state.blinkOn = (_instructionRegister & 0b00000001) != 0;
+                    markAllDirty();
                     break;
                 case 4: // Cursor display shift
+                    if (_instructionRegister & 0b00001000)
+                    {
+                        shiftDisplay((_instructionRegister & 0b00000100) != 0);
+                    }
+                    else
+                    {
+                        moveAddressCounter((_instructionRegister & 0b00000100) != 0);
+                    }
                     break;
                 case 5: // Function set
                     _bitsMode =  (_instructionRegister & 0b00010000) ? BitsMode::MODE_8 : BitsMode::MODE_4;
                     _linesMode = (_instructionRegister & 0b00001000) ? LinesMode::LINES_2 : LinesMode::LINES_1;
+                    _state.twoLines = _linesMode == LinesMode::LINES_2;
+                    markAllDirty();
                     break;
                 case 6: // Set CGRAM address
-                    // break;
+                    _cgramAddress = _instructionRegister & 0x3F;
+                    _cgramSelected = true;
+                    break;
                 case 7: // Set DDRAM address
-                    // break;
-                default:
-                    spdlog::error("Unhandled instruction: {:#04x}", static_cast<int>(_instructionRegister));
+                    _state.addressCounter = _instructionRegister & 0x7F;
+                    _cgramSelected = false;
                     break;
+                default:
+                    log().error("Unhandled instruction: {:#04x}", static_cast<int>(_instructionRegister));
+                    return;
             }
         }
         else
         {
             _dataRegister = _data;
+            writeData(_dataRegister);
         }
-        update();
+        _generation.fetch_add(1, std::memory_order_release);
     }
 
     void HD44780LCD::handleRead()
     {
-        
+
     }
 
-    void HD44780LCD::update()
+    void HD44780LCD::writeData(uint8_t data)
     {
-        if (_rs == 0)
+        if (_cgramSelected)
         {
+            _state.cgram[_cgramAddress] = data;
+            _state.dirtyCharacters |= static_cast<uint8_t>(1 << (_cgramAddress >> 3));
+            _cgramAddress = (_cgramAddress + (_increment ? 1 : -1)) & 0x3F;
+            return;
         }
-        else
+
+        _state.ddram[_state.addressCounter] = data;
+        _state.dirtyCells.set(_state.addressCounter);
+        moveAddressCounter(_increment);
+        if (_shiftOnWrite)
         {
-            // Update data register
-            _ddram[_addressCounter] = _dataRegister;
-            _addressCounter = (_addressCounter + 1) % _ddram.size(); // Increment address counter, wrap around if necessary
+            // The display follows the cursor so it appears to stay in place
+            shiftDisplay(!_increment);
+        }
+    }
 
+    void HD44780LCD::moveAddressCounter(bool increment)
+    {
+        auto& counter = _state.addressCounter;
+        if (_linesMode == LinesMode::LINES_2)
+        {
+            // The counter jumps between the end of one line and the start of the other
+            constexpr uint8_t FIRST_END = LINE_LENGTH - 1;
+            constexpr uint8_t SECOND_END = SECOND_LINE + LINE_LENGTH - 1;
+            if (increment)
+            {
+                counter = counter == FIRST_END ? SECOND_LINE : counter == SECOND_END ? 0 : (counter + 1) & 0x7F;
+            }
+            else
+            {
+                counter = counter == 0 ? SECOND_END : counter == SECOND_LINE ? FIRST_END : (counter - 1) & 0x7F;
+            }
         }
-        std::cout << "\r";
-        for (const auto& character : _ddram)
+        else
         {
-            std::cout << static_cast<char>(character);
+            constexpr uint8_t LENGTH = 2 * LINE_LENGTH;
+            counter = increment ? (counter + 1) % LENGTH : (counter + LENGTH - 1) % LENGTH;
         }
-        std::flush(std::cout);
     }
 
-} // namespace EaterEmulator
\ No newline at end of file
+    void HD44780LCD::shiftDisplay(bool right)
+    {
+        // Shifting right shows earlier addresses, so the offset of the first column goes down
+        const uint8_t length = _linesMode == LinesMode::LINES_2 ? LINE_LENGTH : 2 * LINE_LENGTH;
+        _state.displayShift = (_state.displayShift + (right ? length - 1 : 1)) % length;
+        markAllDirty();
+    }
+
+    void HD44780LCD::markAllDirty()
+    {
+        _state.dirtyCells.set();
+        _state.dirtyCharacters = 0xFF;
+    }
+
+} // namespace EaterEmulator
@@ -1,14 +1,53 @@
 #pragma once
 
-#include <cstdint>
+#include "core/logging.h"
+#include "core/state.h"
+
 #include <array>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <mutex>
+#include <string>
 
 namespace EaterEmulator::devices
 {
     // HD44780LCD is a common LCD controller
-    class HD44780LCD
+    class HD44780LCD : public core::Loggable, public core::Stateful
     {
     public:
+        // DDRAM is addressed 0x00-0x7F, in two-line mode line 1 is 0x00-0x27 and line 2 is 0x40-0x67
+        static constexpr size_t DDRAM_SIZE = 0x80;
+        static constexpr size_t CGRAM_SIZE = 0x40; // 8 custom characters of 8 rows each
+        static constexpr uint8_t LINE_LENGTH = 0x28; // Characters per line in two-line mode
+        static constexpr uint8_t SECOND_LINE = 0x40;
+
+        // Visible area of the glass, 16x2 and 20x4 are the common modules
+        struct Geometry
+        {
+            uint8_t columns = 16;
+            uint8_t rows = 2;
+        };
+
+        // Copy of the controller state taken for the renderer, with the cells written since the previous snapshot
+        struct Snapshot
+        {
+            std::array<uint8_t, DDRAM_SIZE> ddram{};
+            std::array<uint8_t, CGRAM_SIZE> cgram{};
+            std::bitset<DDRAM_SIZE> dirtyCells;
+            uint8_t dirtyCharacters = 0; // Bit n set when custom character n was redefined
+            uint8_t addressCounter = 0;
+            uint8_t displayShift = 0;
+            bool displayOn = false;
+            bool cursorOn = false;
+            bool blinkOn = false;
+            bool twoLines = false;
+            uint64_t generation = 0;
+
+            // DDRAM address shown at a position of the glass, taking the display shift into account
+            uint8_t addressAt(const Geometry& geometry, uint8_t row, uint8_t column) const;
+        };
+
         HD44780LCD();
         virtual ~HD44780LCD();
 
@@ -20,6 +59,19 @@ namespace EaterEmulator::devices
 
         void setControlLines(uint8_t rs, uint8_t rw, bool enable);
         void writeDataLines(uint8_t data);
+
+        // Bumped on every change to what the display shows. Cheap to poll from another thread.
+        uint64_t getGeneration() const { return _generation.load(std::memory_order_acquire); }
+
+        // Safe to call from a renderer thread while the CPU runs. Clears the dirty marks, so meant for a single consumer.
+        Snapshot takeSnapshot();
+
+        std::string getName() const override { return "HD44780LCD"; }
+
+        // Controller registers, DDRAM and CGRAM. Called from the thread that drives the control lines.
+        void saveState(core::StateWriter& writer) const override;
+        void loadState(core::StateReader& reader) override;
+
     private:
 
         enum BitsMode
@@ -34,30 +86,33 @@ namespace EaterEmulator::devices
             LINES_2 = 1
         };
 
-
-
         void checkEnableToggled(bool newEnabled);
 
         void handleWrite();
         void handleRead();
 
-        void update();
+        void writeData(uint8_t data);
+        void moveAddressCounter(bool increment);
+        void shiftDisplay(bool right);
+        void markAllDirty();
 
-        uint8_t _rs;
-        uint8_t _rw;
-        bool _enable;
-        uint8_t _data;
-        uint8_t _dataRegister;
-        uint8_t _instructionRegister;
-        uint8_t _addressCounter;
+        uint8_t _rs = 0;
+        uint8_t _rw = 0;
+        bool _enable = false;
+        uint8_t _data = 0;
+        uint8_t _dataRegister = 0;
+        uint8_t _instructionRegister = 0;
 
+        BitsMode _bitsMode = BitsMode::MODE_8;
+        LinesMode _linesMode = LinesMode::LINES_1;
+        bool _increment = true; // Entry mode I/D
+        bool _shiftOnWrite = false; // Entry mode S
+        bool _cgramSelected = false; // Data goes to CGRAM after a set CGRAM address until the next set DDRAM address
+        uint8_t _cgramAddress = 0;
 
-        bool _displayOn;
-        bool _cursorOn;
-        bool _blinkOn;
-        BitsMode _bitsMode;
-        LinesMode _linesMode;
-        
-        std::array<uint8_t, 80> _ddram;
+        // Display state shared with the renderer, guarded by _mutex
+        std::mutex _mutex;
+        Snapshot _state;
+        std::atomic<uint64_t> _generation{0};
     };
-} // namespace EaterEmulator
\ No newline at end of file
+} // namespace EaterEmulator
@@ -0,0 +1,165 @@
+
+#include "devices/HD44780LCD/LCDRenderer.h"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string_view>
+
+namespace EaterEmulator::devices
+{
+    namespace
+    {
+        // Character generator ROM A00 matches ASCII for the printable range, with a few symbols above it
+        std::string_view glyph(uint8_t character)
+        {
+            static const auto ASCII = []() {
+                std::array<char, 0x80> table{};
+                for (int i = 0; i < 0x80; ++i) table[i] = static_cast<char>(i);
+                return table;
+            }();
+
+            if (character < 0x10) return "#"; // Custom CGRAM character, 0x08-0x0F mirror 0x00-0x07
+            if (character >= 0x20 && character <= 0x7D) return { &ASCII[character], 1 };
+            switch (character)
+            {
+                case 0x7E: return "→";
+                case 0x7F: return "←";
+                case 0xDF: return "°";
+                default: return "?";
+            }
+        }
+    }
+
+    LCDRenderer::LCDRenderer(std::shared_ptr<HD44780LCD> lcd, HD44780LCD::Geometry geometry, std::ostream& out)
+        : _lcd(std::move(lcd)), _geometry(geometry), _out(out)
+    {
+    }
+
+    LCDRenderer::~LCDRenderer()
+    {
+        stop();
+        spdlog::debug("LCDRenderer destroyed.");
+    }
+
+    void LCDRenderer::start()
+    {
+        if (_renderThread.joinable())
+        {
+            return;
+        }
+        _renderThread = std::jthread([this](std::stop_token stopToken) { renderLoop(stopToken); });
+    }
+
+    void LCDRenderer::stop()
+    {
+        if (_renderThread.joinable())
+        {
+            _renderThread.request_stop();
+            _renderThread.join();
+            _renderThread = std::jthread();
+        }
+    }
+
+    void LCDRenderer::renderLoop(std::stop_token stopToken)
+    {
+        using namespace std::chrono;
+        const auto framePeriod = duration_cast<steady_clock::duration>(duration<double>(1.0 / std::max(_frameRate, 1e-3)));
+
+        std::mutex mutex;
+        std::condition_variable_any wakeup;
+        auto nextFrame = steady_clock::now();
+        while (!stopToken.stop_requested())
+        {
+            renderIfChanged();
+
+            nextFrame += framePeriod;
+            const auto now = steady_clock::now();
+            if (nextFrame < now)
+            {
+                nextFrame = now; // Drawing took longer than a frame, drop the missed ones
+            }
+            std::unique_lock lock(mutex);
+            wakeup.wait_until(lock, stopToken, nextFrame, []() { return false; });
+        }
+        renderIfChanged(); // The final state of the display stays on screen
+    }
+
+    bool LCDRenderer::renderIfChanged()
+    {
+        if (_drawn && _lcd->getGeneration() == _renderedGeneration)
+        {
+            return false;
+        }
+        const auto snapshot = _lcd->takeSnapshot();
+        _renderedGeneration = snapshot.generation;
+
+        std::string border(_geometry.columns + 2, '-');
+        border.front() = border.back() = '+';
+        border += '\n';
+        std::string frame;
+        if (!_drawn || !_inPlace)
+        {
+            frame += border;
+            for (uint8_t row = 0; row < _geometry.rows; ++row)
+            {
+                frame.append("|").append(formatRow(snapshot, row)).append("|\n");
+            }
+            frame += border;
+            _drawn = true;
+        }
+        else
+        {
+            // The cursor rests below the frame, step up to each changed row and back down again
+            for (uint8_t row = 0; row < _geometry.rows; ++row)
+            {
+                if (!isRowDirty(snapshot, row)) continue;
+                const auto up = std::to_string(_geometry.rows - row + 1);
+                frame.append("\x1b[").append(up).append("A\r|");
+                frame.append(formatRow(snapshot, row));
+                frame.append("|\x1b[").append(up).append("B\r");
+            }
+            if (frame.empty())
+            {
+                return false;
+            }
+        }
+
+        _out << frame << std::flush;
+        _frames.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::string LCDRenderer::formatRow(const HD44780LCD::Snapshot& snapshot, uint8_t row) const
+    {
+        // In one-line mode the second line of the glass is not driven
+        if (!snapshot.displayOn || (!snapshot.twoLines && row % 2 == 1))
+        {
+            return std::string(_geometry.columns, ' ');
+        }
+        std::string text;
+        for (uint8_t column = 0; column < _geometry.columns; ++column)
+        {
+            text += glyph(snapshot.ddram[snapshot.addressAt(_geometry, row, column)]);
+        }
+        return text;
+    }
+
+    bool LCDRenderer::isRowDirty(const HD44780LCD::Snapshot& snapshot, uint8_t row) const
+    {
+        for (uint8_t column = 0; column < _geometry.columns; ++column)
+        {
+            const auto address = snapshot.addressAt(_geometry, row, column);
+            const auto character = snapshot.ddram[address];
+            if (snapshot.dirtyCells.test(address) || (character < 0x10 && (snapshot.dirtyCharacters >> (character & 0x07)) & 1))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+} // namespace EaterEmulator
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "devices/HD44780LCD/HD44780LCD.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace EaterEmulator::devices
+{
+    // Draws an HD44780LCD on a text stream from its own thread. Changes are picked up at most once per frame,
+    // so the CPU only pays for updating the controller state however often the firmware writes to it.
+    class LCDRenderer
+    {
+    public:
+        static constexpr double DEFAULT_FRAME_RATE = 30.0;
+
+        LCDRenderer(std::shared_ptr<HD44780LCD> lcd, HD44780LCD::Geometry geometry = {}, std::ostream& out = std::cout);
+        ~LCDRenderer();
+
+        LCDRenderer(const LCDRenderer&) = delete;
+        LCDRenderer& operator=(const LCDRenderer&) = delete;
+
+        LCDRenderer(LCDRenderer&&) = delete;
+        LCDRenderer& operator=(LCDRenderer&&) = delete;
+
+        // Takes effect on the next start()
+        void setFrameRate(double framesPerSecond) { _frameRate = framesPerSecond; }
+
+        // Redraw only the changed rows in place with ANSI cursor movement. Otherwise every frame is printed
+        // in full below the previous one, which suits files and pipes.
+        void setInPlace(bool inPlace) { _inPlace = inPlace; }
+
+        void start();
+        // Stops the render thread after drawing any pending change
+        void stop();
+
+        // Draw a frame now if the display changed since the last one. Returns whether anything was drawn.
+        bool renderIfChanged();
+
+        uint64_t getFrameCount() const { return _frames.load(std::memory_order_relaxed); }
+
+    private:
+        void renderLoop(std::stop_token stopToken);
+        std::string formatRow(const HD44780LCD::Snapshot& snapshot, uint8_t row) const;
+        bool isRowDirty(const HD44780LCD::Snapshot& snapshot, uint8_t row) const;
+
+        std::shared_ptr<HD44780LCD> _lcd;
+        HD44780LCD::Geometry _geometry;
+        std::ostream& _out;
+        double _frameRate = DEFAULT_FRAME_RATE;
+        bool _inPlace = false;
+
+        uint64_t _renderedGeneration = 0;
+        bool _drawn = false; // Whether the frame border is on screen yet
+        std::atomic<uint64_t> _frames{0};
+        std::jthread _renderThread;
+    };
+} // namespace EaterEmulator
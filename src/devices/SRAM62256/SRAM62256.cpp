@@ -3,46 +3,158 @@
 
 #include "core/bus.h"
 #include "core/defines.h"
+#include "core/trace.h"
 #include "spdlog/spdlog.h"
+#include <algorithm>
+#include <stdexcept>
 #include <sys/types.h>
 
 namespace EaterEmulator::devices
 {
-    SRAM62256::SRAM62256(std::shared_ptr<core::Bus> bus) 
-        : core::BusSlave(bus, 0x0000), _memory{}
+    namespace
     {
+        // The chip decodes A0-A14 itself, whatever selects it
+        constexpr size_t CHIP_ADDRESS_MASK = sizeof(SRAM62256::Memory) - 1;
+    }
+
+    SRAM62256::SRAM62256(std::shared_ptr<core::Bus> bus, core::AddressRange range) 
+        : core::BusSlave(bus, range.start), _memory(std::make_shared<Memory>()), _range(range)
+    {
+        if (range.start > range.end || static_cast<size_t>(range.end - range.start) >= sizeof(Memory))
+        {
+            throw std::runtime_error(fmt::format("SRAM62256 range {:#06x}-{:#06x} is larger than the chip", range.start, range.end));
+        }
+    }
+
+    SRAM62256::SRAM62256(std::shared_ptr<core::Bus> bus, SRAM62256& source)
+        : core::BusSlave(bus, source._offset), _memory(source._memory), _shared(true), _range(source._range)
+    {
+        for (size_t i = 0; i < PAGE_COUNT; ++i)
+        {
+            if (source._privatePages[i])
+            {
+                _privatePages[i] = std::make_unique<Page>(*source._privatePages[i]);
+            }
+        }
+        if (!source._shared)
+        {
+            // The source wrote its memory in place until now, from here on it copies pages as well
+            source._shared = true;
+            source.remapPages();
+        }
     }
 
     SRAM62256::~SRAM62256() 
     {
-        spdlog::debug("SRAM62256 destroyed.");
+        log().debug("SRAM62256 destroyed.");
     }
 
     void SRAM62256::handleBusNotification(uint16_t address, uint8_t rwb)
     {
         if (!shouldHandleAddress(address)) {
-            spdlog::debug("SRAM62256: Address {:#04x} not handled by this device", address);
+            EATER_TRACE("SRAM62256: Address {:#04x} not handled by this device", address);
             return; // If the pins are not for this device, do nothing
         }
+        const size_t offset = address & CHIP_ADDRESS_MASK;
         if (rwb == core::HIGH)
         {
             // EEPROM Only handles when clock is HIGH
-            _bus->setData(_memory[address - _offset]);
+            _bus->setData(readablePage(offset >> core::Bus::PAGE_SHIFT)[offset & core::Bus::PAGE_MASK]);
         }
         else
         {
             // Write operation
             uint8_t data;
             _bus->getData(data); // Get data from the bus
-            _memory[address - _offset] = data; // Write data to the memory
-            spdlog::debug("SRAM62256: Written data {:#04x} to address {:#04x}", data, address);
+            writablePage(offset >> core::Bus::PAGE_SHIFT)[offset & core::Bus::PAGE_MASK] = data; // Write data to the memory
+            EATER_TRACE("SRAM62256: Written data {:#04x} to address {:#04x}", data, address);
         }
     }
 
     bool SRAM62256::shouldHandleAddress(const uint16_t& address) const
     {
-        // Decode address from the address bus and check if it falls within the range of this SRAM
-        // SRAM is mapped to addresses 0x0000 to 0x3FFF so only if A14 and A15 are LOW
-        return (address & (1 << 15)) == 0 && (address & (1 << 14)) == 0; 
+        // On Ben Eater's board the SRAM is selected when A14 and A15 are LOW
+        return address >= _range.start && address <= _range.end;
+    }
+
+    std::vector<core::AddressRange> SRAM62256::getAddressRanges() const
+    {
+        return { _range };
+    }
+
+    std::optional<core::DirectPage> SRAM62256::getDirectPage(uint8_t page)
+    {
+        // Shared pages are read directly, their first write comes through handleBusNotification to copy them
+        const size_t index = page % PAGE_COUNT;
+        uint8_t* write = _privatePages[index] ? _privatePages[index]->data()
+            : _shared ? nullptr : _memory->data() + index * sizeof(Page);
+        return core::DirectPage{ readablePage(index), write, false };
+    }
+
+    size_t SRAM62256::getPrivatePageCount() const
+    {
+        return static_cast<size_t>(std::ranges::count_if(_privatePages, [](const auto& page) { return page != nullptr; }));
+    }
+
+    const uint8_t* SRAM62256::readablePage(size_t index) const
+    {
+        return _privatePages[index] ? _privatePages[index]->data() : _memory->data() + index * sizeof(Page);
+    }
+
+    uint8_t* SRAM62256::writablePage(size_t index)
+    {
+        if (_privatePages[index])
+        {
+            return _privatePages[index]->data();
+        }
+        if (!_shared)
+        {
+            return _memory->data() + index * sizeof(Page);
+        }
+        auto page = std::make_unique<Page>();
+        std::copy_n(_memory->data() + index * sizeof(Page), sizeof(Page), page->data());
+        _privatePages[index] = std::move(page);
+        // The bus page within our range whose chip page this is
+        const size_t firstPage = _range.start >> core::Bus::PAGE_SHIFT;
+        _bus->remapPage(static_cast<uint8_t>(firstPage + (index + PAGE_COUNT - firstPage % PAGE_COUNT) % PAGE_COUNT));
+        return _privatePages[index]->data();
+    }
+
+    void SRAM62256::remapPages()
+    {
+        for (const auto& range : getAddressRanges())
+        {
+            for (size_t page = range.start >> core::Bus::PAGE_SHIFT; page <= (range.end >> core::Bus::PAGE_SHIFT); ++page)
+            {
+                if (_bus->getSlaveForAddress(static_cast<uint16_t>(page << core::Bus::PAGE_SHIFT)) == this)
+                {
+                    _bus->remapPage(static_cast<uint8_t>(page));
+                }
+            }
+        }
+    }
+
+    void SRAM62256::saveState(core::StateWriter& writer) const
+    {
+        for (size_t i = 0; i < PAGE_COUNT; ++i)
+        {
+            writer.writeBytes({ readablePage(i), sizeof(Page) });
+        }
+    }
+
+    void SRAM62256::loadState(core::StateReader& reader)
+    {
+        if (!_shared)
+        {
+            // The bus keeps pointers into _memory, so it is refilled in place
+            reader.readBytes(*_memory);
+            return;
+        }
+        // Memory shared with forks is left to them and the state goes into memory of our own
+        _memory = std::make_shared<Memory>();
+        _shared = false;
+        std::ranges::fill(_privatePages, nullptr);
+        reader.readBytes(*_memory);
+        remapPages();
     }
-} // namespace EaterEmulator
\ No newline at end of file
+} // namespace EaterEmulator
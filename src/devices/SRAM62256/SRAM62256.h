@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/bus_slave.h"
+#include "core/state.h"
 
 #include <array>
 #include <memory>
@@ -8,10 +9,21 @@
 namespace EaterEmulator::devices
 {
     // SRAM 62256 is a 32K x 8-bit SRAM
-    class SRAM62256 : public core::BusSlave
+    class SRAM62256 : public core::BusSlave, public core::Stateful
     {
     public:
-        SRAM62256(std::shared_ptr<core::Bus> bus);
+        using Memory = std::array<uint8_t, 0x8000>;
+        using Page = std::array<uint8_t, core::Bus::PAGE_SIZE>;
+        static constexpr size_t PAGE_COUNT = sizeof(Memory) / sizeof(Page);
+
+        // Where Ben Eater's board decodes the SRAM, leaving its upper half unused. Any range of at most 32K
+        // works; the low 15 address bits select the byte as on the chip.
+        static constexpr core::AddressRange DEFAULT_RANGE{0x0000, 0x3FFF};
+
+        SRAM62256(std::shared_ptr<core::Bus> bus, core::AddressRange range = DEFAULT_RANGE);
+        // Copy-on-write fork of source on another bus. Both share the memory and each copies a page
+        // before writing it, so a fork only holds the pages it dirtied. Not safe while source is running.
+        SRAM62256(std::shared_ptr<core::Bus> bus, SRAM62256& source);
         virtual ~SRAM62256();
 
         SRAM62256(const SRAM62256&) = delete;
@@ -23,15 +35,32 @@ namespace EaterEmulator::devices
         void handleBusNotification(uint16_t address, uint8_t rwb) override;
 
         bool shouldHandleAddress(const uint16_t& address) const override;
+
+        std::vector<core::AddressRange> getAddressRanges() const override;
+
+        std::optional<core::DirectPage> getDirectPage(uint8_t page) override;
         
         std::string getName() const override { return "SRAM62256"; }
 
+        void saveState(core::StateWriter& writer) const override;
+        void loadState(core::StateReader& reader) override;
+
+        // Pages this SRAM holds a private copy of
+        size_t getPrivatePageCount() const;
+
 #ifdef UNIT_TEST
-        std::array<uint8_t, 0x8000>& getMemory() { return _memory; }
+        // Only reflects the contents until the SRAM is forked
+        Memory& getMemory() { return *_memory; }
 #endif 
 
     private:
-        std::array<uint8_t, 0x8000> _memory; // 32K x 8-bit memory
+        const uint8_t* readablePage(size_t index) const;
+        uint8_t* writablePage(size_t index);
+        void remapPages();
 
+        std::shared_ptr<Memory> _memory; // 32K x 8-bit memory, never written again once shared
+        std::array<std::unique_ptr<Page>, PAGE_COUNT> _privatePages; // Pages written since _memory was shared
+        bool _shared = false;
+        core::AddressRange _range;
     };
 } // namespace EaterEmulator
\ No newline at end of file
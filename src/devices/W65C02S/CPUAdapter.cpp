@@ -18,11 +18,9 @@ namespace EaterEmulator::devices
 
     void CPUAdapter::writeToPort(int portId, uint8_t data)
     {
-        switch (portId) 
+        if (portId >= IRQ_PORT && portId < IRQ_PORT + W65C02S::IRQ_SOURCES)
         {
-            case IRQ_PORT:
-                _cpu->setIRQ(data == 0 ? core::LOW : core::HIGH);
-                break;
+            _cpu->setIRQ(data == 0 ? core::LOW : core::HIGH, static_cast<uint8_t>(portId - IRQ_PORT));
         }
     }
 } // namespace EaterEmulator::devices
\ No newline at end of file
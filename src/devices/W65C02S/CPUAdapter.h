@@ -10,6 +10,8 @@ namespace EaterEmulator::devices
     class CPUAdapter
     {
     public:
+        // IRQB is wired-OR. Each device driving it writes its own port, IRQ_PORT, IRQ_PORT + 1 and so on up
+        // to W65C02S::IRQ_SOURCES of them.
         static constexpr int IRQ_PORT = 0;
 
         CPUAdapter(std::shared_ptr<W65C02S> cpu);
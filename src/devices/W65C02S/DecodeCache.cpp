@@ -0,0 +1,58 @@
+#include "devices/W65C02S/DecodeCache.h"
+
+namespace EaterEmulator::devices
+{
+    void DecodeCache::clear()
+    {
+        for (auto& page : _pages)
+        {
+            page.reset();
+        }
+        _decodedCount = 0;
+    }
+
+    const DecodeCache::Instruction* DecodeCache::decode(const core::Bus& bus, uint16_t pc)
+    {
+        if (bus.getMapGeneration() != _generation)
+        {
+            clear();
+            _generation = bus.getMapGeneration();
+        }
+
+        auto readConstant = [&bus](uint16_t address, uint8_t& value) {
+            const uint8_t* page = bus.getConstantPage(static_cast<uint8_t>(address >> core::Bus::PAGE_SHIFT));
+            if (page)
+            {
+                value = page[address & core::Bus::PAGE_MASK];
+            }
+            return page != nullptr;
+        };
+
+        Instruction instruction{ nullptr, pc, {} };
+        if (!readConstant(pc, instruction.bytes[0]))
+        {
+            return nullptr;
+        }
+        const auto& info = decodeOpcode(static_cast<Opcode>(instruction.bytes[0]));
+        const uint8_t length = instructionLength(info.addressingMode);
+        for (uint8_t i = 1; i < length; ++i)
+        {
+            // Operands running into memory that may change are read through the bus every time
+            if (!readConstant(static_cast<uint16_t>(pc + i), instruction.bytes[i]))
+            {
+                return nullptr;
+            }
+        }
+        instruction.info = &info;
+
+        auto& page = _pages[pc >> core::Bus::PAGE_SHIFT];
+        if (!page)
+        {
+            page = std::make_unique<Page>();
+        }
+        auto& entry = (*page)[pc & core::Bus::PAGE_MASK];
+        entry = instruction;
+        _decodedCount++;
+        return &entry;
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "core/bus.h"
+#include "devices/W65C02S/opcodes.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace EaterEmulator::devices
+{
+    // Instructions decoded from constant bus pages (ROM), the first time each address is executed.
+    // Indexed like the bus page table, by page and then by the offset in the page, so handing out an
+    // instruction costs two loads. Pages are allocated on first use.
+    // Everything is dropped when the bus map generation changes, e.g. when a monitor is attached.
+    class DecodeCache
+    {
+    public:
+        struct Instruction
+        {
+            const OpcodeInfo* info; // nullptr until decoded
+            uint16_t address;
+            std::array<uint8_t, 3> bytes; // Opcode and operands, as many as the addressing mode takes
+        };
+
+        DecodeCache() = default;
+        // The cache is derived data, so copies start empty
+        DecodeCache(const DecodeCache&) {}
+        DecodeCache& operator=(const DecodeCache&) { clear(); return *this; }
+
+        // Instruction at pc, or nullptr if pc is not in constant memory
+        const Instruction* next(const core::Bus& bus, uint16_t pc)
+        {
+            if (const Page* page = _pages[pc >> core::Bus::PAGE_SHIFT].get(); page && bus.getMapGeneration() == _generation)
+            {
+                const Instruction& instruction = (*page)[pc & core::Bus::PAGE_MASK];
+                if (instruction.info)
+                {
+                    return &instruction;
+                }
+            }
+            return decode(bus, pc);
+        }
+
+        void clear();
+
+        // Addresses decoded since the last clear
+        size_t getDecodedCount() const { return _decodedCount; }
+
+    private:
+        using Page = std::array<Instruction, core::Bus::PAGE_SIZE>;
+
+        const Instruction* decode(const core::Bus& bus, uint16_t pc);
+
+        std::array<std::unique_ptr<Page>, core::Bus::PAGE_COUNT> _pages; // nullptr where nothing was decoded
+        uint64_t _generation = 0;
+        size_t _decodedCount = 0;
+    };
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+namespace EaterEmulator::devices
+{
+    // Status flags bits
+    static constexpr uint8_t STATUS_CARRY = 0x01; // Carry Flag
+    static constexpr uint8_t STATUS_ZERO = 0x02; // Zero Flag
+    static constexpr uint8_t STATUS_INTERRUPT = 0x04; // Interrupt Disable Flag
+    static constexpr uint8_t STATUS_DECIMAL = 0x08; // Decimal Mode Flag
+    static constexpr uint8_t STATUS_BREAK = 0x10; // Break Command Flag
+    static constexpr uint8_t STATUS_UNUSED = 0x20; // Unused Flag (always 1)
+    static constexpr uint8_t STATUS_OVERFLOW = 0x40; // Overflow Flag
+    static constexpr uint8_t STATUS_NEGATIVE = 0x80; // Negative Flag
+
+    // Processor status register with N and Z evaluated lazily. Nearly every instruction sets them and the
+    // next one usually overwrites them unread, so instead of the flags the register keeps the bytes they
+    // are derived from and only puts the status byte together when it is read.
+    class StatusRegister
+    {
+    public:
+        constexpr StatusRegister(uint8_t status = 0) { set(status); }
+
+        // The status byte as the CPU would push it
+        constexpr uint8_t get() const
+        {
+            return _flags | (_negative & STATUS_NEGATIVE) | (_zero == 0 ? STATUS_ZERO : 0);
+        }
+        constexpr void set(uint8_t status)
+        {
+            _flags = status & ~(STATUS_NEGATIVE | STATUS_ZERO);
+            _negative = status;
+            _zero = ~status & STATUS_ZERO;
+        }
+
+        // All flags but N and Z, which read as clear
+        constexpr uint8_t flags() const { return _flags; }
+        // N and Z are kept and any N or Z bit in flags is ignored
+        constexpr void setFlags(uint8_t flags) { _flags = flags & ~(STATUS_NEGATIVE | STATUS_ZERO); }
+        constexpr void setFlag(uint8_t flag) { _flags |= flag; }
+        constexpr void clearFlag(uint8_t flag) { _flags &= ~flag; }
+
+        // N and Z for a result byte
+        constexpr void setNZ(uint8_t value)
+        {
+            _negative = value;
+            _zero = value;
+        }
+        // N from bit 7 of one byte and Z from another, as BIT does
+        constexpr void setNZ(uint8_t negative, uint8_t zero)
+        {
+            _negative = negative;
+            _zero = zero;
+        }
+        // Z alone, N kept
+        constexpr void setZ(uint8_t zero) { _zero = zero; }
+
+        constexpr bool negative() const { return (_negative & STATUS_NEGATIVE) != 0; }
+        constexpr bool zero() const { return _zero == 0; }
+
+    private:
+        uint8_t _flags; // C, I, D, B, V and the unused bit
+        uint8_t _negative; // N is bit 7 of this byte
+        uint8_t _zero; // Z is set when this byte is zero
+    };
+}
@@ -1,6 +1,8 @@
 
 #include "devices/W65C02S/W65C02S.h"
 #include "core/defines.h"
+#include "core/trace.h"
+#include "devices/W65C02S/alu.h"
 #include "devices/W65C02S/opcodes.h"
 #include "spdlog/spdlog.h"
 
@@ -27,10 +29,65 @@ namespace EaterEmulator::devices
         _y = 0; // Y Register
         _sp = 0xFF; // Stack Pointer
         _pc = RESET_VECTOR; // Program Counter - Reset vector
-        _status = 0; // Processor Status
+        _status.set(0); // Processor Status
         _adl = 0; // Address Low Byte
         _adh = 0; // Address High Byte
+        _branchCycles = 0;
         _resetStage = 0;
+
+        std::lock_guard lock(_wakeup.mutex);
+        _runState = RunState::RUNNING;
+        _wakeup.condition.notify_all();
+    }
+
+    void W65C02S::saveState(core::StateWriter& writer) const
+    {
+        writer.write(_a);
+        writer.write(_x);
+        writer.write(_y);
+        writer.write(_sp);
+        writer.write(_pc);
+        writer.write(_status.get());
+        writer.write(_interruptVector);
+        writer.write(_interruptFromSW);
+        writer.write(static_cast<uint8_t>(_ir));
+        writer.write(_adl);
+        writer.write(_adh);
+        writer.write(_add);
+        writer.write(_irq.loadSources());
+        writer.write(_nmi.loadSources());
+        writer.write(static_cast<int32_t>(_cycle));
+        writer.write(_branchCycles);
+        writer.write(_cycleCount);
+        writer.write(_instructionCount);
+        writer.write(_started);
+        writer.write(_resetStage);
+        writer.write(static_cast<uint8_t>(_runState));
+    }
+
+    void W65C02S::loadState(core::StateReader& reader)
+    {
+        _a = reader.read<uint8_t>();
+        _x = reader.read<uint8_t>();
+        _y = reader.read<uint8_t>();
+        _sp = reader.read<uint8_t>();
+        _pc = reader.read<uint16_t>();
+        _status.set(reader.read<uint8_t>());
+        _interruptVector = reader.read<uint16_t>();
+        _interruptFromSW = reader.read<bool>();
+        _ir = static_cast<Opcode>(reader.read<uint8_t>());
+        _adl = reader.read<uint8_t>();
+        _adh = reader.read<uint8_t>();
+        _add = reader.read<uint8_t>();
+        _irq.storeSources(reader.read<uint8_t>());
+        _nmi.storeSources(reader.read<uint8_t>());
+        _cycle = reader.read<int32_t>();
+        _branchCycles = reader.read<uint8_t>();
+        _cycleCount = reader.read<uint64_t>();
+        _instructionCount = reader.read<uint64_t>();
+        _started = reader.read<bool>();
+        _resetStage = reader.read<uint8_t>();
+        _runState = static_cast<RunState>(reader.read<uint8_t>());
     }
 
     void W65C02S::onClockStateChange(core::State state)
@@ -43,27 +100,52 @@ namespace EaterEmulator::devices
         }
     }
 
-    void W65C02S::setIRQ(core::State state)
+    void W65C02S::setIRQ(core::State state, uint8_t source)
     {
-        _irq = state;
+        std::lock_guard lock(_wakeup.mutex);
+        _irq.set(state, source);
+        _wakeup.condition.notify_all();
     }
 
     void W65C02S::setNMI(core::State state)
     {
-        _nmi = state;
+        std::lock_guard lock(_wakeup.mutex);
+        _nmi.set(state, 0);
+        _wakeup.condition.notify_all();
     }
 
+    bool W65C02S::isHalted() const
+    {
+        return _runState == RunState::STOPPED
+            || (_runState == RunState::WAITING && _irq.load() == core::HIGH && _nmi.load() == core::HIGH);
+    }
 
-    void W65C02S::handlePhi2Low()
+    bool W65C02S::resume()
     {
-         // Based on IR, we need to get the addressing mode and handle
-        auto it = OpcodeMap.find(_ir);
-        if (it == OpcodeMap.end()) {
-            spdlog::error("Unknown opcode: {:#04x}", static_cast<int>(_ir));
-            return;
+        if (isHalted())
+        {
+            return false;
         }
-        const auto opcodeInfo = it->second;
-        const auto addressingMode = opcodeInfo.addressingMode;   
+        // WAI ends on either line, even a masked IRQ. That one is not taken, execution just continues.
+        _runState = RunState::RUNNING;
+        return true;
+    }
+
+    bool W65C02S::waitWhileIdle(std::stop_token stop)
+    {
+        // Only another thread can end the wait once no device event is pending
+        if (!isHalted() || (_runState == RunState::WAITING && !_bus->getScheduler().empty()))
+        {
+            return false;
+        }
+        std::unique_lock lock(_wakeup.mutex);
+        _wakeup.condition.wait(lock, stop, [this] { return !isHalted(); });
+        return true;
+    }
+
+
+    void W65C02S::handlePhi2Low()
+    {
         if (_cycle == 0)
         {
             _bus->setAddress(_pc);            
@@ -71,56 +153,15 @@ namespace EaterEmulator::devices
         }
         else
         {
-            bool handled = false;
-            switch (addressingMode)
+            // Based on IR, we need to get the addressing mode and handle
+            const auto& opcodeInfo = decodeOpcode(_ir);
+            if (_cycle == opcodeInfo.cycles && opcodeInfo.decimalCycles != 0)
             {
-                case AddressingMode::ACC:
-                    handled = handleAccumulatorAddressing(opcodeInfo, core::LOW);
-                    break;
-
-                case AddressingMode::IMP:
-                    handled = handleImpliedAddressing(opcodeInfo, core::LOW);
-                    break;
-                    
-                case AddressingMode::IMM:
-                    handled = handleImmediateAddressing(opcodeInfo, core::LOW);
-                    break;
-
-                case AddressingMode::ABS:
-                    handled = handleAbsoluteAddressing(opcodeInfo, core::LOW);
-                    break;
-                case AddressingMode::ABSX:
-                case AddressingMode::ABSY:
-                    handled = handleAbsoluteIndexedAddressing(opcodeInfo, core::LOW);
-                    break;
-
-                case AddressingMode::REL:
-                    handled = handleRelativeAddressing(opcodeInfo, core::LOW);
-                    break;
-
-                case AddressingMode::ZP:
-                    handled = handleZeroPageAddressing(opcodeInfo, core::LOW);
-                    break;
-                case AddressingMode::ZPX:
-                case AddressingMode::ZPY:
-                    handled = handleZeroPageIndexedAddressing(opcodeInfo, core::LOW);
-                    break;
-                case AddressingMode::IND:
-                    handled = handleIndirectAddressing(opcodeInfo, core::LOW);
-                    break;
-                case AddressingMode::INDX:
-                    handled = handleIndexedIndirectAddressing(opcodeInfo, core::LOW);
-                    break;
-                case AddressingMode::INDY:
-                    handled = handleIndirectIndexedAddressing(opcodeInfo, core::LOW);
-                    break;
-                default:
-                    handled = false;
-                    break;
+                return; // Decimal mode adjust cycle of ADC and SBC, nothing on the bus
             }
-            if (!handled)
+            if (!handleAddressingMode(opcodeInfo, core::LOW))
             {
-                spdlog::error("Unhandled addressing opcode: {:#04x}", static_cast<int>(opcodeInfo.opcode));
+                log().error("Unhandled addressing opcode: {:#04x}", static_cast<int>(opcodeInfo.opcode));
             }
         }
     }
@@ -131,6 +172,7 @@ namespace EaterEmulator::devices
         {
             return;
         }
+        _cycleCount++;
         bool inReset = _resetStage < 2;
         if (inReset)
         {
@@ -138,119 +180,152 @@ namespace EaterEmulator::devices
         }
         else if (_cycle == 0)
         {
-
-            // Check if interrupt (NMI) was requested
-            if (_nmi == core::LOW)
+            // Instruction boundary, _cycleCount already includes this opcode fetch
+            _bus->getScheduler().advance(_cycleCount - 1);
+            if (!resume())
             {
-                // Inject BRK to IR
-                _ir = Opcode::BRK;
-                // Set reset vector to NMI vector
-                _interruptVector = NMI_VECTOR;
+                return; // Held at the boundary by WAI or STP
             }
-            // Check if interrupt (IRQ) was requested and interrupt bit is cleared
-            else if (_irq == core::LOW && (_status & devices::STATUS_INTERRUPT) == 0)            
+            _branchCycles = 0;
+            if (!pollInterrupts())
             {
-                // Inject BRK to IR
-                // Set reset vector to IRQ vector
-                _interruptVector = IRQ_BRK_VECTOR;
-                _ir = Opcode::BRK;
-                _interruptFromSW = false;
-            }
-            else
-            {
-                // Set reset vector to IRQ vector (Same vector for BRK)
-                _interruptVector = IRQ_BRK_VECTOR;
-                _interruptFromSW = true;
                 uint8_t opcode = fetchByte();
                 _ir = static_cast<Opcode>(opcode); // Read the instruction from the data bus
                 _pc++;
+                _instructionCount++;
             }
             _cycle++;
+            if (_cycle == decodeOpcode(_ir).cycles)
+            {
+                _cycle = 0; // Single-cycle reserved NOP, done with the fetch
+            }
         }
         else
         {
-            auto it = OpcodeMap.find(_ir);
-            if (it == OpcodeMap.end()) {
-                spdlog::error("Unknown opcode: {:#04x}", static_cast<int>(_ir));
-                return;
-            }
-            const auto opcodeInfo = it->second;
-            const auto addressingMode = opcodeInfo.addressingMode;
-            bool handled = false;
-            switch (addressingMode)
+            const auto& opcodeInfo = decodeOpcode(_ir);
+            if (_cycle == opcodeInfo.cycles && opcodeInfo.decimalCycles != 0)
             {
-                case AddressingMode::ACC:
-                    handled = handleAccumulatorAddressing(opcodeInfo, core::HIGH);
-                    break;
-
-                case AddressingMode::IMP:
-                    handled = handleImpliedAddressing(opcodeInfo, core::HIGH);
-                    break;
-
-                case AddressingMode::IMM:
-                    handled = handleImmediateAddressing(opcodeInfo, core::HIGH);
-                    break;
-
-                case AddressingMode::ABS:
-                    handled = handleAbsoluteAddressing(opcodeInfo, core::HIGH);
-                    break;
-                case AddressingMode::ABSX:
-                case AddressingMode::ABSY:
-                    handled = handleAbsoluteIndexedAddressing(opcodeInfo, core::HIGH);
-                    break;
-
-                case AddressingMode::REL:
-                    handled = handleRelativeAddressing(opcodeInfo, core::HIGH);
-                    break;
-
-                case AddressingMode::ZP:
-                    handled = handleZeroPageAddressing(opcodeInfo, core::HIGH);
-                    break;
-                case AddressingMode::ZPX:
-                case AddressingMode::ZPY:
-                    handled = handleZeroPageIndexedAddressing(opcodeInfo, core::HIGH);
-                    break;
-                case AddressingMode::IND:
-                    handled = handleIndirectAddressing(opcodeInfo, core::HIGH);
-                    break;
-                case AddressingMode::INDX:
-                    handled = handleIndexedIndirectAddressing(opcodeInfo, core::HIGH);
-                    break;
-                case AddressingMode::INDY:
-                    handled = handleIndirectIndexedAddressing(opcodeInfo, core::HIGH);
-                    break;
-                default:
-                    handled = false;
-                    break;
+                _cycle = 0; // Decimal mode adjust cycle of ADC and SBC
+                return;
             }
-            if (!handled)
+            if (!handleAddressingMode(opcodeInfo, core::HIGH))
             {
-                spdlog::error("Unhandled addressing opcode: {:#04x}", static_cast<int>(opcodeInfo.opcode));
+                log().error("Unhandled addressing opcode: {:#04x}", static_cast<int>(opcodeInfo.opcode));
             }
             _cycle++;
-            if(_cycle == opcodeInfo.cycles)
+            if(_cycle == instructionCycles(opcodeInfo))
             {
                 _cycle = 0;
             }
         }
     }
 
+    bool W65C02S::handleAddressingMode(const OpcodeInfo& info, core::State clockState)
+    {
+        if (info.reserved)
+        {
+            return handleReservedNop(info, clockState);
+        }
+        switch (info.addressingMode)
+        {
+            case AddressingMode::ACC:
+                return handleAccumulatorAddressing(info, clockState);
+
+            case AddressingMode::IMP:
+                return handleImpliedAddressing(info, clockState);
+            case AddressingMode::IMM:
+                return handleImmediateAddressing(info, clockState);
+
+            case AddressingMode::ABS:
+                return handleAbsoluteAddressing(info, clockState);
+            case AddressingMode::ABSX:
+            case AddressingMode::ABSY:
+                return handleAbsoluteIndexedAddressing(info, clockState);
+
+            case AddressingMode::REL:
+                return handleRelativeAddressing(info, clockState);
+
+            case AddressingMode::ZP:
+                return handleZeroPageAddressing(info, clockState);
+            case AddressingMode::ZPX:
+            case AddressingMode::ZPY:
+                return handleZeroPageIndexedAddressing(info, clockState);
+            case AddressingMode::IND:
+                return handleIndirectAddressing(info, clockState);
+            case AddressingMode::INDX:
+                return handleIndexedIndirectAddressing(info, clockState);
+            case AddressingMode::INDY:
+            case AddressingMode::ZPI:
+                return handleIndirectIndexedAddressing(info, clockState);
+            case AddressingMode::IAX:
+                return handleAbsoluteIndexedIndirectAddressing(info, clockState);
+            case AddressingMode::ZPR:
+                return handleZeroPageRelativeAddressing(info, clockState);
+            default:
+                return false;
+        }
+    }
+
+    bool W65C02S::pollInterrupts()
+    {
+        // Check if interrupt (NMI) was requested
+        if (_nmi.load() == core::LOW)
+        {
+            // Inject BRK to IR
+            _ir = Opcode::BRK;
+            // Set reset vector to NMI vector
+            _interruptVector = NMI_VECTOR;
+            return true;
+        }
+        // Check if interrupt (IRQ) was requested and interrupt bit is cleared
+        if (_irq.load() == core::LOW && (_status.flags() & devices::STATUS_INTERRUPT) == 0)
+        {
+            // Inject BRK to IR
+            // Set reset vector to IRQ vector
+            _interruptVector = IRQ_BRK_VECTOR;
+            _ir = Opcode::BRK;
+            _interruptFromSW = false;
+            return true;
+        }
+        // Set reset vector to IRQ vector (Same vector for BRK)
+        _interruptVector = IRQ_BRK_VECTOR;
+        _interruptFromSW = true;
+        return false;
+    }
+
+    bool W65C02S::isBranchTaken(Opcode opcode) const
+    {
+        switch (opcode)
+        {
+            case Opcode::BEQ: return _status.zero();
+            case Opcode::BNE: return !_status.zero();
+            case Opcode::BMI: return _status.negative();
+            case Opcode::BPL: return !_status.negative();
+            case Opcode::BCS: return (_status.flags() & STATUS_CARRY) != 0;
+            case Opcode::BCC: return (_status.flags() & STATUS_CARRY) == 0;
+            case Opcode::BVS: return (_status.flags() & STATUS_OVERFLOW) != 0;
+            case Opcode::BVC: return (_status.flags() & STATUS_OVERFLOW) == 0;
+            case Opcode::BRA: return true;
+            default: return false;
+        }
+    }
+
     void W65C02S::handleReset()
     {
         if (_resetStage == 0)
         {
             _adl = fetchByte(); // Read low byte of reset vector
-            spdlog::debug("CPU: Read reset vector low byte: {:#04x}", _adl);
+            EATER_TRACE("CPU: Read reset vector low byte: {:#04x}", _adl);
             _resetStage++;
             _pc++;
         }
         else
         {
             _adh = fetchByte(); // Read high byte of reset vector
-            spdlog::debug("CPU: Read reset vector high byte: {:#04x}", _adh);
+            EATER_TRACE("CPU: Read reset vector high byte: {:#04x}", _adh);
             _resetStage++;
             _pc = (_adh << 8) | _adl; // Set program counter to reset vector
-            spdlog::debug("CPU: Reset complete, PC set to {:#04x}", _pc);
+            EATER_TRACE("CPU: Reset complete, PC set to {:#04x}", _pc);
         }
     }
     bool W65C02S::handleAccumulatorAddressing(const OpcodeInfo& info, core::State clockState)
@@ -296,7 +371,7 @@ namespace EaterEmulator::devices
         }
         else
         {
-            spdlog::error("Unhandled cycle in accumulator high addressing: {}", _cycle);
+            log().error("Unhandled cycle in accumulator high addressing: {}", _cycle);
             return false;
         }
         return false;
@@ -358,7 +433,7 @@ namespace EaterEmulator::devices
         }
         else
         {
-            spdlog::error("Unhandled cycle in implied low addressing: {}", _cycle);
+            log().error("Unhandled cycle in implied low addressing: {}", _cycle);
             return false;
         }
         return false;
@@ -374,65 +449,72 @@ namespace EaterEmulator::devices
                 case Opcode::NOP:
                     break;
                 case Opcode::CLC:
-                    _status &= ~devices::STATUS_CARRY; // Clear carry flag
+                    _status.clearFlag(devices::STATUS_CARRY); // Clear carry flag
                     break;
                 case Opcode::SEC:
-                    _status |= devices::STATUS_CARRY; // Set carry flag
+                    _status.setFlag(devices::STATUS_CARRY); // Set carry flag
                     break;
                 case Opcode::CLI:
-                    _status &= ~devices::STATUS_INTERRUPT; // Clear interrupt disable flag
+                    _status.clearFlag(devices::STATUS_INTERRUPT); // Clear interrupt disable flag
                     break;
                 case Opcode::SEI:
-                    _status |= devices::STATUS_INTERRUPT; // Set interrupt disable flag
+                    _status.setFlag(devices::STATUS_INTERRUPT); // Set interrupt disable flag
                     break;
                 case Opcode::CLV:
-                    _status &= ~devices::STATUS_OVERFLOW; // Clear overflow flag
+                    _status.clearFlag(devices::STATUS_OVERFLOW); // Clear overflow flag
                     break;
                 case Opcode::CLD:
-                    _status &= ~devices::STATUS_DECIMAL; // Clear decimal mode flag
+                    _status.clearFlag(devices::STATUS_DECIMAL); // Clear decimal mode flag
                     break;
                 case Opcode::SED:
-                    _status |= devices::STATUS_DECIMAL; // Set decimal mode flag
+                    _status.setFlag(devices::STATUS_DECIMAL); // Set decimal mode flag
                     break;
 
                 case Opcode::TAX:
                     _x = _a;
-                    updateStatusFlags(_x);
+                    _status.setNZ(_x);
                     break;
                 case Opcode::TXA:
                     _a = _x;
-                    updateStatusFlags(_a);
+                    _status.setNZ(_a);
                     break;
                 case Opcode::TAY:
                     _y = _a;
-                    updateStatusFlags(_y);
+                    _status.setNZ(_y);
                     break;
                 case Opcode::TYA:
                     _a = _y;
-                    updateStatusFlags(_a);
+                    _status.setNZ(_a);
                     break;
                 case Opcode::TXS:
                     _sp = _x;
                     break;
                 case Opcode::TSX:
                     _x = _sp;
-                    updateStatusFlags(_x);
+                    _status.setNZ(_x);
                     break;
                 case Opcode::INX:
                     _x++;
-                    updateStatusFlags(_x);
+                    _status.setNZ(_x);
                     break;
                 case Opcode::DEX:
                     _x--;
-                    updateStatusFlags(_x);
+                    _status.setNZ(_x);
                     break;                
                 case Opcode::INY:
                     _y++;
-                    updateStatusFlags(_y);
+                    _status.setNZ(_y);
                     break;
                 case Opcode::DEY:
                     _y--;
-                    updateStatusFlags(_y);
+                    _status.setNZ(_y);
+                    break;
+
+                case Opcode::WAI:
+                    _runState = RunState::WAITING;
+                    break;
+                case Opcode::STP:
+                    _runState = RunState::STOPPED;
                     break;
                 
                 default:
@@ -453,14 +535,24 @@ namespace EaterEmulator::devices
                     writeByte(_a); // Push accumulator to stack
                     _sp--;
                     break;
+                case Opcode::PHX:
+                    writeByte(_x);
+                    _sp--;
+                    break;
+                case Opcode::PHY:
+                    writeByte(_y);
+                    _sp--;
+                    break;
                 case Opcode::PLA:
+                case Opcode::PLX:
+                case Opcode::PLY:
                 case Opcode::PLP:
                 case Opcode::RTS:
                 case Opcode::RTI:
                     _sp++;
                     break;
                 case Opcode::PHP:
-                    writeByte(_status);
+                    writeByte(_status.get());
                     _sp--;
                     break;
                 default:
@@ -479,18 +571,25 @@ namespace EaterEmulator::devices
                     break;
                 case Opcode::PLA:
                     _a = fetchByte(); // Pull accumulator from stack
-                    updateStatusFlags(_a);
+                    _status.setNZ(_a);
+                    break;
+                case Opcode::PLX:
+                    _x = fetchByte();
+                    _status.setNZ(_x);
+                    break;
+                case Opcode::PLY:
+                    _y = fetchByte();
+                    _status.setNZ(_y);
                     break;
                 case Opcode::PLP:
-                    _status = fetchByte(); // Pull status from stack
-                    _status &= ~devices::STATUS_BREAK; // Clear break flag
+                    _status.set(fetchByte() & ~devices::STATUS_BREAK); // Pull status from stack, break flag cleared
                     break;
                 case Opcode::RTS:
                     _adl = fetchByte();
                     _sp++;
                     break;
                 case Opcode::RTI:
-                    _status = fetchByte();
+                    _status.set(fetchByte());
                     _sp++;
                     break;
                 default:
@@ -504,7 +603,7 @@ namespace EaterEmulator::devices
             {
                 case Opcode::BRK:
                     {
-                        auto status = _interruptFromSW ? _status | devices::STATUS_BREAK : _status;
+                        auto status = _interruptFromSW ? _status.get() | devices::STATUS_BREAK : _status.get();
                         writeByte(status); // Push status register
                         _sp--;
                     }
@@ -547,7 +646,7 @@ namespace EaterEmulator::devices
                     _pc = (fetchByte() << 8) | _adl;
                     if (_interruptVector == IRQ_BRK_VECTOR)
                     {
-                        _status |= devices::STATUS_INTERRUPT;
+                        _status.setFlag(devices::STATUS_INTERRUPT);
                     }
                     break;
                 default:
@@ -557,7 +656,7 @@ namespace EaterEmulator::devices
         }
         else
         {
-            spdlog::error("Unhandled cycle in implied low addressing: {}", _cycle);
+            log().error("Unhandled cycle in implied low addressing: {}", _cycle);
             return false;
         }
         return false;  
@@ -591,15 +690,15 @@ namespace EaterEmulator::devices
             {
                 case Opcode::LDA_IMM:
                     _a = fetchByte();
-                    updateStatusFlags(_a);
+                    _status.setNZ(_a);
                     break;
                 case Opcode::LDX_IMM:
                     _x = fetchByte();
-                    updateStatusFlags(_x);
+                    _status.setNZ(_x);
                     break;
                 case Opcode::LDY_IMM:
                     _y = fetchByte();
-                    updateStatusFlags(_y);
+                    _status.setNZ(_y);
                     break;
                 case Opcode::AND_IMM:
                     doAND();
@@ -621,6 +720,9 @@ namespace EaterEmulator::devices
                 case Opcode::CPY_IMM:
                     doCMP();
                     break;
+                case Opcode::BIT_IMM:
+                    doBIT();
+                    break;
                 default:
                     return false;
             }
@@ -719,17 +821,17 @@ namespace EaterEmulator::devices
                 case Opcode::LDA_ABSX:
                 case Opcode::LDA_ABSY:
                     _a = fetchByte();
-                    updateStatusFlags(_a);
+                    _status.setNZ(_a);
                     break;
                 case Opcode::LDX_ABS:
                 case Opcode::LDX_ABSY:
                     _x = fetchByte();
-                    updateStatusFlags(_x);
+                    _status.setNZ(_x);
                     break;
                 case Opcode::LDY_ABS:
                 case Opcode::LDY_ABSX:
                     _y = fetchByte();
-                    updateStatusFlags(_y);
+                    _status.setNZ(_y);
                     break;
                 case Opcode::AND_ABS:
                 case Opcode::AND_ABSX:
@@ -765,8 +867,15 @@ namespace EaterEmulator::devices
                     break;
 
                 case Opcode::BIT_ABS:
+                case Opcode::BIT_ABSX:
                     doBIT();
                     break;
+                case Opcode::TRB_ABS:
+                    doTRB();
+                    break;
+                case Opcode::TSB_ABS:
+                    doTSB();
+                    break;
 
                 case Opcode::ASL_ABS:
                 case Opcode::ASL_ABSX:
@@ -806,6 +915,10 @@ namespace EaterEmulator::devices
                 case Opcode::STY_ABS:
                     writeByte(_y);
                     break;
+                case Opcode::STZ_ABS:
+                case Opcode::STZ_ABSX:
+                    writeByte(0);
+                    break;
 
                 default:
                     break;
@@ -872,7 +985,7 @@ namespace EaterEmulator::devices
         else
         {
             // TODO: Handle page crossing
-            spdlog::error("Unhandled cycle {} for ABS Indexed low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            log().error("Unhandled cycle {} for ABS Indexed low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
             return false;
         }
         return true;
@@ -902,88 +1015,22 @@ namespace EaterEmulator::devices
         {
             _adl = fetchByte();
             _pc++;
+            if (isBranchTaken(info.opcode))
+            {
+                _branchCycles = branchTakenCycles(_pc, _pc + static_cast<int8_t>(_adl));
+            }
         }
         else if (_cycle == 2)
         {
-            bool isZero = _status & devices::STATUS_ZERO;
-            bool isNegative = _status & devices::STATUS_NEGATIVE;
-            bool isCarry = _status & devices::STATUS_CARRY;
-            bool isOverflow = _status & devices::STATUS_OVERFLOW;
-            switch (info.opcode)
-            {
-                case Opcode::BEQ:
-                    if (isZero)
-                    {
-                        _pc += static_cast<int8_t>(_adl);
-                    }
-                    break;
-                case Opcode::BNE:
-                    if (!isZero)
-                    {
-                        _pc += static_cast<int8_t>(_adl);
-                    }
-                    break;
-                case Opcode::BPL:
-                    if (!isNegative)
-                    {
-                        _pc += static_cast<int8_t>(_adl);
-                    }
-                    break;
-                case Opcode::BMI:
-                    if (isNegative)
-                    {
-                        _pc += static_cast<int8_t>(_adl);
-                    }
-                    break;
-                case Opcode::BCS:
-                    if (isCarry)
-                    {
-                        _pc += static_cast<int8_t>(_adl);
-                    }
-                    break;
-                case Opcode::BCC:
-                    if (!isCarry)
-                    {
-                        _pc += static_cast<int8_t>(_adl);
-                    }
-                    break;
-                case Opcode::BVS:
-                    if (!isOverflow)
-                    {
-                        _pc += static_cast<int8_t>(_adl);
-                    }
-                    break;
-                case Opcode::BVC:
-                    if (!isOverflow)
-                    {
-                        _pc += static_cast<int8_t>(_adl);
-                    }
-                    break;
-                default:
-                    break;
-            }
+            _pc += static_cast<int8_t>(_adl); // Taken
         }
         else if (_cycle == 3)
         {
-            switch (info.opcode)
-            {
-                case Opcode::BEQ:
-                case Opcode::BNE:
-                case Opcode::BPL:
-                case Opcode::BMI:
-                case Opcode::BCS:
-                case Opcode::BCC:
-                case Opcode::BVS:
-                case Opcode::BVC:
-                    // _pc++;
-                    break;
-                default:
-                    return true;
-            }
+            // Taken to another page, fixing up the high byte
         }
         else
         {
-            spdlog::error("Unhandled cycle {} for relative addressing, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            log().error("Unhandled cycle {} for relative addressing, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
             return false;
         }
         return true;
@@ -1020,7 +1067,7 @@ namespace EaterEmulator::devices
         }
         else
         {
-            spdlog::error("Unhandled cycle {} for ZP low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            log().error("Unhandled cycle {} for ZP low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
             return false;
         }
         return true;
@@ -1039,15 +1086,15 @@ namespace EaterEmulator::devices
                 // Read instructions
                 case Opcode::LDA_ZP:
                     _a = fetchByte();
-                    updateStatusFlags(_a);
+                    _status.setNZ(_a);
                     break;
                 case Opcode::LDX_ZP:
                     _x = fetchByte();
-                    updateStatusFlags(_x);
+                    _status.setNZ(_x);
                     break;
                 case Opcode::LDY_ZP:
                     _y = fetchByte();
-                    updateStatusFlags(_y);
+                    _status.setNZ(_y);
                     break;
                 case Opcode::AND_ZP:
                     doAND();
@@ -1073,6 +1120,32 @@ namespace EaterEmulator::devices
                 case Opcode::BIT_ZP:
                     doBIT();
                     break;
+                case Opcode::TRB_ZP:
+                    doTRB();
+                    break;
+                case Opcode::TSB_ZP:
+                    doTSB();
+                    break;
+                case Opcode::RMB0:
+                case Opcode::RMB1:
+                case Opcode::RMB2:
+                case Opcode::RMB3:
+                case Opcode::RMB4:
+                case Opcode::RMB5:
+                case Opcode::RMB6:
+                case Opcode::RMB7:
+                    doRMB();
+                    break;
+                case Opcode::SMB0:
+                case Opcode::SMB1:
+                case Opcode::SMB2:
+                case Opcode::SMB3:
+                case Opcode::SMB4:
+                case Opcode::SMB5:
+                case Opcode::SMB6:
+                case Opcode::SMB7:
+                    doSMB();
+                    break;
                 case Opcode::ASL_ZP:
                     doASL(false);
                     break;
@@ -1086,11 +1159,9 @@ namespace EaterEmulator::devices
                     doROR(false);
                     break;
                 case Opcode::INC_ZP:
-                case Opcode::INC_ZPX:
                     doINC(false);
                     break;
                 case Opcode::DEC_ZP:
-                case Opcode::DEC_ZPX:
                     doDEC(false);
                     break;
 
@@ -1105,8 +1176,11 @@ namespace EaterEmulator::devices
                 case Opcode::STY_ZP:
                     writeByte(_y);
                     break;
+                case Opcode::STZ_ZP:
+                    writeByte(0);
+                    break;
                 default:                    
-                    spdlog::error("Unhandled opcode for ZP high clock, opcode: {:#04x}", static_cast<int>(info.opcode));
+                    log().error("Unhandled opcode for ZP high clock, opcode: {:#04x}", static_cast<int>(info.opcode));
                     return false;
             }
         }
@@ -1120,7 +1194,7 @@ namespace EaterEmulator::devices
         }
         else
         {
-            spdlog::error("Unhandled cycle {} for ZP high clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            log().error("Unhandled cycle {} for ZP high clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
             return false;
         }
         return true;
@@ -1152,7 +1226,7 @@ namespace EaterEmulator::devices
             }
             else
             {
-                spdlog::error("Unhandled cycle {} for ZP indexed low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+                log().error("Unhandled cycle {} for ZP indexed low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
                 return false;
             }
             return true;
@@ -1176,15 +1250,15 @@ namespace EaterEmulator::devices
                 // Read instructions
                 case Opcode::LDA_ZPX:
                     _a = fetchByte();
-                    updateStatusFlags(_a);
+                    _status.setNZ(_a);
                     break;
                 case Opcode::LDX_ZPY:
                     _x = fetchByte();
-                    updateStatusFlags(_x);
+                    _status.setNZ(_x);
                     break;
                 case Opcode::LDY_ZPX:
                     _y = fetchByte();
-                    updateStatusFlags(_y);
+                    _status.setNZ(_y);
                     break;
 
                 case Opcode::AND_ZPX:
@@ -1205,6 +1279,9 @@ namespace EaterEmulator::devices
                 case Opcode::CMP_ZPX:
                     doCMP();
                     break;
+                case Opcode::BIT_ZPX:
+                    doBIT();
+                    break;
                     
                 case Opcode::ASL_ZPX:
                     doASL(false);
@@ -1218,6 +1295,12 @@ namespace EaterEmulator::devices
                 case Opcode::ROR_ZPX:
                     doROR(false);
                     break;
+                case Opcode::INC_ZPX:
+                    doINC(false);
+                    break;
+                case Opcode::DEC_ZPX:
+                    doDEC(false);
+                    break;
 
                 // Read-modify-write instructions
                 // Write instructions
@@ -1230,8 +1313,11 @@ namespace EaterEmulator::devices
                 case Opcode::STY_ZPX:
                     writeByte(_y);
                     break;
+                case Opcode::STZ_ZPX:
+                    writeByte(0);
+                    break;
                 default:                    
-                    spdlog::error("Unhandled opcode for ZP indexed high clock, opcode: {:#04x}", static_cast<int>(info.opcode));
+                    log().error("Unhandled opcode for ZP indexed high clock, opcode: {:#04x}", static_cast<int>(info.opcode));
                     return false;
             }
         }
@@ -1241,7 +1327,7 @@ namespace EaterEmulator::devices
         }
         else
         {
-            spdlog::error("Unhandled cycle {} for ZP indexed high, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            log().error("Unhandled cycle {} for ZP indexed high, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
             return false;
         }
         return true;
@@ -1263,9 +1349,9 @@ namespace EaterEmulator::devices
         } else if (_cycle == 3) {
             _bus->setAddress(((_adh << 8) | _adl));
         } else if (_cycle == 4) {
-            _bus->setAddress(((_adh << 8) | (_adl + 1)));
+            _bus->setAddress(((_adh << 8) | _adl) + 1);
         } else {
-            spdlog::error("Unhandled cycle {} for indirect indexed low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            log().error("Unhandled cycle {} for indirect indexed low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
             return false;
         }
         return true;
@@ -1284,11 +1370,11 @@ namespace EaterEmulator::devices
                     _pc = (fetchByte() << 8) | _add;                
                     break;
                 default:
-                    spdlog::error("Unhandled opcode for IND high clock, opcode: {:#04x}", static_cast<int>(info.opcode));
+                    log().error("Unhandled opcode for IND high clock, opcode: {:#04x}", static_cast<int>(info.opcode));
                     return false;
             }
         } else {
-            spdlog::error("Unhandled cycle {} for IND high clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            log().error("Unhandled cycle {} for IND high clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
             return false;
         }
         return true;                    
@@ -1309,13 +1395,13 @@ namespace EaterEmulator::devices
         } else if (_cycle == 2) {
             _bus->setAddress(_add);
         } else if (_cycle == 3) {
-            _bus->setAddress(_add + 1);
+            _bus->setAddress(static_cast<uint8_t>(_add + 1));
         } else if (_cycle == 4) {
             _bus->setAddress(((_adh << 8) | _adl));
         } else if (_cycle == 5) {
             // Do nothing
         } else {
-            spdlog::error("Unhandled cycle {} for indirect indexed low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            log().error("Unhandled cycle {} for indirect indexed low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
             return false;
         }
         return true;
@@ -1332,7 +1418,7 @@ namespace EaterEmulator::devices
             switch (info.opcode) {
                 case Opcode::LDA_INDX:
                     _a = fetchByte();
-                    updateStatusFlags(_a);
+                    _status.setNZ(_a);
                     break;
                 case Opcode::AND_INDX:
                     doAND();
@@ -1356,13 +1442,13 @@ namespace EaterEmulator::devices
                     writeByte(_a);
                     break;
                 default:
-                    spdlog::error("Unhandled opcode for indirect indexed high clock, opcode: {:#04x}", static_cast<int>(info.opcode));
+                    log().error("Unhandled opcode for indirect indexed high clock, opcode: {:#04x}", static_cast<int>(info.opcode));
                     return false;
             }
         } else if (_cycle == 5) {
             // Do nothing
         } else {
-            spdlog::error("Unhandled cycle {} for indirect indexed high clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            log().error("Unhandled cycle {} for indirect indexed high clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
             return false;
         }
         return true;
@@ -1384,13 +1470,13 @@ namespace EaterEmulator::devices
         } else if (_cycle == 2) {
             _bus->setAddress(_add);
         } else if (_cycle == 3) {
-            _bus->setAddress(_add + 1);
+            _bus->setAddress(static_cast<uint8_t>(_add + 1));
         } else if (_cycle == 4) {
             _bus->setAddress(((_adh << 8) | _adl));
         } else if (_cycle == 5) {
             // Do nothing
         } else {
-            spdlog::error("Unhandled cycle {} for indirect indexed low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            log().error("Unhandled cycle {} for indirect indexed low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
             return false;
         }
         return true;
@@ -1401,87 +1487,248 @@ namespace EaterEmulator::devices
         if (_cycle == 1) {
             _add = fetchByte();
         } else if (_cycle == 2) {
-            _adl = fetchByte() + _y;
+            uint16_t low = fetchByte() + (info.addressingMode == AddressingMode::INDY ? _y : 0);
+            _adl = static_cast<uint8_t>(low);
+            _adh = static_cast<uint8_t>(low >> 8); // Carry into the high byte of the pointer
         } else if (_cycle == 3) {
-            _adh = fetchByte();
+            _adh += fetchByte();
         } else if (_cycle == 4) {
             switch (info.opcode) {
                 case Opcode::LDA_INDY:
+                case Opcode::LDA_ZPI:
                     _a = fetchByte();
-                    updateStatusFlags(_a);
+                    _status.setNZ(_a);
                     break;
                 case Opcode::AND_INDY:
+                case Opcode::AND_ZPI:
                     doAND();
                     break;
                 case Opcode::ORA_INDY:
+                case Opcode::ORA_ZPI:
                     doORA();
                     break;
                 case Opcode::EOR_INDY:
+                case Opcode::EOR_ZPI:
                     doEOR();
                     break;
                 case Opcode::ADC_INDY:
+                case Opcode::ADC_ZPI:
                     doADC();
                     break;
                 case Opcode::SBC_INDY:
+                case Opcode::SBC_ZPI:
                     doSBC();
                     break;
                 case Opcode::CMP_INDY:
+                case Opcode::CMP_ZPI:
                     doCMP();
                     break;
                 case Opcode::STA_INDY:
+                case Opcode::STA_ZPI:
                     writeByte(_a);
                     break;
                 default:
-                    spdlog::error("Unhandled opcode for indirect indexed high clock, opcode: {:#04x}", static_cast<int>(info.opcode));
+                    log().error("Unhandled opcode for indirect indexed high clock, opcode: {:#04x}", static_cast<int>(info.opcode));
                     return false;
             }
         } else if (_cycle == 5) {
             // Do nothing
         } else {
-            spdlog::error("Unhandled cycle {} for indirect indexed high clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            log().error("Unhandled cycle {} for indirect indexed high clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            return false;
+        }
+        return true;
+    }
+
+    bool W65C02S::handleAbsoluteIndexedIndirectAddressing(const OpcodeInfo& info, core::State clockState)
+    {
+        if (clockState == core::LOW)
+        {
+            return handleAbsoluteIndexedIndirectLow(info);
+        }
+        return handleAbsoluteIndexedIndirectHigh(info);
+    }
+
+    bool W65C02S::handleAbsoluteIndexedIndirectLow(const OpcodeInfo& info)
+    {
+        if (_cycle == 1) {
+            _bus->setAddress(_pc++);
+        } else if (_cycle == 2) {
+            _bus->setAddress(_pc++);
+        } else if (_cycle == 3) {
+            // Internal operation, X is added to the pointer
+        } else if (_cycle == 4) {
+            _bus->setAddress(((_adh << 8) | _adl) + _x);
+        } else if (_cycle == 5) {
+            _bus->setAddress(((_adh << 8) | _adl) + _x + 1);
+        } else {
+            log().error("Unhandled cycle {} for absolute indexed indirect low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            return false;
+        }
+        return true;
+    }
+
+    bool W65C02S::handleAbsoluteIndexedIndirectHigh(const OpcodeInfo& info)
+    {
+        if (_cycle == 1) {
+            _adl = fetchByte();
+        } else if (_cycle == 2) {
+            _adh = fetchByte();
+        } else if (_cycle == 3) {
+            // Internal operation
+        } else if (_cycle == 4) {
+            _add = fetchByte();
+        } else if (_cycle == 5) {
+            switch (info.opcode) {
+                case Opcode::JMP_IAX:
+                    _pc = (fetchByte() << 8) | _add;
+                    break;
+                default:
+                    log().error("Unhandled opcode for absolute indexed indirect high clock, opcode: {:#04x}", static_cast<int>(info.opcode));
+                    return false;
+            }
+        } else {
+            log().error("Unhandled cycle {} for absolute indexed indirect high clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            return false;
+        }
+        return true;
+    }
+
+    bool W65C02S::handleZeroPageRelativeAddressing(const OpcodeInfo& info, core::State clockState)
+    {
+        if (clockState == core::LOW)
+        {
+            return handleZeroPageRelativeLow(info);
+        }
+        return handleZeroPageRelativeHigh(info);
+    }
+
+    bool W65C02S::handleZeroPageRelativeLow(const OpcodeInfo& info)
+    {
+        if (_cycle == 1) {
+            // fetch zero page address
+            _bus->setAddress(_pc++);
+        } else if (_cycle == 2) {
+            // read the byte holding the tested bit
+            _bus->setAddress(_adl);
+        } else if (_cycle == 3) {
+            // fetch branch offset
+            _bus->setAddress(_pc++);
+        } else if (_cycle >= 4 && _cycle <= 6) {
+            _bus->setAddress(_pc);
+        } else {
+            log().error("Unhandled cycle {} for ZP relative low clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
             return false;
         }
         return true;
     }
 
+    bool W65C02S::handleZeroPageRelativeHigh(const OpcodeInfo& info)
+    {
+        if (_cycle == 1) {
+            _adl = fetchByte();
+        } else if (_cycle == 2) {
+            _add = fetchByte();
+        } else if (_cycle == 3) {
+            _adh = fetchByte();
+            if (isBitBranchTaken(_add))
+            {
+                _branchCycles = branchTakenCycles(_pc, _pc + static_cast<int8_t>(_adh));
+            }
+        } else if (_cycle == 4) {
+            // Testing the bit
+        } else if (_cycle == 5) {
+            _pc += static_cast<int8_t>(_adh); // Taken
+        } else if (_cycle == 6) {
+            // Taken to another page, fixing up the high byte
+        } else {
+            log().error("Unhandled cycle {} for ZP relative high clock, opcode: {:#04x}", _cycle, static_cast<int>(info.opcode));
+            return false;
+        }
+        return true;
+    }
+
+    bool W65C02S::handleReservedNop(const OpcodeInfo& info, core::State clockState)
+    {
+        // The operand bytes are fetched, then the zero page and absolute forms read the address they name
+        // on their last cycle. 5C reads nothing more, ZP,X spends its second cycle adding X.
+        const bool readsAddress = info.addressingMode != AddressingMode::IMM && static_cast<uint8_t>(info.opcode) != 0x5C;
+        if (_cycle < instructionLength(info.addressingMode))
+        {
+            if (clockState == core::LOW)
+            {
+                _bus->setAddress(_pc++);
+            }
+            else if (info.addressingMode == AddressingMode::IMM)
+            {
+                fetchByte();
+            }
+            else if (_cycle == 1)
+            {
+                _adl = fetchByte();
+            }
+            else
+            {
+                _adh = fetchByte();
+            }
+        }
+        else if (_cycle == info.cycles - 1 && readsAddress)
+        {
+            if (clockState == core::LOW)
+            {
+                switch (info.addressingMode)
+                {
+                    case AddressingMode::ZP:
+                        _bus->setAddress(_adl);
+                        break;
+                    case AddressingMode::ZPX:
+                        _bus->setAddress(_adh);
+                        break;
+                    default:
+                        _bus->setAddress((_adh << 8) | _adl);
+                        break;
+                }
+            }
+            else
+            {
+                fetchByte();
+            }
+        }
+        else if (clockState == core::HIGH && info.addressingMode == AddressingMode::ZPX)
+        {
+            _adh = _adl + _x;
+        }
+        return true;
+    }
+
     void W65C02S::doAND()
     {
         _a &= fetchByte();
-        updateStatusFlags(_a);
+        _status.setNZ(_a);
     }
     void W65C02S::doORA()
     {
         _a |= fetchByte();
-        updateStatusFlags(_a);
+        _status.setNZ(_a);
     }
     void W65C02S::doEOR()
     {
         _a ^= fetchByte();
-        updateStatusFlags(_a);
+        _status.setNZ(_a);
     }
     void W65C02S::doADC()
     {
-        uint8_t operand = fetchByte();
-        uint16_t result = static_cast<uint16_t>(_a) + static_cast<uint16_t>(operand) + static_cast<uint16_t>(_status & STATUS_CARRY);
-        _a = static_cast<uint8_t>(result);
-        if (result > 0xFF) {
-            _status |= STATUS_CARRY; // Set carry flag if overflow
-        } else {
-            _status &= ~STATUS_CARRY;
-        }
-        updateStatusFlags(_a);
+        const auto result = alu::adc(_a, fetchByte(), _status.flags());
+        _a = result.value;
+        _status.setFlags(result.status);
+        _status.setNZ(_a);
     }
     void W65C02S::doSBC()
     {
-        uint8_t operand = fetchByte();
-        uint16_t result = static_cast<uint16_t>(_a) - static_cast<uint16_t>(operand) - (1 - static_cast<uint16_t>(_status & STATUS_CARRY));
-        _a = static_cast<uint8_t>(result);
-        if (result > 0xFF) {
-            _status &= ~STATUS_CARRY; // Clear carry flag if overflow
-        } else {
-            _status |= STATUS_CARRY;
-        }
-        updateStatusFlags(_a);
+        const auto result = alu::sbc(_a, fetchByte(), _status.flags());
+        _a = result.value;
+        _status.setFlags(result.status);
+        _status.setNZ(_a);
     }
 
     void W65C02S::doCMP()
@@ -1502,145 +1749,107 @@ namespace EaterEmulator::devices
             default:
                 break;
         }
-        uint8_t operand = fetchByte();
-        uint16_t result = static_cast<uint16_t>(*reg) - static_cast<uint16_t>(operand);
-        if (result > 0xFF) {
-            _status &= ~STATUS_CARRY; // Clear carry flag if overflow
-        } else {
-            _status |= STATUS_CARRY;
-        }
-        updateStatusFlags(static_cast<uint8_t>(result));
+        const auto result = alu::compare(*reg, fetchByte(), _status.flags());
+        _status.setFlags(result.status);
+        _status.setNZ(result.value);
     }
 
     void W65C02S::doBIT()
     {
         uint8_t value = fetchByte();
-        _status &= ~(STATUS_OVERFLOW | STATUS_ZERO | STATUS_NEGATIVE);
-        _status |= (value & 0x40) ? STATUS_OVERFLOW : 0;
-        _status |= (value & 0x80) ? STATUS_NEGATIVE : 0;
-        if ((value & _a) == 0) {
-            _status |= STATUS_ZERO;
+        if (_ir == Opcode::BIT_IMM)
+        {
+            // The immediate form only sets Z
+            _status.setZ(_a & value);
+            return;
         }
-        spdlog::debug("CPU: BIT operation, status updated: {:#04x}", static_cast<int>(_status));
+        _status.setFlags(alu::bit(value, _status.flags()));
+        _status.setNZ(value, _a & value);
+    }
+
+    void W65C02S::doTRB()
+    {
+        uint8_t value = fetchByte();
+        _status.setZ(_a & value);
+        writeByte(value & ~_a);
+    }
+
+    void W65C02S::doTSB()
+    {
+        uint8_t value = fetchByte();
+        _status.setZ(_a & value);
+        writeByte(value | _a);
+    }
+
+    void W65C02S::doRMB()
+    {
+        // Bits 4-6 of the opcode select the bit
+        const uint8_t bit = 1 << ((static_cast<uint8_t>(_ir) >> 4) & 0x07);
+        writeByte(fetchByte() & ~bit);
+    }
+
+    void W65C02S::doSMB()
+    {
+        const uint8_t bit = 1 << ((static_cast<uint8_t>(_ir) >> 4) & 0x07);
+        writeByte(fetchByte() | bit);
+    }
+
+    bool W65C02S::isBitBranchTaken(uint8_t value) const
+    {
+        // Bits 4-6 of the opcode select the bit, bit 7 tells BBS from BBR
+        const uint8_t opcode = static_cast<uint8_t>(_ir);
+        const bool set = (value >> ((opcode >> 4) & 0x07)) & 0x01;
+        return set == ((opcode & 0x80) != 0);
     }
 
     void W65C02S::doASL(bool accumulator)
     {
-        uint8_t value = _a;
-        if (!accumulator)
-        {
-            value = fetchByte();
-        }
-        _status &= ~(STATUS_ZERO | STATUS_NEGATIVE);
-        _status |= (value & 0x80) ? STATUS_CARRY : 0;
-        value <<= 1;
-        if (accumulator)
-        {
-            _a = value;
-        }
-        else
-        {
-            writeByte(value);
-        }
-        updateStatusFlags(_a);
+        const auto result = alu::asl(accumulator ? _a : fetchByte(), _status.flags());
+        _status.setFlags(result.status);
+        _status.setNZ(result.value);
+        storeResult(result.value, accumulator);
     }
 
     void W65C02S::doLSR(bool accumulator)
     {
-        uint8_t value = _a;
-        if (!accumulator)
-        {
-            value = fetchByte();
-        }
-        _status &= ~(STATUS_ZERO | STATUS_NEGATIVE);
-        _status |= (value & 0x01) ? STATUS_CARRY : 0;
-        value >>= 1;
-        if (accumulator)
-        {
-            _a = value;
-        }
-        else
-        {
-            writeByte(value);
-        }
-        updateStatusFlags(_a);
+        const auto result = alu::lsr(accumulator ? _a : fetchByte(), _status.flags());
+        _status.setFlags(result.status);
+        _status.setNZ(result.value);
+        storeResult(result.value, accumulator);
     }
 
     void W65C02S::doROL(bool accumulator)
     {
-        uint8_t value = _a;
-        if (!accumulator)
-        {
-            value = fetchByte();
-        }
-        bool carry = value & 0x80; // Check if the highest bit is set
-        value = (value << 1) | (_status & STATUS_CARRY); // Shift left and add carry
-        _status &= ~STATUS_CARRY; // Clear carry flag
-        if (carry) {
-            _status |= STATUS_CARRY; // Set carry flag if it was set before
-        }
-        if (accumulator)
-        {
-            _a = value;
-        }
-        else
-        {
-            writeByte(value);
-        }
-        updateStatusFlags(_a);
+        const auto result = alu::rol(accumulator ? _a : fetchByte(), _status.flags());
+        _status.setFlags(result.status);
+        _status.setNZ(result.value);
+        storeResult(result.value, accumulator);
     }
 
     void W65C02S::doROR(bool accumulator)
     {
-        uint8_t value = _a;
-        if (!accumulator)
-        {
-            value = fetchByte();
-        }
-        bool carry = value & 0x01; // Check if the lowest bit is set
-        value = (_status & STATUS_CARRY) << 7 | (value >> 1); // Shift right and add carry
-        _status &= ~STATUS_CARRY; // Clear carry flag
-        if (carry) {
-            _status |= STATUS_CARRY; // Set carry flag if it was set before
-        }
-        if (accumulator)
-        {
-            _a = value;
-        }
-        else
-        {
-            writeByte(value);
-        }
-        updateStatusFlags(_a);
+        const auto result = alu::ror(accumulator ? _a : fetchByte(), _status.flags());
+        _status.setFlags(result.status);
+        _status.setNZ(result.value);
+        storeResult(result.value, accumulator);
     }
 
     void W65C02S::doINC(bool accumulator)
     {
-        uint8_t value = _a;
-        if (!accumulator)
-        {
-            value = fetchByte();
-        }
-        value++;
-        if (accumulator)
-        {
-            _a = value;
-        }
-        else
-        {
-            writeByte(value);
-        }
-        updateStatusFlags(value);
+        const uint8_t value = (accumulator ? _a : fetchByte()) + 1;
+        _status.setNZ(value);
+        storeResult(value, accumulator);
     }
 
     void W65C02S::doDEC(bool accumulator)
     {
-        uint8_t value = _a;
-        if (!accumulator)
-        {
-            value = fetchByte();
-        }
-        value--;
+        const uint8_t value = (accumulator ? _a : fetchByte()) - 1;
+        _status.setNZ(value);
+        storeResult(value, accumulator);
+    }
+
+    void W65C02S::storeResult(uint8_t value, bool accumulator)
+    {
         if (accumulator)
         {
             _a = value;
@@ -1649,7 +1858,6 @@ namespace EaterEmulator::devices
         {
             writeByte(value);
         }
-        updateStatusFlags(value);
     }
 
     uint8_t W65C02S::fetchByte()
@@ -1666,19 +1874,13 @@ namespace EaterEmulator::devices
         _bus->notifySlaves(core::WRITE);
     }
 
-    void W65C02S::updateStatusFlags(uint8_t value)
+    uint8_t W65C02S::fetchByte(uint16_t address)
     {
-        // Update the status flags based on the value
-        if (value == 0) {
-            _status |= STATUS_ZERO; // Set zero flag
-        } else {
-            _status &= ~STATUS_ZERO; // Clear zero flag
-        }
-        if (value & 0x80) {
-            _status |= STATUS_NEGATIVE; // Set negative flag
-        } else {
-            _status &= ~STATUS_NEGATIVE; // Clear negative flag
-        }
-        spdlog::debug("CPU: Status flags updated: {:#04x}", static_cast<int>(_status));
+        return _bus->read(address);
+    }
+
+    void W65C02S::writeByte(uint16_t address, uint8_t data)
+    {
+        _bus->write(address, data);
     }
-}
\ No newline at end of file
+}
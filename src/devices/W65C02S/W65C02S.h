@@ -2,28 +2,27 @@
 
 #include "core/clock.h"
 #include "core/device.h"
+#include "core/state.h"
 #include "core/defines.h"
+#include "devices/W65C02S/DecodeCache.h"
+#include "devices/W65C02S/StatusRegister.h"
 #include "devices/W65C02S/opcodes.h"
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stop_token>
+
 namespace EaterEmulator::devices
 {
-    // Status flags bits
-    static constexpr uint8_t STATUS_CARRY = 0x01; // Carry Flag
-    static constexpr uint8_t STATUS_ZERO = 0x02; // Zero Flag
-    static constexpr uint8_t STATUS_INTERRUPT = 0x04; // Interrupt Disable Flag
-    static constexpr uint8_t STATUS_DECIMAL = 0x08; // Decimal Mode Flag
-    static constexpr uint8_t STATUS_BREAK = 0x10; // Break Command Flag
-    static constexpr uint8_t STATUS_UNUSED = 0x20; // Unused Flag (always 1)
-    static constexpr uint8_t STATUS_OVERFLOW = 0x40; // Overflow Flag
-    static constexpr uint8_t STATUS_NEGATIVE = 0x80; // Negative Flag
-
     static constexpr uint16_t RESET_VECTOR = 0xFFFC; // Reset vector address
     static constexpr uint16_t IRQ_BRK_VECTOR = 0xFFFE; // IRQ vector address
     static constexpr uint16_t NMI_VECTOR = 0xFFFA; // NMI vector address
 
 
     // W65C02S CPU device class
-    class W65C02S : public core::Device, public core::ClockObserver
+    class W65C02S : public core::Device, public core::ClockObserver, public core::Stateful
     {
     public:
         W65C02S(std::shared_ptr<core::Bus> bus);
@@ -39,11 +38,59 @@ namespace EaterEmulator::devices
         void reset();
 
         void onClockStateChange(core::State state) override;
-        void setIRQ(core::State state);
+        // Blocks the clock thread while WAI waits with no device event pending, or after STP, until setIRQ,
+        // setNMI or reset is called from another thread
+        bool waitWhileIdle(std::stop_token stop) override;
+
+        // Interrupt lines, level sensitive. Either going low ends a WAI.
+        // IRQB is wired-OR: each device driving it is a source of its own, and the line is low while any
+        // source pulls it low.
+        static constexpr uint8_t IRQ_SOURCES = 8;
+        void setIRQ(core::State state, uint8_t source = 0);
         void setNMI(core::State state);
 
+        // Parked by WAI until an interrupt line goes low
+        bool isWaiting() const { return _runState == RunState::WAITING; }
+        // Parked by STP until reset
+        bool isStopped() const { return _runState == RunState::STOPPED; }
+
+        // Instruction-stepped execution. Runs a whole instruction (or the reset/interrupt sequence) per call
+        // without modelling the individual clock phases and returns the number of cycles it took.
+        // An instruction left half-way by onClockStateChange is completed on the clock-phase core first.
+        uint8_t step();
+        // Runs count instructions through the dispatch chosen at build time: the switch in step(), or the
+        // threaded interpreter when configured with -DTHREADED_DISPATCH=ON
+        uint64_t runInstructions(uint64_t count);
+        // Same as calling step() count times, but dispatches through one handler per opcode
+        uint64_t runInstructionsThreaded(uint64_t count);
+        // Runs instructions until at least cycles clock cycles have passed. A loop in ROM that cannot change
+        // anything by itself, a JMP to itself or a short loop polling memory or a device register that holds
+        // still, is fast-forwarded by whole iterations up to the next scheduled event, the next change of
+        // the polled registers or the end of the run. Cycle counts come out as if the loop had run.
+        // Time spent in WAI is skipped the same way up to the next scheduled event, after STP up to the end.
+        // A clock with the CPU as its only observer runs it through this in batches.
+        uint64_t runCycles(uint64_t cycles) override;
+
+        // Cycles skipped by runCycles, included in getCycleCount
+        uint64_t getFastForwardedCycles() const { return _fastForwardedCycles; }
+
+        // Number of clock cycles executed since construction
+        uint64_t getCycleCount() const { return _cycleCount; }
+        // Instructions executed since construction, counting the iterations of idle loops runCycles skipped
+        uint64_t getInstructionCount() const { return _instructionCount; }
+        uint16_t getProgramCounter() const { return _pc; }
+        uint8_t getAccumulator() const { return _a; }
+        uint8_t getXRegister() const { return _x; }
+        uint8_t getYRegister() const { return _y; }
+        uint8_t getStackPointer() const { return _sp; }
+        uint8_t getStatus() const { return _status.get(); }
+
         std::string getName() const override { return "W65C02S"; }
 
+        // Registers, the in-flight instruction state and the interrupt lines
+        void saveState(core::StateWriter& writer) const override;
+        void loadState(core::StateReader& reader) override;
+
 #ifdef UNIT_TEST
         // For unit testing purposes
 
@@ -52,16 +99,11 @@ namespace EaterEmulator::devices
         void setYRegister(uint8_t value) { _y = value; }
         void setStackPointer(uint8_t value) { _sp = value; }
         void setProgramCounter(uint16_t value) { _pc = value; }
-        void setStatus(uint8_t value) { _status = value; }
+        void setStatus(uint8_t value) { _status.set(value); }
         void setResetStage(uint8_t stage) { _resetStage = stage; }
 
-        uint8_t getAccumulator() const { return _a; }
-        uint8_t getXRegister() const { return _x; }
-        uint8_t getYRegister() const { return _y; }
-        uint8_t getStackPointer() const { return _sp; }
-        uint16_t getProgramCounter() const { return _pc; }
-        uint8_t getStatus() const { return _status; }
         Opcode getInstructionRegister() const { return _ir; }
+        const DecodeCache& getDecodeCache() const { return _decodeCache; }
         uint8_t getAddressLow() const { return _adl; }
         uint8_t getAddressHigh() const { return _adh; }
 #endif
@@ -72,6 +114,40 @@ namespace EaterEmulator::devices
         void handlePhi2High();
         void handleReset();
 
+        [[nodiscard]]bool pollInterrupts();
+        // WAI or STP holds the CPU at the instruction boundary
+        [[nodiscard]]bool isHalted() const;
+        // Leaves WAI if an interrupt line is low, returns whether the CPU runs
+        [[nodiscard]]bool resume();
+        [[nodiscard]]bool isBranchTaken(Opcode opcode) const;
+        // Cycles the instruction takes with the current decimal flag and, for a branch, whether it was taken
+        [[nodiscard]]uint8_t instructionCycles(const OpcodeInfo& info) const
+        {
+            return info.cycles + (info.decimalCycles & ((_status.flags() & STATUS_DECIMAL) >> 3)) + _branchCycles;
+        }
+        // BBR/BBS in _ir on the zero page byte value
+        [[nodiscard]]bool isBitBranchTaken(uint8_t value) const;
+
+        // Instruction-stepped core
+        // Runs due events, then takes a pending interrupt or fetches the next opcode into _ir
+        void beginInstruction();
+        // Threaded interpreter handler, executes _ir known to be OPCODE
+        template<uint8_t OPCODE>
+        uint8_t executeOpcode();
+        uint16_t fetchOperandAddress(const OpcodeInfo& info);
+        // Idle-loop fast-forward for runCycles. Called on a JMP or branch at address back to _pc.
+        void checkIdleLoop(uint16_t address, const OpcodeInfo& info);
+        uint8_t measureIdleLoop();
+        void fastForward(uint64_t end);
+        // Skips the cycles WAI or STP holds the CPU for up to the next event or the end of runCycles
+        void skipHalted(uint64_t end);
+        // Byte of the current instruction, from the decode cache when it came from there
+        uint8_t instructionByte(uint16_t address);
+        void executeInstruction(const OpcodeInfo& info);
+
+        // Clock-phase core, dispatches a cycle after the first to the handler of the addressing mode
+        [[nodiscard]]bool handleAddressingMode(const OpcodeInfo& info, core::State clockState);
+
         // Accumulator addressing modes
         [[nodiscard]]bool handleAccumulatorAddressing(const OpcodeInfo& info, core::State clockState);
         [[nodiscard]]bool handleAccumulatorLow(const OpcodeInfo& info);
@@ -122,6 +198,18 @@ namespace EaterEmulator::devices
         [[nodiscard]]bool handleIndirectIndexedLow(const OpcodeInfo& info);
         [[nodiscard]]bool handleIndirectIndexedHigh(const OpcodeInfo& info);
 
+        [[nodiscard]]bool handleAbsoluteIndexedIndirectAddressing(const OpcodeInfo& info, core::State clockState);
+        [[nodiscard]]bool handleAbsoluteIndexedIndirectLow(const OpcodeInfo& info);
+        [[nodiscard]]bool handleAbsoluteIndexedIndirectHigh(const OpcodeInfo& info);
+
+        // Zero page and relative (BBR/BBS)
+        [[nodiscard]]bool handleZeroPageRelativeAddressing(const OpcodeInfo& info, core::State clockState);
+        [[nodiscard]]bool handleZeroPageRelativeLow(const OpcodeInfo& info);
+        [[nodiscard]]bool handleZeroPageRelativeHigh(const OpcodeInfo& info);
+
+        // Opcodes the W65C02S assigns no instruction to
+        [[nodiscard]]bool handleReservedNop(const OpcodeInfo& info, core::State clockState);
+
         // Math
         void doAND();
         void doORA();
@@ -131,17 +219,23 @@ namespace EaterEmulator::devices
         void doCMP();
 
         void doBIT();
+        void doTRB();
+        void doTSB();
+        void doRMB();
+        void doSMB();
         void doASL(bool accumulator);
         void doLSR(bool accumulator);
         void doROL(bool accumulator);
         void doROR(bool accumulator);
         void doINC(bool accumulator);
         void doDEC(bool accumulator);
+        // Result of a read-modify-write instruction, to A or written back to the operand
+        void storeResult(uint8_t value, bool accumulator);
 
         uint8_t fetchByte();
         void writeByte(uint8_t data);
-
-        void updateStatusFlags(uint8_t value);
+        uint8_t fetchByte(uint16_t address);
+        void writeByte(uint16_t address, uint8_t data);
 
         // Registers
         uint8_t _a; // Accumulator
@@ -149,21 +243,104 @@ namespace EaterEmulator::devices
         uint8_t _y; // Y Register
         uint8_t _sp; // Stack Pointer
         uint16_t _pc; // Program Counter
-        uint8_t _status; // Processor Status
+        StatusRegister _status; // Processor Status
 
         uint16_t _interruptVector = RESET_VECTOR;
         bool _interruptFromSW = true;
 
-        Opcode _ir; // Instruction Register
-        uint8_t _adl; // Address Low Byte
-        uint8_t _adh; // Address High Byte
-        uint8_t _add;
-
-        core::State _irq = core::HIGH;
-        core::State _nmi = core::HIGH;
+        Opcode _ir = Opcode::NOP; // Instruction Register
+        uint8_t _adl = 0; // Address Low Byte
+        uint8_t _adh = 0; // Address High Byte
+        uint8_t _add = 0;
+
+        // Interrupt input, low while any of its sources pulls it low. Other threads set it while the thread
+        // running the CPU reads it.
+        struct InterruptLine
+        {
+            InterruptLine() = default;
+            InterruptLine(const InterruptLine& other) : sources(other.loadSources()) {}
+            InterruptLine& operator=(const InterruptLine& other)
+            {
+                storeSources(other.loadSources());
+                return *this;
+            }
+
+            core::State load() const { return loadSources() != 0 ? core::LOW : core::HIGH; }
+            void set(core::State state, uint8_t source)
+            {
+                const auto bit = static_cast<uint8_t>(1u << source);
+                if (state == core::LOW)
+                {
+                    sources.fetch_or(bit, std::memory_order_release);
+                }
+                else
+                {
+                    sources.fetch_and(static_cast<uint8_t>(~bit), std::memory_order_release);
+                }
+            }
+
+            uint8_t loadSources() const { return sources.load(std::memory_order_acquire); }
+            void storeSources(uint8_t value) { sources.store(value, std::memory_order_release); }
+
+            std::atomic<uint8_t> sources = 0; // Bit per source pulling the line low
+        };
+        InterruptLine _irq;
+        InterruptLine _nmi;
         int _cycle = 0;
+        uint8_t _branchCycles = 0; // Added to the cycles of the instruction in _ir by a taken branch
+        uint64_t _cycleCount = 0;
 
         bool _started = false;
         uint8_t _resetStage = 0;
+
+        enum class RunState : uint8_t
+        {
+            RUNNING,
+            WAITING, // WAI
+            STOPPED, // STP
+        };
+        RunState _runState = RunState::RUNNING;
+
+        // Wakes the clock thread blocked in waitWhileIdle. A copy of the CPU gets its own.
+        struct Wakeup
+        {
+            Wakeup() = default;
+            Wakeup(const Wakeup&) {}
+            Wakeup& operator=(const Wakeup&) { return *this; }
+
+            std::mutex mutex;
+            std::condition_variable_any condition;
+        };
+        Wakeup _wakeup;
+
+        // Loop the CPU last jumped back to, as it was at the top of the last iteration
+        struct IdleLoop
+        {
+            static constexpr size_t MAX_LENGTH = 16; // Instructions
+            static constexpr size_t MAX_READS = 8;
+
+            uint16_t start = 0;
+            uint16_t end = 0; // Address of the JMP or branch back to start
+            uint64_t generation = 0; // Bus map the code was decoded from
+            uint8_t cycles = 0; // One iteration, 0 if the loop may have side effects
+            uint8_t instructions = 0; // In one iteration
+            std::array<uint16_t, MAX_READS> reads{}; // Operands the loop reads
+            uint8_t readCount = 0;
+            uint64_t stableUntil = 0; // The reads return the same before this cycle
+            uint64_t cycle = 0;
+            uint8_t a = 0;
+            uint8_t x = 0;
+            uint8_t y = 0;
+            uint8_t status = 0;
+        };
+        IdleLoop _idleLoop;
+        uint64_t _fastForwardLimit = 0; // End of the runCycles call in progress, 0 outside of one
+        // At the top of _idleLoop, which changed nothing in its last iteration, or halted by WAI or STP
+        bool _idleLoopDetected = false;
+        uint64_t _fastForwardedCycles = 0;
+        uint64_t _instructionCount = 0;
+
+        DecodeCache _decodeCache; // ROM code for the instruction-stepped core
+        const DecodeCache::Instruction* _decoded = nullptr; // Instruction being executed from _decodeCache
     };
 };
\ No newline at end of file
@@ -0,0 +1,925 @@
+// Instruction-stepped execution core for the W65C02S.
+// Performs the same bus reads and writes, in the same order, as the clock-phase core in W65C02S.cpp,
+// but executes a whole instruction per call and credits its cycle count from the decode table.
+// Instructions in ROM come pre-decoded from the DecodeCache instead of being fetched through the bus.
+// Nothing observes those fetches: with a bus monitor attached no page is constant and nothing is cached.
+#include "devices/W65C02S/W65C02S.h"
+#include "core/defines.h"
+#include "devices/W65C02S/opcodes.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace EaterEmulator::devices
+{
+    uint8_t W65C02S::step()
+    {
+        _started = true;
+        if (_resetStage < 2)
+        {
+            // Read the reset vector
+            _adl = fetchByte(_pc++);
+            _adh = fetchByte(_pc);
+            _pc = (_adh << 8) | _adl;
+            _resetStage = 2;
+            _cycleCount += 2;
+            return 2;
+        }
+
+        if (_cycle != 0)
+        {
+            // Finish the instruction started by the clock-phase core
+            uint8_t cycles = 0;
+            while (_cycle != 0)
+            {
+                handlePhi2Low();
+                handlePhi2High();
+                cycles++;
+            }
+            return cycles;
+        }
+
+        if (_runState != RunState::RUNNING)
+        {
+            // Events run first, one of them may raise the interrupt that ends a WAI
+            _bus->getScheduler().advance(_cycleCount);
+            if (!resume())
+            {
+                _idleLoopDetected = _fastForwardLimit != 0;
+                _cycleCount++;
+                return 1;
+            }
+        }
+
+        beginInstruction();
+        const auto& info = decodeOpcode(_ir);
+        executeInstruction(info);
+        _decoded = nullptr;
+        const uint8_t cycles = instructionCycles(info);
+        _cycleCount += cycles;
+        return cycles;
+    }
+
+    uint64_t W65C02S::runInstructions(uint64_t count)
+    {
+#ifdef EATER_THREADED_DISPATCH
+        return runInstructionsThreaded(count);
+#else
+        uint64_t cycles = 0;
+        for (uint64_t i = 0; i < count && !_idleLoopDetected; ++i)
+        {
+            cycles += step();
+        }
+        return cycles;
+#endif
+    }
+
+    uint64_t W65C02S::runCycles(uint64_t cycles)
+    {
+        const uint64_t start = _cycleCount;
+        const uint64_t end = start + cycles;
+        _fastForwardLimit = end;
+        while (_cycleCount < end)
+        {
+            if (_idleLoopDetected)
+            {
+                _idleLoopDetected = false;
+                if (_runState == RunState::RUNNING)
+                {
+                    fastForward(end);
+                }
+                else
+                {
+                    skipHalted(end);
+                }
+                continue;
+            }
+            // Batches short enough not to overrun, down to single instructions near the end.
+            // They stop early at an idle loop.
+            runInstructions(std::max<uint64_t>(1, (end - _cycleCount) / maxInstructionCycles()));
+        }
+        _fastForwardLimit = 0;
+        _idleLoopDetected = false;
+        return _cycleCount - start;
+    }
+
+    void W65C02S::beginInstruction()
+    {
+        // Due events run first so an interrupt they raise is taken at this boundary
+        _bus->getScheduler().advance(_cycleCount);
+        _decoded = nullptr;
+        _branchCycles = 0;
+        if (pollInterrupts())
+        {
+            return;
+        }
+        _decoded = _decodeCache.next(*_bus, _pc);
+        _ir = _decoded ? _decoded->info->opcode : static_cast<Opcode>(fetchByte(_pc));
+        _pc++;
+        _instructionCount++;
+    }
+
+    uint8_t W65C02S::instructionByte(uint16_t address)
+    {
+        if (_decoded)
+        {
+            return _decoded->bytes[static_cast<uint16_t>(address - _decoded->address)];
+        }
+        return fetchByte(address);
+    }
+
+    uint16_t W65C02S::fetchOperandAddress(const OpcodeInfo& info)
+    {
+        switch (info.addressingMode)
+        {
+            case AddressingMode::IMM:
+                return _pc++;
+            case AddressingMode::ZP:
+                _adl = instructionByte(_pc++);
+                return _adl;
+            case AddressingMode::ZPX:
+            case AddressingMode::ZPY:
+                _adl = instructionByte(_pc++);
+                _adh = _adl + (info.addressingMode == AddressingMode::ZPX ? _x : _y);
+                return _adh;
+            case AddressingMode::ABS:
+                _adl = instructionByte(_pc++);
+                _adh = instructionByte(_pc++);
+                return (_adh << 8) | _adl;
+            case AddressingMode::ABSX:
+            case AddressingMode::ABSY:
+                _adl = instructionByte(_pc++);
+                _adh = instructionByte(_pc++);
+                return ((_adh << 8) | _adl) + (info.addressingMode == AddressingMode::ABSX ? _x : _y);
+            case AddressingMode::INDX:
+                _add = instructionByte(_pc++) + _x;
+                _adl = fetchByte(_add);
+                _adh = fetchByte(static_cast<uint8_t>(_add + 1));
+                return (_adh << 8) | _adl;
+            case AddressingMode::ZPI:
+                _add = instructionByte(_pc++);
+                _adl = fetchByte(_add);
+                _adh = fetchByte(static_cast<uint8_t>(_add + 1));
+                return (_adh << 8) | _adl;
+            case AddressingMode::INDY:
+            {
+                _add = instructionByte(_pc++);
+                _adl = fetchByte(_add);
+                _adh = fetchByte(static_cast<uint8_t>(_add + 1));
+                uint16_t address = ((_adh << 8) | _adl) + _y;
+                _adl = static_cast<uint8_t>(address);
+                _adh = static_cast<uint8_t>(address >> 8);
+                return address;
+            }
+            default:
+                log().error("Addressing mode has no operand address, opcode: {:#04x}", static_cast<int>(info.opcode));
+                return _pc;
+        }
+    }
+
+    void W65C02S::executeInstruction(const OpcodeInfo& info)
+    {
+        switch (info.opcode)
+        {
+            // Load/Store Operations
+            case Opcode::LDA_IMM:
+            case Opcode::LDA_ZP:
+            case Opcode::LDA_ZPX:
+            case Opcode::LDA_ABS:
+            case Opcode::LDA_ABSX:
+            case Opcode::LDA_ABSY:
+            case Opcode::LDA_INDX:
+            case Opcode::LDA_INDY:
+            case Opcode::LDA_ZPI:
+                _a = fetchByte(fetchOperandAddress(info));
+                _status.setNZ(_a);
+                break;
+            case Opcode::LDX_IMM:
+            case Opcode::LDX_ZP:
+            case Opcode::LDX_ZPY:
+            case Opcode::LDX_ABS:
+            case Opcode::LDX_ABSY:
+                _x = fetchByte(fetchOperandAddress(info));
+                _status.setNZ(_x);
+                break;
+            case Opcode::LDY_IMM:
+            case Opcode::LDY_ZP:
+            case Opcode::LDY_ZPX:
+            case Opcode::LDY_ABS:
+            case Opcode::LDY_ABSX:
+                _y = fetchByte(fetchOperandAddress(info));
+                _status.setNZ(_y);
+                break;
+            case Opcode::STA_ZP:
+            case Opcode::STA_ZPX:
+            case Opcode::STA_ABS:
+            case Opcode::STA_ABSX:
+            case Opcode::STA_ABSY:
+            case Opcode::STA_INDX:
+            case Opcode::STA_INDY:
+            case Opcode::STA_ZPI:
+                writeByte(fetchOperandAddress(info), _a);
+                break;
+            case Opcode::STX_ZP:
+            case Opcode::STX_ZPY:
+            case Opcode::STX_ABS:
+                writeByte(fetchOperandAddress(info), _x);
+                break;
+            case Opcode::STY_ZP:
+            case Opcode::STY_ZPX:
+            case Opcode::STY_ABS:
+                writeByte(fetchOperandAddress(info), _y);
+                break;
+            case Opcode::STZ_ZP:
+            case Opcode::STZ_ZPX:
+            case Opcode::STZ_ABS:
+            case Opcode::STZ_ABSX:
+                writeByte(fetchOperandAddress(info), 0);
+                break;
+
+            // Logical & Arithmetic
+            case Opcode::AND_IMM:
+            case Opcode::AND_ZP:
+            case Opcode::AND_ZPX:
+            case Opcode::AND_ABS:
+            case Opcode::AND_ABSX:
+            case Opcode::AND_ABSY:
+            case Opcode::AND_INDX:
+            case Opcode::AND_INDY:
+            case Opcode::AND_ZPI:
+                _bus->setAddress(fetchOperandAddress(info));
+                doAND();
+                break;
+            case Opcode::EOR_IMM:
+            case Opcode::EOR_ZP:
+            case Opcode::EOR_ZPX:
+            case Opcode::EOR_ABS:
+            case Opcode::EOR_ABSX:
+            case Opcode::EOR_ABSY:
+            case Opcode::EOR_INDX:
+            case Opcode::EOR_INDY:
+            case Opcode::EOR_ZPI:
+                _bus->setAddress(fetchOperandAddress(info));
+                doEOR();
+                break;
+            case Opcode::ORA_IMM:
+            case Opcode::ORA_ZP:
+            case Opcode::ORA_ZPX:
+            case Opcode::ORA_ABS:
+            case Opcode::ORA_ABSX:
+            case Opcode::ORA_ABSY:
+            case Opcode::ORA_INDX:
+            case Opcode::ORA_INDY:
+            case Opcode::ORA_ZPI:
+                _bus->setAddress(fetchOperandAddress(info));
+                doORA();
+                break;
+            case Opcode::ADC_IMM:
+            case Opcode::ADC_ZP:
+            case Opcode::ADC_ZPX:
+            case Opcode::ADC_ABS:
+            case Opcode::ADC_ABSX:
+            case Opcode::ADC_ABSY:
+            case Opcode::ADC_INDX:
+            case Opcode::ADC_INDY:
+            case Opcode::ADC_ZPI:
+                _bus->setAddress(fetchOperandAddress(info));
+                doADC();
+                break;
+            case Opcode::SBC_IMM:
+            case Opcode::SBC_ZP:
+            case Opcode::SBC_ZPX:
+            case Opcode::SBC_ABS:
+            case Opcode::SBC_ABSX:
+            case Opcode::SBC_ABSY:
+            case Opcode::SBC_INDX:
+            case Opcode::SBC_INDY:
+            case Opcode::SBC_ZPI:
+                _bus->setAddress(fetchOperandAddress(info));
+                doSBC();
+                break;
+            case Opcode::CMP_IMM:
+            case Opcode::CMP_ZP:
+            case Opcode::CMP_ZPX:
+            case Opcode::CMP_ABS:
+            case Opcode::CMP_ABSX:
+            case Opcode::CMP_ABSY:
+            case Opcode::CMP_INDX:
+            case Opcode::CMP_INDY:
+            case Opcode::CMP_ZPI:
+            case Opcode::CPX_IMM:
+            case Opcode::CPX_ZP:
+            case Opcode::CPX_ABS:
+            case Opcode::CPY_IMM:
+            case Opcode::CPY_ZP:
+            case Opcode::CPY_ABS:
+                _bus->setAddress(fetchOperandAddress(info));
+                doCMP();
+                break;
+            case Opcode::BIT_IMM:
+            case Opcode::BIT_ZP:
+            case Opcode::BIT_ZPX:
+            case Opcode::BIT_ABS:
+            case Opcode::BIT_ABSX:
+                _bus->setAddress(fetchOperandAddress(info));
+                doBIT();
+                break;
+            case Opcode::TRB_ZP:
+            case Opcode::TRB_ABS:
+                _bus->setAddress(fetchOperandAddress(info));
+                doTRB();
+                break;
+            case Opcode::TSB_ZP:
+            case Opcode::TSB_ABS:
+                _bus->setAddress(fetchOperandAddress(info));
+                doTSB();
+                break;
+            case Opcode::RMB0:
+            case Opcode::RMB1:
+            case Opcode::RMB2:
+            case Opcode::RMB3:
+            case Opcode::RMB4:
+            case Opcode::RMB5:
+            case Opcode::RMB6:
+            case Opcode::RMB7:
+                _bus->setAddress(fetchOperandAddress(info));
+                doRMB();
+                break;
+            case Opcode::SMB0:
+            case Opcode::SMB1:
+            case Opcode::SMB2:
+            case Opcode::SMB3:
+            case Opcode::SMB4:
+            case Opcode::SMB5:
+            case Opcode::SMB6:
+            case Opcode::SMB7:
+                _bus->setAddress(fetchOperandAddress(info));
+                doSMB();
+                break;
+
+            // Increments, Decrements & Shifts
+            case Opcode::INC_ACC:
+                doINC(true);
+                break;
+            case Opcode::DEC_ACC:
+                doDEC(true);
+                break;
+            case Opcode::ASL_ACC:
+                doASL(true);
+                break;
+            case Opcode::LSR_ACC:
+                doLSR(true);
+                break;
+            case Opcode::ROL_ACC:
+                doROL(true);
+                break;
+            case Opcode::ROR_ACC:
+                doROR(true);
+                break;
+            case Opcode::INC_ZP:
+            case Opcode::INC_ZPX:
+            case Opcode::INC_ABS:
+            case Opcode::INC_ABSX:
+                _bus->setAddress(fetchOperandAddress(info));
+                doINC(false);
+                break;
+            case Opcode::DEC_ZP:
+            case Opcode::DEC_ZPX:
+            case Opcode::DEC_ABS:
+            case Opcode::DEC_ABSX:
+                _bus->setAddress(fetchOperandAddress(info));
+                doDEC(false);
+                break;
+            case Opcode::ASL_ZP:
+            case Opcode::ASL_ZPX:
+            case Opcode::ASL_ABS:
+            case Opcode::ASL_ABSX:
+                _bus->setAddress(fetchOperandAddress(info));
+                doASL(false);
+                break;
+            case Opcode::LSR_ZP:
+            case Opcode::LSR_ZPX:
+            case Opcode::LSR_ABS:
+            case Opcode::LSR_ABSX:
+                _bus->setAddress(fetchOperandAddress(info));
+                doLSR(false);
+                break;
+            case Opcode::ROL_ZP:
+            case Opcode::ROL_ZPX:
+            case Opcode::ROL_ABS:
+            case Opcode::ROL_ABSX:
+                _bus->setAddress(fetchOperandAddress(info));
+                doROL(false);
+                break;
+            case Opcode::ROR_ZP:
+            case Opcode::ROR_ZPX:
+            case Opcode::ROR_ABS:
+            case Opcode::ROR_ABSX:
+                _bus->setAddress(fetchOperandAddress(info));
+                doROR(false);
+                break;
+
+            // Register Transfers
+            case Opcode::TAX:
+                _x = _a;
+                _status.setNZ(_x);
+                break;
+            case Opcode::TXA:
+                _a = _x;
+                _status.setNZ(_a);
+                break;
+            case Opcode::TAY:
+                _y = _a;
+                _status.setNZ(_y);
+                break;
+            case Opcode::TYA:
+                _a = _y;
+                _status.setNZ(_a);
+                break;
+            case Opcode::TSX:
+                _x = _sp;
+                _status.setNZ(_x);
+                break;
+            case Opcode::TXS:
+                _sp = _x;
+                break;
+            case Opcode::INX:
+                _x++;
+                _status.setNZ(_x);
+                break;
+            case Opcode::DEX:
+                _x--;
+                _status.setNZ(_x);
+                break;
+            case Opcode::INY:
+                _y++;
+                _status.setNZ(_y);
+                break;
+            case Opcode::DEY:
+                _y--;
+                _status.setNZ(_y);
+                break;
+
+            // Status Flag Changes
+            case Opcode::CLC:
+                _status.clearFlag(STATUS_CARRY);
+                break;
+            case Opcode::SEC:
+                _status.setFlag(STATUS_CARRY);
+                break;
+            case Opcode::CLI:
+                _status.clearFlag(STATUS_INTERRUPT);
+                break;
+            case Opcode::SEI:
+                _status.setFlag(STATUS_INTERRUPT);
+                break;
+            case Opcode::CLV:
+                _status.clearFlag(STATUS_OVERFLOW);
+                break;
+            case Opcode::CLD:
+                _status.clearFlag(STATUS_DECIMAL);
+                break;
+            case Opcode::SED:
+                _status.setFlag(STATUS_DECIMAL);
+                break;
+            case Opcode::NOP:
+                break;
+
+            // Stack Operations
+            case Opcode::PHA:
+                writeByte(0x0100 + _sp, _a);
+                _sp--;
+                break;
+            case Opcode::PHP:
+                writeByte(0x0100 + _sp, _status.get());
+                _sp--;
+                break;
+            case Opcode::PLA:
+                _sp++;
+                _a = fetchByte(0x0100 + _sp);
+                _status.setNZ(_a);
+                break;
+            case Opcode::PLP:
+                _sp++;
+                _status.set(fetchByte(0x0100 + _sp) & ~STATUS_BREAK);
+                break;
+            case Opcode::PHX:
+                writeByte(0x0100 + _sp, _x);
+                _sp--;
+                break;
+            case Opcode::PHY:
+                writeByte(0x0100 + _sp, _y);
+                _sp--;
+                break;
+            case Opcode::PLX:
+                _sp++;
+                _x = fetchByte(0x0100 + _sp);
+                _status.setNZ(_x);
+                break;
+            case Opcode::PLY:
+                _sp++;
+                _y = fetchByte(0x0100 + _sp);
+                _status.setNZ(_y);
+                break;
+
+            // Jumps & Calls
+            case Opcode::JMP_ABS:
+            {
+                const uint16_t address = _pc - 1;
+                _adl = instructionByte(_pc++);
+                _pc = (instructionByte(_pc) << 8) | _adl;
+                if (_fastForwardLimit != 0 && _pc <= address)
+                {
+                    checkIdleLoop(address, info);
+                }
+                break;
+            }
+            case Opcode::JMP_IND:
+            {
+                _adl = instructionByte(_pc++);
+                _adh = instructionByte(_pc++);
+                uint16_t pointer = (_adh << 8) | _adl;
+                _add = fetchByte(pointer);
+                _pc = (fetchByte(pointer + 1) << 8) | _add;
+                break;
+            }
+            case Opcode::JMP_IAX:
+            {
+                _adl = instructionByte(_pc++);
+                _adh = instructionByte(_pc++);
+                uint16_t pointer = ((_adh << 8) | _adl) + _x;
+                _add = fetchByte(pointer);
+                _pc = (fetchByte(pointer + 1) << 8) | _add;
+                break;
+            }
+            case Opcode::JSR:
+                _adl = instructionByte(_pc++);
+                writeByte(0x0100 + _sp, static_cast<uint8_t>(_pc >> 8));
+                _sp--;
+                writeByte(0x0100 + _sp, static_cast<uint8_t>(_pc));
+                _sp--;
+                _pc = (instructionByte(_pc) << 8) | _adl;
+                break;
+            case Opcode::RTS:
+                _sp++;
+                _adl = fetchByte(0x0100 + _sp);
+                _sp++;
+                _pc = (fetchByte(0x0100 + _sp) << 8) | _adl;
+                _pc++;
+                break;
+
+            // Branches
+            case Opcode::BPL:
+            case Opcode::BMI:
+            case Opcode::BVC:
+            case Opcode::BVS:
+            case Opcode::BCC:
+            case Opcode::BCS:
+            case Opcode::BNE:
+            case Opcode::BEQ:
+            case Opcode::BRA:
+            {
+                const uint16_t address = _pc - 1;
+                _adl = instructionByte(_pc++);
+                if (isBranchTaken(info.opcode))
+                {
+                    const uint16_t target = _pc + static_cast<int8_t>(_adl);
+                    _branchCycles = branchTakenCycles(_pc, target);
+                    _pc = target;
+                    if (_fastForwardLimit != 0 && _pc <= address)
+                    {
+                        checkIdleLoop(address, info);
+                    }
+                }
+                break;
+            }
+
+            case Opcode::BBR0:
+            case Opcode::BBR1:
+            case Opcode::BBR2:
+            case Opcode::BBR3:
+            case Opcode::BBR4:
+            case Opcode::BBR5:
+            case Opcode::BBR6:
+            case Opcode::BBR7:
+            case Opcode::BBS0:
+            case Opcode::BBS1:
+            case Opcode::BBS2:
+            case Opcode::BBS3:
+            case Opcode::BBS4:
+            case Opcode::BBS5:
+            case Opcode::BBS6:
+            case Opcode::BBS7:
+            {
+                const uint16_t address = _pc - 1;
+                _adl = instructionByte(_pc++);
+                _add = fetchByte(_adl);
+                _adh = instructionByte(_pc++);
+                if (isBitBranchTaken(_add))
+                {
+                    const uint16_t target = _pc + static_cast<int8_t>(_adh);
+                    _branchCycles = branchTakenCycles(_pc, target);
+                    _pc = target;
+                    if (_fastForwardLimit != 0 && _pc <= address)
+                    {
+                        checkIdleLoop(address, info);
+                    }
+                }
+                break;
+            }
+
+            // System Functions
+            case Opcode::BRK:
+            {
+                writeByte(0x0100 + _sp, static_cast<uint8_t>(_pc >> 8));
+                _sp--;
+                writeByte(0x0100 + _sp, static_cast<uint8_t>(_pc));
+                _sp--;
+                auto status = _interruptFromSW ? _status.get() | STATUS_BREAK : _status.get();
+                writeByte(0x0100 + _sp, status);
+                _sp--;
+                _adl = fetchByte(_interruptVector);
+                _pc = (fetchByte(_interruptVector + 1) << 8) | _adl;
+                if (_interruptVector == IRQ_BRK_VECTOR)
+                {
+                    _status.setFlag(STATUS_INTERRUPT);
+                }
+                break;
+            }
+            case Opcode::RTI:
+                _sp++;
+                _status.set(fetchByte(0x0100 + _sp));
+                _sp++;
+                _adl = fetchByte(0x0100 + _sp);
+                _sp++;
+                _pc = (fetchByte(0x0100 + _sp) << 8) | _adl;
+                break;
+            case Opcode::WAI:
+            case Opcode::STP:
+                _runState = info.opcode == Opcode::WAI ? RunState::WAITING : RunState::STOPPED;
+                _idleLoopDetected = _fastForwardLimit != 0;
+                break;
+
+            default:
+                if (info.reserved)
+                {
+                    // Reserved NOP: fetches its operand and, but for 5C, reads the address it names
+                    if (info.addressingMode != AddressingMode::IMP)
+                    {
+                        const uint16_t address = fetchOperandAddress(info);
+                        if (static_cast<uint8_t>(info.opcode) != 0x5C)
+                        {
+                            fetchByte(address);
+                        }
+                    }
+                    break;
+                }
+                log().error("Unhandled opcode in instruction step: {:#04x}", static_cast<int>(info.opcode));
+                break;
+        }
+    }
+
+    // Idle loops. A loop qualifies when its code is in constant memory and, apart from the JMP or branch
+    // closing it, only loads, compares and tests registers against immediates, memory or device registers.
+    // Once an iteration ends at the top with the same registers it started with, and the bus promised
+    // before that iteration that the values read would hold still, every further iteration does the same
+    // until an event fires or a read value changes.
+
+    void W65C02S::checkIdleLoop(uint16_t address, const OpcodeInfo& info)
+    {
+        auto& loop = _idleLoop;
+        const uint64_t cycle = _cycleCount + instructionCycles(info); // Back at the top once this instruction is done
+        if (loop.start != _pc || loop.end != address || loop.generation != _bus->getMapGeneration())
+        {
+            loop = IdleLoop{};
+            loop.start = _pc;
+            loop.end = address;
+            loop.generation = _bus->getMapGeneration();
+            loop.cycles = measureIdleLoop();
+        }
+        else if (loop.cycles != 0 && cycle - loop.cycle == loop.cycles && loop.stableUntil >= cycle
+            && _a == loop.a && _x == loop.x && _y == loop.y && _status.get() == loop.status)
+        {
+            _idleLoopDetected = true;
+        }
+        if (loop.cycles == 0)
+        {
+            return;
+        }
+
+        loop.cycle = cycle;
+        loop.a = _a;
+        loop.x = _x;
+        loop.y = _y;
+        loop.status = _status.get();
+        loop.stableUntil = core::Scheduler::NEVER;
+        for (uint8_t i = 0; i < loop.readCount; ++i)
+        {
+            loop.stableUntil = std::min(loop.stableUntil, _bus->getReadStableUntil(loop.reads[i]));
+        }
+    }
+
+    uint8_t W65C02S::measureIdleLoop()
+    {
+        auto& loop = _idleLoop;
+        auto readConstant = [this](uint16_t address, uint8_t& value) {
+            const uint8_t* page = _bus->getConstantPage(static_cast<uint8_t>(address >> core::Bus::PAGE_SHIFT));
+            if (page)
+            {
+                value = page[address & core::Bus::PAGE_MASK];
+            }
+            return page != nullptr;
+        };
+
+        uint32_t pc = loop.start;
+        uint8_t cycles = 0;
+        for (size_t i = 0; i < IdleLoop::MAX_LENGTH && pc <= loop.end; ++i)
+        {
+            uint8_t opcode = 0;
+            if (!readConstant(static_cast<uint16_t>(pc), opcode))
+            {
+                return 0;
+            }
+            const auto& info = decodeOpcode(static_cast<Opcode>(opcode));
+            cycles += info.cycles;
+            loop.instructions++;
+            if (pc == loop.end)
+            {
+                // The JMP or branch that got here, taken. BBR and BBS read the zero page byte they test.
+                if (info.addressingMode == AddressingMode::REL || info.addressingMode == AddressingMode::ZPR)
+                {
+                    cycles += branchTakenCycles(static_cast<uint16_t>(pc + instructionLength(info.addressingMode)), loop.start);
+                }
+                uint8_t address = 0;
+                if (info.addressingMode == AddressingMode::ZPR)
+                {
+                    if (loop.readCount == IdleLoop::MAX_READS || !readConstant(static_cast<uint16_t>(pc + 1), address))
+                    {
+                        return 0;
+                    }
+                    loop.reads[loop.readCount++] = address;
+                }
+                return cycles;
+            }
+
+            switch (info.opcode)
+            {
+                case Opcode::LDA_IMM: case Opcode::LDX_IMM: case Opcode::LDY_IMM:
+                case Opcode::AND_IMM: case Opcode::ORA_IMM: case Opcode::EOR_IMM:
+                case Opcode::CMP_IMM: case Opcode::CPX_IMM: case Opcode::CPY_IMM: case Opcode::BIT_IMM:
+                case Opcode::NOP: case Opcode::CLC: case Opcode::SEC: case Opcode::CLV:
+                case Opcode::TAX: case Opcode::TXA: case Opcode::TAY: case Opcode::TYA:
+                    break;
+                case Opcode::LDA_ZP: case Opcode::LDX_ZP: case Opcode::LDY_ZP:
+                case Opcode::AND_ZP: case Opcode::ORA_ZP: case Opcode::EOR_ZP:
+                case Opcode::CMP_ZP: case Opcode::CPX_ZP: case Opcode::CPY_ZP: case Opcode::BIT_ZP:
+                case Opcode::LDA_ABS: case Opcode::LDX_ABS: case Opcode::LDY_ABS:
+                case Opcode::AND_ABS: case Opcode::ORA_ABS: case Opcode::EOR_ABS:
+                case Opcode::CMP_ABS: case Opcode::CPX_ABS: case Opcode::CPY_ABS: case Opcode::BIT_ABS:
+                {
+                    uint8_t low = 0;
+                    uint8_t high = 0;
+                    if (loop.readCount == IdleLoop::MAX_READS || !readConstant(static_cast<uint16_t>(pc + 1), low)
+                        || (info.addressingMode == AddressingMode::ABS && !readConstant(static_cast<uint16_t>(pc + 2), high)))
+                    {
+                        return 0;
+                    }
+                    loop.reads[loop.readCount++] = static_cast<uint16_t>((high << 8) | low);
+                    break;
+                }
+                default:
+                    return 0; // Writes, changes the stack or jumps elsewhere
+            }
+            pc += instructionLength(info.addressingMode);
+        }
+        return 0;
+    }
+
+    void W65C02S::fastForward(uint64_t end)
+    {
+        // Whole iterations that end before the next event is due and before a read value changes, so both
+        // still happen at the instruction boundary they would have without skipping
+        const uint64_t bound = std::min({ end + 1, _bus->getScheduler().nextEventCycle(), _idleLoop.stableUntil });
+        if (bound <= _cycleCount + _idleLoop.cycles)
+        {
+            return;
+        }
+        const uint64_t skipped = (bound - 1 - _cycleCount) / _idleLoop.cycles * _idleLoop.cycles;
+        _cycleCount += skipped;
+        _fastForwardedCycles += skipped;
+        _instructionCount += skipped / _idleLoop.cycles * _idleLoop.instructions;
+        _idleLoop.cycle = _cycleCount;
+    }
+
+    void W65C02S::skipHalted(uint64_t end)
+    {
+        // Nothing happens before the next event, which may raise the interrupt that ends a WAI.
+        // Only reset ends STP.
+        const uint64_t until = _runState == RunState::WAITING
+            ? std::min(end, _bus->getScheduler().nextEventCycle()) : end;
+        if (isHalted() && until > _cycleCount)
+        {
+            _fastForwardedCycles += until - _cycleCount;
+            _cycleCount = until;
+        }
+    }
+
+    // Threaded interpreter. Each opcode gets its own handler, an instantiation of executeOpcode in which
+    // the decode table entry is a constant, so the opcode and addressing mode switches fold away.
+    // With GCC and Clang the handlers are labels that each end in their own indirect jump to the next
+    // one (labels as values), elsewhere they are functions called through a table. Configuring with
+    // THREADED_DISPATCH_PORTABLE selects the table with GCC and Clang too, so it is tested there.
+
+#if defined(__GNUC__) && defined(__OPTIMIZE__)
+    // The switches only fold once executeInstruction is inlined into the handler
+    #define EATER_OPCODE_HANDLER [[gnu::flatten]]
+#else
+    #define EATER_OPCODE_HANDLER
+#endif
+
+    template<uint8_t OPCODE>
+    EATER_OPCODE_HANDLER uint8_t W65C02S::executeOpcode()
+    {
+        constexpr const OpcodeInfo& info = OpcodeTable[OPCODE];
+        executeInstruction(info);
+        _decoded = nullptr;
+        const uint8_t cycles = instructionCycles(info);
+        _cycleCount += cycles;
+        return cycles;
+    }
+
+    #undef EATER_OPCODE_HANDLER
+
+    // Applies M to every opcode as two hex digits, 00 to FF
+    #define EATER_OPCODE_ROW(M, HIGH) \
+        M(HIGH##0) M(HIGH##1) M(HIGH##2) M(HIGH##3) M(HIGH##4) M(HIGH##5) M(HIGH##6) M(HIGH##7) \
+        M(HIGH##8) M(HIGH##9) M(HIGH##A) M(HIGH##B) M(HIGH##C) M(HIGH##D) M(HIGH##E) M(HIGH##F)
+    #define EATER_FOR_EACH_OPCODE(M) \
+        EATER_OPCODE_ROW(M, 0) EATER_OPCODE_ROW(M, 1) EATER_OPCODE_ROW(M, 2) EATER_OPCODE_ROW(M, 3) \
+        EATER_OPCODE_ROW(M, 4) EATER_OPCODE_ROW(M, 5) EATER_OPCODE_ROW(M, 6) EATER_OPCODE_ROW(M, 7) \
+        EATER_OPCODE_ROW(M, 8) EATER_OPCODE_ROW(M, 9) EATER_OPCODE_ROW(M, A) EATER_OPCODE_ROW(M, B) \
+        EATER_OPCODE_ROW(M, C) EATER_OPCODE_ROW(M, D) EATER_OPCODE_ROW(M, E) EATER_OPCODE_ROW(M, F)
+
+    uint64_t W65C02S::runInstructionsThreaded(uint64_t count)
+    {
+        uint64_t cycles = 0;
+#if defined(__GNUC__) && !defined(EATER_THREADED_DISPATCH_PORTABLE)
+        // Labels as values are a GNU extension
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wpedantic"
+        #define EATER_LABEL_ADDRESS(OPCODE) &&opcode##OPCODE,
+        static const void* const handlers[256] = { EATER_FOR_EACH_OPCODE(EATER_LABEL_ADDRESS) };
+        #undef EATER_LABEL_ADDRESS
+
+        // The reset sequence, an instruction left half-way by the clock-phase core, WAI and STP are left
+        // to step(). An idle loop ends the batch for runCycles.
+        #define EATER_DISPATCH() \
+            if (count == 0 || _resetStage < 2 || _cycle != 0 || _runState != RunState::RUNNING || _idleLoopDetected) \
+                goto stepped; \
+            count--; \
+            beginInstruction(); \
+            goto *handlers[static_cast<uint8_t>(_ir)]
+
+        while (count > 0)
+        {
+            EATER_DISPATCH();
+            #define EATER_LABEL(OPCODE) opcode##OPCODE: cycles += executeOpcode<0x##OPCODE>(); EATER_DISPATCH();
+            EATER_FOR_EACH_OPCODE(EATER_LABEL)
+            #undef EATER_LABEL
+        stepped:
+            if (_idleLoopDetected)
+            {
+                break;
+            }
+            if (count > 0)
+            {
+                cycles += step();
+                count--;
+            }
+        }
+        #undef EATER_DISPATCH
+        #pragma GCC diagnostic pop
+#else
+        using Handler = uint8_t (W65C02S::*)();
+        #define EATER_HANDLER_ADDRESS(OPCODE) &W65C02S::executeOpcode<0x##OPCODE>,
+        static constexpr Handler handlers[256] = { EATER_FOR_EACH_OPCODE(EATER_HANDLER_ADDRESS) };
+        #undef EATER_HANDLER_ADDRESS
+
+        for (; count > 0 && !_idleLoopDetected; count--)
+        {
+            if (_resetStage < 2 || _cycle != 0 || _runState != RunState::RUNNING)
+            {
+                cycles += step();
+                continue;
+            }
+            beginInstruction();
+            cycles += (this->*handlers[static_cast<uint8_t>(_ir)])();
+        }
+#endif
+        return cycles;
+    }
+
+    #undef EATER_FOR_EACH_OPCODE
+    #undef EATER_OPCODE_ROW
+}
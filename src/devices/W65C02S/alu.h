@@ -0,0 +1,145 @@
+// Arithmetic and logic kernels of the W65C02S. Decimal mode follows the WDC 65C02: N and Z reflect the
+// BCD result, C is the decimal carry and V is computed as on the NMOS 6502, with the decimal adjustment
+// taken from tables generated at compile time. N and Z are left to the status register, which derives
+// them from the result byte when they are read.
+#pragma once
+
+#include "devices/W65C02S/StatusRegister.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace EaterEmulator::devices::alu
+{
+    // Value an operation produced and the status register after it, N and Z clear
+    struct Result
+    {
+        uint8_t value;
+        uint8_t status;
+    };
+
+    // Flags an operation leaves alone and does not take from the result byte
+    constexpr uint8_t keep(uint8_t status, uint8_t changed)
+    {
+        return status & ~(STATUS_NEGATIVE | STATUS_ZERO | changed);
+    }
+
+    // Decimal mode results are indexed by the 9-bit binary sum with the carry out of bit 3 in bit 9,
+    // which tells everything the adjustment needs to know about the operands
+    constexpr size_t decimalIndex(uint8_t a, uint8_t operand, unsigned sum)
+    {
+        return sum | ((a ^ operand ^ sum) & 0x10) << 5;
+    }
+
+    struct DecimalSum
+    {
+        uint8_t value;
+        uint8_t carry;
+        uint8_t uncorrected; // Sum before the high digit was adjusted, which V is taken from
+    };
+
+    inline constexpr std::array<DecimalSum, 1024> DECIMAL_ADC = [] {
+        std::array<DecimalSum, 1024> table{};
+        for (unsigned index = 0; index < table.size(); ++index)
+        {
+            const unsigned sum = index & 0x1FF;
+            const unsigned low = (sum & 0x0F) | ((index >> 5) & 0x10);
+            const unsigned adjustedLow = low < 0x0A ? low : ((low + 0x06) & 0x0F) + 0x10;
+            const unsigned uncorrected = sum - low + adjustedLow;
+            const unsigned result = uncorrected < 0xA0 ? uncorrected : uncorrected + 0x60;
+            table[index] = {
+                static_cast<uint8_t>(result),
+                static_cast<uint8_t>(result > 0xFF ? STATUS_CARRY : 0),
+                static_cast<uint8_t>(uncorrected),
+            };
+        }
+        return table;
+    }();
+
+    // SBC adds the complement of the operand, so a missing carry is a borrow out of that digit
+    inline constexpr std::array<uint8_t, 1024> DECIMAL_SBC = [] {
+        std::array<uint8_t, 1024> table{};
+        for (unsigned index = 0; index < table.size(); ++index)
+        {
+            unsigned result = index & 0x1FF;
+            result -= (index & 0x100) ? 0 : 0x60;
+            result -= (index & 0x200) ? 0 : 0x06;
+            table[index] = static_cast<uint8_t>(result);
+        }
+        return table;
+    }();
+
+    constexpr uint8_t overflow(uint8_t a, uint8_t operand, unsigned sum)
+    {
+        return static_cast<uint8_t>(((a ^ sum) & (operand ^ sum) & 0x80) >> 1);
+    }
+
+    constexpr Result adc(uint8_t a, uint8_t operand, uint8_t status)
+    {
+        const unsigned sum = a + operand + (status & STATUS_CARRY);
+        const uint8_t flags = keep(status, STATUS_OVERFLOW | STATUS_CARRY);
+        if (status & STATUS_DECIMAL)
+        {
+            const auto& decimal = DECIMAL_ADC[decimalIndex(a, operand, sum)];
+            return { decimal.value, static_cast<uint8_t>(flags | decimal.carry | overflow(a, operand, decimal.uncorrected)) };
+        }
+        return { static_cast<uint8_t>(sum), static_cast<uint8_t>(flags | (sum >> 8) | overflow(a, operand, sum)) };
+    }
+
+    // C and V come from the binary difference in decimal mode too
+    constexpr Result sbc(uint8_t a, uint8_t operand, uint8_t status)
+    {
+        const uint8_t complement = ~operand;
+        if (!(status & STATUS_DECIMAL))
+        {
+            return adc(a, complement, status);
+        }
+        const unsigned sum = a + complement + (status & STATUS_CARRY);
+        const uint8_t flags = keep(status, STATUS_OVERFLOW | STATUS_CARRY);
+        return { DECIMAL_SBC[decimalIndex(a, complement, sum)], static_cast<uint8_t>(flags | (sum >> 8) | overflow(a, complement, sum)) };
+    }
+
+    // CMP, CPX and CPY: reg - operand for N and Z, and C, never decimal
+    constexpr Result compare(uint8_t reg, uint8_t operand, uint8_t status)
+    {
+        const unsigned difference = reg + static_cast<uint8_t>(~operand) + 1u;
+        return { static_cast<uint8_t>(difference), static_cast<uint8_t>(keep(status, STATUS_CARRY) | (difference >> 8)) };
+    }
+
+    constexpr Result asl(uint8_t value, uint8_t status)
+    {
+        const unsigned shifted = value << 1;
+        return { static_cast<uint8_t>(shifted), static_cast<uint8_t>(keep(status, STATUS_CARRY) | (shifted >> 8)) };
+    }
+
+    constexpr Result rol(uint8_t value, uint8_t status)
+    {
+        const unsigned shifted = (value << 1) | (status & STATUS_CARRY);
+        return { static_cast<uint8_t>(shifted), static_cast<uint8_t>(keep(status, STATUS_CARRY) | (shifted >> 8)) };
+    }
+
+    constexpr Result lsr(uint8_t value, uint8_t status)
+    {
+        return { static_cast<uint8_t>(value >> 1), static_cast<uint8_t>(keep(status, STATUS_CARRY) | (value & STATUS_CARRY)) };
+    }
+
+    constexpr Result ror(uint8_t value, uint8_t status)
+    {
+        const uint8_t shifted = static_cast<uint8_t>((value >> 1) | (status & STATUS_CARRY) << 7);
+        return { shifted, static_cast<uint8_t>(keep(status, STATUS_CARRY) | (value & STATUS_CARRY)) };
+    }
+
+    // BIT copies bit 6 of the operand into V. N is bit 7 of the operand and Z tests a & operand, the
+    // immediate form only sets Z.
+    constexpr uint8_t bit(uint8_t operand, uint8_t status)
+    {
+        return static_cast<uint8_t>(keep(status, STATUS_OVERFLOW) | (operand & STATUS_OVERFLOW));
+    }
+
+    static_assert(adc(0x50, 0x50, 0).value == 0xA0 && adc(0x50, 0x50, 0).status == STATUS_OVERFLOW);
+    static_assert(adc(0x58, 0x46, STATUS_DECIMAL | STATUS_CARRY).value == 0x05
+        && (adc(0x58, 0x46, STATUS_DECIMAL | STATUS_CARRY).status & STATUS_CARRY));
+    static_assert(sbc(0x12, 0x21, STATUS_DECIMAL | STATUS_CARRY).value == 0x91
+        && !(sbc(0x12, 0x21, STATUS_DECIMAL | STATUS_CARRY).status & STATUS_CARRY));
+}
@@ -1,8 +1,9 @@
 #pragma once
 
 #include "core/defines.h"
+#include <algorithm>
+#include <array>
 #include <cstddef>
-#include <unordered_map>
 #include <cstdint>
 
 namespace EaterEmulator 
@@ -20,6 +21,7 @@ namespace EaterEmulator
         LDA_ABSY = 0xB9, // LDA $nnnn,Y Absolute,Y
         LDA_INDX = 0xA1, // LDA ($nn,X) Indirect,X
         LDA_INDY = 0xB1, // LDA ($nn),Y Indirect,Y
+        LDA_ZPI = 0xB2, // LDA ($nn) Zero Page Indirect
 
         LDX_IMM = 0xA2, // LDX #$nn Immediate
         LDX_ZP = 0xA6,  // LDX $nn Zero Page
@@ -40,6 +42,7 @@ namespace EaterEmulator
         STA_ABSY = 0x99, // STA $nnnn,Y Absolute,Y
         STA_INDX = 0x81, // STA ($nn,X) Indirect,X
         STA_INDY = 0x91, // STA ($nn),Y Indirect,Y
+        STA_ZPI = 0x92, // STA ($nn) Zero Page Indirect
 
         STX_ZP = 0x86,  // STX $nn Zero Page
         STX_ZPY = 0x96, // STX $nn,Y Zero Page,Y
@@ -49,6 +52,11 @@ namespace EaterEmulator
         STY_ZPX = 0x94, // STY $nn,X Zero Page,X
         STY_ABS = 0x8C, // STY $nnnn Absolute
 
+        STZ_ZP = 0x64,  // STZ $nn Zero Page
+        STZ_ZPX = 0x74, // STZ $nn,X Zero Page,X
+        STZ_ABS = 0x9C, // STZ $nnnn Absolute
+        STZ_ABSX = 0x9E, // STZ $nnnn,X Absolute,X
+
         // Register Transfers
         TAX = 0xAA, // Transfer Accumulator to X
         TXA = 0x8A, // Transfer X to Accumulator
@@ -66,6 +74,10 @@ namespace EaterEmulator
         PLA = 0x68, // Pull Accumulator
         PHP = 0x08, // Push Processor Status
         PLP = 0x28, // Pull Processor Status
+        PHX = 0xDA, // Push X Register
+        PLX = 0xFA, // Pull X Register
+        PHY = 0x5A, // Push Y Register
+        PLY = 0x7A, // Pull Y Register
 
         // Logical
         AND_IMM = 0x29, // AND #$nn Immediate
@@ -76,6 +88,7 @@ namespace EaterEmulator
         AND_ABSY = 0x39, // AND $nnnn,Y Absolute,Y
         AND_INDX = 0x21, // AND ($nn,X) Indirect,X
         AND_INDY = 0x31, // AND ($nn),Y Indirect,Y
+        AND_ZPI = 0x32, // AND ($nn) Zero Page Indirect
 
         EOR_IMM = 0x49, // EOR #$nn Immediate
         EOR_ZP = 0x45,  // EOR $nn Zero Page
@@ -85,6 +98,7 @@ namespace EaterEmulator
         EOR_ABSY = 0x59, // EOR $nnnn,Y Absolute,Y
         EOR_INDX = 0x41, // EOR ($nn,X) Indirect,X
         EOR_INDY = 0x51, // EOR ($nn),Y Indirect,Y
+        EOR_ZPI = 0x52, // EOR ($nn) Zero Page Indirect
 
         ORA_IMM = 0x09, // ORA #$nn Immediate
         ORA_ZP = 0x05,  // ORA $nn Zero Page
@@ -94,9 +108,25 @@ namespace EaterEmulator
         ORA_ABSY = 0x19, // ORA $nnnn,Y Absolute,Y
         ORA_INDX = 0x01, // ORA ($nn,X) Indirect,X
         ORA_INDY = 0x11, // ORA ($nn),Y Indirect,Y
+        ORA_ZPI = 0x12, // ORA ($nn) Zero Page Indirect
 
+        BIT_IMM = 0x89, // BIT #$nn Immediate
         BIT_ZP = 0x24,  // BIT $nn Zero Page
+        BIT_ZPX = 0x34, // BIT $nn,X Zero Page,X
         BIT_ABS = 0x2C, // BIT $nnnn Absolute
+        BIT_ABSX = 0x3C, // BIT $nnnn,X Absolute,X
+
+        // Test and Reset/Set Memory Bits
+        TRB_ZP = 0x14,  // TRB $nn Zero Page
+        TRB_ABS = 0x1C, // TRB $nnnn Absolute
+        TSB_ZP = 0x04,  // TSB $nn Zero Page
+        TSB_ABS = 0x0C, // TSB $nnnn Absolute
+
+        // Reset/Set Memory Bit n, Zero Page
+        RMB0 = 0x07, RMB1 = 0x17, RMB2 = 0x27, RMB3 = 0x37,
+        RMB4 = 0x47, RMB5 = 0x57, RMB6 = 0x67, RMB7 = 0x77,
+        SMB0 = 0x87, SMB1 = 0x97, SMB2 = 0xA7, SMB3 = 0xB7,
+        SMB4 = 0xC7, SMB5 = 0xD7, SMB6 = 0xE7, SMB7 = 0xF7,
 
         // Arithmetic
         ADC_IMM = 0x69, // ADC #$nn Immediate
@@ -107,6 +137,7 @@ namespace EaterEmulator
         ADC_ABSY = 0x79, // ADC $nnnn,Y Absolute,Y
         ADC_INDX = 0x61, // ADC ($nn,X) Indirect,X
         ADC_INDY = 0x71, // ADC ($nn),Y Indirect,Y
+        ADC_ZPI = 0x72, // ADC ($nn) Zero Page Indirect
 
         SBC_IMM = 0xE9, // SBC #$nn Immediate
         SBC_ZP = 0xE5,  // SBC $nn Zero Page
@@ -116,6 +147,7 @@ namespace EaterEmulator
         SBC_ABSY = 0xF9, // SBC $nnnn,Y Absolute,Y
         SBC_INDX = 0xE1, // SBC ($nn,X) Indirect,X
         SBC_INDY = 0xF1, // SBC ($nn),Y Indirect,Y
+        SBC_ZPI = 0xF2, // SBC ($nn) Zero Page Indirect
 
         CMP_IMM = 0xC9, // CMP #$nn Immediate
         CMP_ZP = 0xC5,  // CMP $nn Zero Page
@@ -125,6 +157,7 @@ namespace EaterEmulator
         CMP_ABSY = 0xD9, // CMP $nnnn,Y Absolute,Y
         CMP_INDX = 0xC1, // CMP ($nn,X) Indirect,X
         CMP_INDY = 0xD1, // CMP ($nn),Y Indirect,Y
+        CMP_ZPI = 0xD2, // CMP ($nn) Zero Page Indirect
 
         CPX_IMM = 0xE0, // CPX #$nn Immediate
         CPX_ZP = 0xE4,  // CPX $nn Zero Page
@@ -174,6 +207,7 @@ namespace EaterEmulator
         // Jumps & Calls
         JMP_ABS = 0x4C, // JMP $nnnn Absolute
         JMP_IND = 0x6C, // JMP ($nnnn) Indirect
+        JMP_IAX = 0x7C, // JMP ($nnnn,X) Absolute Indexed Indirect
         JSR = 0x20,     // JSR $nnnn Jump to Subroutine
         RTS = 0x60,     // Return from Subroutine
 
@@ -186,6 +220,13 @@ namespace EaterEmulator
         BCS = 0xB0, // Branch on Carry Set
         BNE = 0xD0, // Branch on Not Equal
         BEQ = 0xF0, // Branch on Equal
+        BRA = 0x80, // Branch Always
+
+        // Branch on Bit n Reset/Set, Zero Page and Relative
+        BBR0 = 0x0F, BBR1 = 0x1F, BBR2 = 0x2F, BBR3 = 0x3F,
+        BBR4 = 0x4F, BBR5 = 0x5F, BBR6 = 0x6F, BBR7 = 0x7F,
+        BBS0 = 0x8F, BBS1 = 0x9F, BBS2 = 0xAF, BBS3 = 0xBF,
+        BBS4 = 0xCF, BBS5 = 0xDF, BBS6 = 0xEF, BBS7 = 0xFF,
 
         // Status Flag Changes
         CLC = 0x18, // Clear Carry
@@ -200,6 +241,8 @@ namespace EaterEmulator
         BRK = 0x00, // Force Interrupt
         NOP = 0xEA, // No Operation
         RTI = 0x40, // Return from Interrupt
+        WAI = 0xCB, // Wait for Interrupt
+        STP = 0xDB, // Stop the clock until reset
     };
 
     enum class AddressingMode : uint8_t 
@@ -217,6 +260,9 @@ namespace EaterEmulator
         INDX,// Indirect,X
         INDY,// Indirect,Y
         REL, // Relative
+        ZPI, // Zero Page Indirect
+        IAX, // Absolute Indexed Indirect
+        ZPR, // Zero Page and Relative
     };
 
     enum class IndexingRegisters : uint8_t 
@@ -231,172 +277,347 @@ namespace EaterEmulator
         AddressingMode addressingMode; // The addressing mode used by the opcode
         uint8_t cycles; // Number of cycles required to execute the opcode
         uint8_t rwb; // Read/Write flag (0 for read, 1 for write)
+        uint8_t decimalCycles = 0; // Added to cycles in decimal mode, ADC and SBC take one more to adjust the result
+        bool reserved = false; // Not assigned to an instruction, executes as a NOP
     };   
     
-    static std::unordered_map<Opcode, OpcodeInfo> OpcodeMap
+    // Every opcode implemented by the W65C02S, in no particular order
+    inline constexpr OpcodeInfo ImplementedOpcodes[]
     {
         // Load/Store Operations
-        {Opcode::LDA_IMM, { Opcode::LDA_IMM, AddressingMode::IMM, 2, core::HIGH}},
-        {Opcode::LDA_ZP, { Opcode::LDA_ZP, AddressingMode::ZP, 3, core::HIGH}},
-        {Opcode::LDA_ZPX, { Opcode::LDA_ZPX, AddressingMode::ZPX, 4, core::HIGH}},
-        {Opcode::LDA_ABS, { Opcode::LDA_ABS, AddressingMode::ABS, 4, core::HIGH}},
-        {Opcode::LDA_ABSX, { Opcode::LDA_ABSX, AddressingMode::ABSX, 4, core::HIGH}},
-        {Opcode::LDA_ABSY, { Opcode::LDA_ABSY, AddressingMode::ABSY, 4, core::HIGH}},
-        {Opcode::LDA_INDX, { Opcode::LDA_INDX, AddressingMode::INDX, 6, core::HIGH}},
-        {Opcode::LDA_INDY, { Opcode::LDA_INDY, AddressingMode::INDY, 5, core::HIGH}},
-        {Opcode::LDX_IMM, { Opcode::LDX_IMM, AddressingMode::IMM, 2, core::HIGH}},
-        {Opcode::LDX_ZP, { Opcode::LDX_ZP, AddressingMode::ZP, 3, core::HIGH}},
-        {Opcode::LDX_ZPY, { Opcode::LDX_ZPY, AddressingMode::ZPY, 4, core::HIGH}},
-        {Opcode::LDX_ABS, { Opcode::LDX_ABS, AddressingMode::ABS, 4, core::HIGH}},
-        {Opcode::LDX_ABSY, { Opcode::LDX_ABSY, AddressingMode::ABSY, 4, core::HIGH}},
-        {Opcode::LDY_IMM, { Opcode::LDY_IMM, AddressingMode::IMM, 2, core::HIGH}},
-        {Opcode::LDY_ZP, { Opcode::LDY_ZP, AddressingMode::ZP, 3, core::HIGH}},
-        {Opcode::LDY_ZPX, { Opcode::LDY_ZPX, AddressingMode::ZPX, 4, core::HIGH}},
-        {Opcode::LDY_ABS, { Opcode::LDY_ABS, AddressingMode::ABS, 4, core::HIGH}},
-        {Opcode::LDY_ABSX, { Opcode::LDY_ABSX, AddressingMode::ABSX, 4, core::HIGH}},
-
-        {Opcode::STA_ZP, { Opcode::STA_ZP, AddressingMode::ZP, 3, core::LOW}},
-        {Opcode::STA_ZPX, { Opcode::STA_ZPX, AddressingMode::ZPX, 4, core::LOW}},
-        {Opcode::STA_ABS, { Opcode::STA_ABS, AddressingMode::ABS, 4, core::LOW}},
-        {Opcode::STA_ABSX, { Opcode::STA_ABSX, AddressingMode::ABSX, 5, core::LOW}},        
-        {Opcode::STA_ABSY, { Opcode::STA_ABSY, AddressingMode::ABSY, 5, core::LOW}},
-        {Opcode::STA_INDX, { Opcode::STA_INDX, AddressingMode::INDX, 6, core::LOW}},
-        {Opcode::STA_INDY, { Opcode::STA_INDY, AddressingMode::INDY, 6, core::LOW}},
-        {Opcode::STX_ZP, { Opcode::STX_ZP, AddressingMode::ZP, 3, core::LOW}},
-        {Opcode::STX_ZPY, { Opcode::STX_ZPY, AddressingMode::ZPY, 4, core::LOW}},
-        {Opcode::STX_ABS, { Opcode::STX_ABS, AddressingMode::ABS, 4, core::LOW}},
-        {Opcode::STY_ZP, { Opcode::STY_ZP, AddressingMode::ZP, 3, core::LOW}},
-        {Opcode::STY_ZPX, { Opcode::STY_ZPX, AddressingMode::ZPX, 4, core::LOW}},
-        {Opcode::STY_ABS, { Opcode::STY_ABS, AddressingMode::ABS, 4, core::LOW}},
+        {Opcode::LDA_IMM, AddressingMode::IMM, 2, core::HIGH},
+        {Opcode::LDA_ZP, AddressingMode::ZP, 3, core::HIGH},
+        {Opcode::LDA_ZPX, AddressingMode::ZPX, 4, core::HIGH},
+        {Opcode::LDA_ABS, AddressingMode::ABS, 4, core::HIGH},
+        {Opcode::LDA_ABSX, AddressingMode::ABSX, 4, core::HIGH},
+        {Opcode::LDA_ABSY, AddressingMode::ABSY, 4, core::HIGH},
+        {Opcode::LDA_INDX, AddressingMode::INDX, 6, core::HIGH},
+        {Opcode::LDA_INDY, AddressingMode::INDY, 5, core::HIGH},
+        {Opcode::LDA_ZPI, AddressingMode::ZPI, 5, core::HIGH},
+        {Opcode::LDX_IMM, AddressingMode::IMM, 2, core::HIGH},
+        {Opcode::LDX_ZP, AddressingMode::ZP, 3, core::HIGH},
+        {Opcode::LDX_ZPY, AddressingMode::ZPY, 4, core::HIGH},
+        {Opcode::LDX_ABS, AddressingMode::ABS, 4, core::HIGH},
+        {Opcode::LDX_ABSY, AddressingMode::ABSY, 4, core::HIGH},
+        {Opcode::LDY_IMM, AddressingMode::IMM, 2, core::HIGH},
+        {Opcode::LDY_ZP, AddressingMode::ZP, 3, core::HIGH},
+        {Opcode::LDY_ZPX, AddressingMode::ZPX, 4, core::HIGH},
+        {Opcode::LDY_ABS, AddressingMode::ABS, 4, core::HIGH},
+        {Opcode::LDY_ABSX, AddressingMode::ABSX, 4, core::HIGH},
+
+        {Opcode::STA_ZP, AddressingMode::ZP, 3, core::LOW},
+        {Opcode::STA_ZPX, AddressingMode::ZPX, 4, core::LOW},
+        {Opcode::STA_ABS, AddressingMode::ABS, 4, core::LOW},
+        {Opcode::STA_ABSX, AddressingMode::ABSX, 5, core::LOW},        
+        {Opcode::STA_ABSY, AddressingMode::ABSY, 5, core::LOW},
+        {Opcode::STA_INDX, AddressingMode::INDX, 6, core::LOW},
+        {Opcode::STA_INDY, AddressingMode::INDY, 6, core::LOW},
+        {Opcode::STA_ZPI, AddressingMode::ZPI, 5, core::LOW},
+        {Opcode::STX_ZP, AddressingMode::ZP, 3, core::LOW},
+        {Opcode::STX_ZPY, AddressingMode::ZPY, 4, core::LOW},
+        {Opcode::STX_ABS, AddressingMode::ABS, 4, core::LOW},
+        {Opcode::STY_ZP, AddressingMode::ZP, 3, core::LOW},
+        {Opcode::STY_ZPX, AddressingMode::ZPX, 4, core::LOW},
+        {Opcode::STY_ABS, AddressingMode::ABS, 4, core::LOW},
+        {Opcode::STZ_ZP, AddressingMode::ZP, 3, core::LOW},
+        {Opcode::STZ_ZPX, AddressingMode::ZPX, 4, core::LOW},
+        {Opcode::STZ_ABS, AddressingMode::ABS, 4, core::LOW},
+        {Opcode::STZ_ABSX, AddressingMode::ABSX, 5, core::LOW},
 
         // Register Transfers
-        {Opcode::TAX, { Opcode::TAX, AddressingMode::IMP, 2, core::HIGH}},
-        {Opcode::TXA, { Opcode::TXA, AddressingMode::IMP, 2, core::HIGH}},
-        {Opcode::DEX, { Opcode::DEX, AddressingMode::IMP, 2, core::HIGH}},
-        {Opcode::INX, { Opcode::INX, AddressingMode::IMP, 2, core::HIGH}},
-        {Opcode::TAY, { Opcode::TAY, AddressingMode::IMP, 2, core::HIGH}},
-        {Opcode::TYA, { Opcode::TYA, AddressingMode::IMP, 2, core::HIGH}},
-        {Opcode::DEY, { Opcode::DEY, AddressingMode::IMP, 2, core::HIGH}},
-        {Opcode::INY, { Opcode::INY, AddressingMode::IMP, 2, core::HIGH}},
+        {Opcode::TAX, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::TXA, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::DEX, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::INX, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::TAY, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::TYA, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::DEY, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::INY, AddressingMode::IMP, 2, core::HIGH},
 
         // Logical Operations
-        {Opcode::AND_IMM, { Opcode::AND_IMM, AddressingMode::IMM, 2, core::HIGH}},
-        {Opcode::AND_ZP, { Opcode::AND_ZP, AddressingMode::ZP, 3, core::HIGH}},
-        {Opcode::AND_ZPX, { Opcode::AND_ZPX, AddressingMode::ZPX, 4, core::HIGH}},
-        {Opcode::AND_ABS, { Opcode::AND_ABS, AddressingMode::ABS, 4, core::HIGH}},
-        {Opcode::AND_ABSX, { Opcode::AND_ABSX, AddressingMode::ABSX, 4, core::HIGH}},
-        {Opcode::AND_ABSY, { Opcode::AND_ABSY, AddressingMode::ABSY, 4, core::HIGH}},
-        {Opcode::AND_INDX, { Opcode::AND_INDX, AddressingMode::INDX, 6, core::HIGH}},
-        {Opcode::AND_INDY, { Opcode::AND_INDY, AddressingMode::INDY, 5, core::HIGH}},
-        {Opcode::EOR_IMM, { Opcode::EOR_IMM, AddressingMode::IMM, 2, core::HIGH}},
-        {Opcode::EOR_ZP, { Opcode::EOR_ZP, AddressingMode::ZP, 3, core::HIGH}},
-        {Opcode::EOR_ZPX, { Opcode::EOR_ZPX, AddressingMode::ZPX, 4, core::HIGH}},
-        {Opcode::EOR_ABS, { Opcode::EOR_ABS, AddressingMode::ABS, 4, core::HIGH}},
-        {Opcode::EOR_ABSX, { Opcode::EOR_ABSX, AddressingMode::ABSX, 4, core::HIGH}},
-        {Opcode::EOR_ABSY, { Opcode::EOR_ABSY, AddressingMode::ABSY, 4, core::HIGH}},
-        {Opcode::EOR_INDX, { Opcode::EOR_INDX, AddressingMode::INDX, 6, core::HIGH}},
-        {Opcode::EOR_INDY, { Opcode::EOR_INDY, AddressingMode::INDY, 5, core::HIGH}},
-        {Opcode::ORA_IMM, { Opcode::ORA_IMM, AddressingMode::IMM, 2, core::HIGH}},
-        {Opcode::ORA_ZP, { Opcode::ORA_ZP, AddressingMode::ZP, 3, core::HIGH}},
-        {Opcode::ORA_ZPX, { Opcode::ORA_ZPX, AddressingMode::ZPX, 4, core::HIGH}},
-        {Opcode::ORA_ABS, { Opcode::ORA_ABS, AddressingMode::ABS, 4, core::HIGH}},
-        {Opcode::ORA_ABSX, { Opcode::ORA_ABSX, AddressingMode::ABSX, 4, core::HIGH}},
-        {Opcode::ORA_ABSY, { Opcode::ORA_ABSY, AddressingMode::ABSY, 4, core::HIGH}},
-        {Opcode::ORA_INDX, { Opcode::ORA_INDX, AddressingMode::INDX, 6, core::HIGH}},
-        {Opcode::ORA_INDY, { Opcode::ORA_INDY, AddressingMode::INDY, 5, core::HIGH}},
-        {Opcode::BIT_ZP, { Opcode::BIT_ZP, AddressingMode::ZP, 3, core::HIGH}},
-        {Opcode::BIT_ABS, { Opcode::BIT_ABS, AddressingMode::ABS, 4, core::HIGH}},  
-        {Opcode::ADC_IMM, { Opcode::ADC_IMM, AddressingMode::IMM, 2, core::HIGH}},
-        {Opcode::ADC_ZP, { Opcode::ADC_ZP, AddressingMode::ZP, 3, core::HIGH}},
-        {Opcode::ADC_ZPX, { Opcode::ADC_ZPX, AddressingMode::ZPX, 4, core::HIGH}},
-        {Opcode::ADC_ABS, { Opcode::ADC_ABS, AddressingMode::ABS, 4, core::HIGH}},
-        {Opcode::ADC_ABSX, { Opcode::ADC_ABSX, AddressingMode::ABSX, 4, core::HIGH}},
-        {Opcode::ADC_ABSY, { Opcode::ADC_ABSY, AddressingMode::ABSY, 4, core::HIGH}},
-        {Opcode::ADC_INDX, { Opcode::ADC_INDX, AddressingMode::INDX, 6, core::HIGH}},
-        {Opcode::ADC_INDY, { Opcode::ADC_INDY, AddressingMode::INDY, 5, core::HIGH}},
-        {Opcode::SBC_IMM, { Opcode::SBC_IMM, AddressingMode::IMM, 2, core::HIGH}},
-        {Opcode::SBC_ZP, { Opcode::SBC_ZP, AddressingMode::ZP, 3, core::HIGH}},
-        {Opcode::SBC_ZPX, { Opcode::SBC_ZPX, AddressingMode::ZPX, 4, core::HIGH}},
-        {Opcode::SBC_ABS, { Opcode::SBC_ABS, AddressingMode::ABS, 4, core::HIGH}},
-        {Opcode::SBC_ABSX, { Opcode::SBC_ABSX, AddressingMode::ABSX, 4, core::HIGH}},
-        {Opcode::SBC_ABSY, { Opcode::SBC_ABSY, AddressingMode::ABSY, 4, core::HIGH}},
-        {Opcode::SBC_INDX, { Opcode::SBC_INDX, AddressingMode::INDX, 6, core::HIGH}},
-        {Opcode::SBC_INDY, { Opcode::SBC_INDY, AddressingMode::INDY, 5, core::HIGH}},
-        {Opcode::CMP_IMM, { Opcode::CMP_IMM, AddressingMode::IMM, 2, core::HIGH}},
-        {Opcode::CMP_ZP, { Opcode::CMP_ZP, AddressingMode::ZP, 3, core::HIGH}},
-        {Opcode::CMP_ZPX, { Opcode::CMP_ZPX, AddressingMode::ZPX, 4, core::HIGH}},
-        {Opcode::CMP_ABS, { Opcode::CMP_ABS, AddressingMode::ABS, 4, core::HIGH}},
-        {Opcode::CMP_ABSX, { Opcode::CMP_ABSX, AddressingMode::ABSX, 4, core::HIGH}},
-        {Opcode::CMP_ABSY, { Opcode::CMP_ABSY, AddressingMode::ABSY, 4, core::HIGH}},
-        {Opcode::CMP_INDX, { Opcode::CMP_INDX, AddressingMode::INDX, 6, core::HIGH}},
-        {Opcode::CMP_INDY, { Opcode::CMP_INDY, AddressingMode::INDY, 5, core::HIGH}},
-        {Opcode::CPX_IMM, { Opcode::CPX_IMM, AddressingMode::IMM, 2, core::HIGH}},
-        {Opcode::CPX_ZP, { Opcode::CPX_ZP, AddressingMode::ZP, 3, core::HIGH}},
-        {Opcode::CPX_ABS, { Opcode::CPX_ABS, AddressingMode::ABS, 4, core::HIGH}},
-        {Opcode::CPY_IMM, { Opcode::CPY_IMM, AddressingMode::IMM, 2, core::HIGH}},
-        {Opcode::CPY_ZP, { Opcode::CPY_ZP, AddressingMode::ZP, 3, core::HIGH}},
-        {Opcode::CPY_ABS, { Opcode::CPY_ABS, AddressingMode::ABS, 4, core::HIGH}},
+        {Opcode::AND_IMM, AddressingMode::IMM, 2, core::HIGH},
+        {Opcode::AND_ZP, AddressingMode::ZP, 3, core::HIGH},
+        {Opcode::AND_ZPX, AddressingMode::ZPX, 4, core::HIGH},
+        {Opcode::AND_ABS, AddressingMode::ABS, 4, core::HIGH},
+        {Opcode::AND_ABSX, AddressingMode::ABSX, 4, core::HIGH},
+        {Opcode::AND_ABSY, AddressingMode::ABSY, 4, core::HIGH},
+        {Opcode::AND_INDX, AddressingMode::INDX, 6, core::HIGH},
+        {Opcode::AND_INDY, AddressingMode::INDY, 5, core::HIGH},
+        {Opcode::AND_ZPI, AddressingMode::ZPI, 5, core::HIGH},
+        {Opcode::EOR_IMM, AddressingMode::IMM, 2, core::HIGH},
+        {Opcode::EOR_ZP, AddressingMode::ZP, 3, core::HIGH},
+        {Opcode::EOR_ZPX, AddressingMode::ZPX, 4, core::HIGH},
+        {Opcode::EOR_ABS, AddressingMode::ABS, 4, core::HIGH},
+        {Opcode::EOR_ABSX, AddressingMode::ABSX, 4, core::HIGH},
+        {Opcode::EOR_ABSY, AddressingMode::ABSY, 4, core::HIGH},
+        {Opcode::EOR_INDX, AddressingMode::INDX, 6, core::HIGH},
+        {Opcode::EOR_INDY, AddressingMode::INDY, 5, core::HIGH},
+        {Opcode::EOR_ZPI, AddressingMode::ZPI, 5, core::HIGH},
+        {Opcode::ORA_IMM, AddressingMode::IMM, 2, core::HIGH},
+        {Opcode::ORA_ZP, AddressingMode::ZP, 3, core::HIGH},
+        {Opcode::ORA_ZPX, AddressingMode::ZPX, 4, core::HIGH},
+        {Opcode::ORA_ABS, AddressingMode::ABS, 4, core::HIGH},
+        {Opcode::ORA_ABSX, AddressingMode::ABSX, 4, core::HIGH},
+        {Opcode::ORA_ABSY, AddressingMode::ABSY, 4, core::HIGH},
+        {Opcode::ORA_INDX, AddressingMode::INDX, 6, core::HIGH},
+        {Opcode::ORA_INDY, AddressingMode::INDY, 5, core::HIGH},
+        {Opcode::ORA_ZPI, AddressingMode::ZPI, 5, core::HIGH},
+        {Opcode::BIT_ZP, AddressingMode::ZP, 3, core::HIGH},
+        {Opcode::BIT_ABS, AddressingMode::ABS, 4, core::HIGH},  
+        {Opcode::BIT_IMM, AddressingMode::IMM, 2, core::HIGH},
+        {Opcode::BIT_ZPX, AddressingMode::ZPX, 4, core::HIGH},
+        {Opcode::BIT_ABSX, AddressingMode::ABSX, 4, core::HIGH},
+
+        // Test and Reset/Set Memory Bits
+        {Opcode::TRB_ZP, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::TRB_ABS, AddressingMode::ABS, 6, core::HIGH},
+        {Opcode::TSB_ZP, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::TSB_ABS, AddressingMode::ABS, 6, core::HIGH},
+        {Opcode::RMB0, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::RMB1, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::RMB2, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::RMB3, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::RMB4, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::RMB5, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::RMB6, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::RMB7, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::SMB0, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::SMB1, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::SMB2, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::SMB3, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::SMB4, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::SMB5, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::SMB6, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::SMB7, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::ADC_IMM, AddressingMode::IMM, 2, core::HIGH, 1},
+        {Opcode::ADC_ZP, AddressingMode::ZP, 3, core::HIGH, 1},
+        {Opcode::ADC_ZPX, AddressingMode::ZPX, 4, core::HIGH, 1},
+        {Opcode::ADC_ABS, AddressingMode::ABS, 4, core::HIGH, 1},
+        {Opcode::ADC_ABSX, AddressingMode::ABSX, 4, core::HIGH, 1},
+        {Opcode::ADC_ABSY, AddressingMode::ABSY, 4, core::HIGH, 1},
+        {Opcode::ADC_INDX, AddressingMode::INDX, 6, core::HIGH, 1},
+        {Opcode::ADC_INDY, AddressingMode::INDY, 5, core::HIGH, 1},
+        {Opcode::ADC_ZPI, AddressingMode::ZPI, 5, core::HIGH, 1},
+        {Opcode::SBC_IMM, AddressingMode::IMM, 2, core::HIGH, 1},
+        {Opcode::SBC_ZP, AddressingMode::ZP, 3, core::HIGH, 1},
+        {Opcode::SBC_ZPX, AddressingMode::ZPX, 4, core::HIGH, 1},
+        {Opcode::SBC_ABS, AddressingMode::ABS, 4, core::HIGH, 1},
+        {Opcode::SBC_ABSX, AddressingMode::ABSX, 4, core::HIGH, 1},
+        {Opcode::SBC_ABSY, AddressingMode::ABSY, 4, core::HIGH, 1},
+        {Opcode::SBC_INDX, AddressingMode::INDX, 6, core::HIGH, 1},
+        {Opcode::SBC_INDY, AddressingMode::INDY, 5, core::HIGH, 1},
+        {Opcode::SBC_ZPI, AddressingMode::ZPI, 5, core::HIGH, 1},
+        {Opcode::CMP_IMM, AddressingMode::IMM, 2, core::HIGH},
+        {Opcode::CMP_ZP, AddressingMode::ZP, 3, core::HIGH},
+        {Opcode::CMP_ZPX, AddressingMode::ZPX, 4, core::HIGH},
+        {Opcode::CMP_ABS, AddressingMode::ABS, 4, core::HIGH},
+        {Opcode::CMP_ABSX, AddressingMode::ABSX, 4, core::HIGH},
+        {Opcode::CMP_ABSY, AddressingMode::ABSY, 4, core::HIGH},
+        {Opcode::CMP_INDX, AddressingMode::INDX, 6, core::HIGH},
+        {Opcode::CMP_INDY, AddressingMode::INDY, 5, core::HIGH},
+        {Opcode::CMP_ZPI, AddressingMode::ZPI, 5, core::HIGH},
+        {Opcode::CPX_IMM, AddressingMode::IMM, 2, core::HIGH},
+        {Opcode::CPX_ZP, AddressingMode::ZP, 3, core::HIGH},
+        {Opcode::CPX_ABS, AddressingMode::ABS, 4, core::HIGH},
+        {Opcode::CPY_IMM, AddressingMode::IMM, 2, core::HIGH},
+        {Opcode::CPY_ZP, AddressingMode::ZP, 3, core::HIGH},
+        {Opcode::CPY_ABS, AddressingMode::ABS, 4, core::HIGH},
 
         // Increments & Decrements
-        {Opcode::INC_ACC, { Opcode::INC_ACC, AddressingMode::ACC, 2, core::HIGH}},
-        {Opcode::INC_ZP, { Opcode::INC_ZP, AddressingMode::ZP, 5, core::HIGH}},
-        {Opcode::INC_ZPX, { Opcode::INC_ZPX, AddressingMode::ZPX, 6, core::HIGH}},
-        {Opcode::INC_ABS, { Opcode::INC_ABS, AddressingMode::ABS, 6, core::HIGH}},
-        {Opcode::INC_ABSX, { Opcode::INC_ABSX, AddressingMode::ABSX, 7, core::HIGH}},
-        {Opcode::DEC_ACC, { Opcode::DEC_ACC, AddressingMode::ACC, 2, core::HIGH}},
-        {Opcode::DEC_ZP, { Opcode::DEC_ZP, AddressingMode::ZP, 5, core::HIGH}},
-        {Opcode::DEC_ZPX, { Opcode::DEC_ZPX, AddressingMode::ZPX, 6, core::HIGH}},
-        {Opcode::DEC_ABS, { Opcode::DEC_ABS, AddressingMode::ABS, 6, core::HIGH}},
-        {Opcode::DEC_ABSX, { Opcode::DEC_ABSX, AddressingMode::ABSX, 7, core::HIGH}},
-        {Opcode::ASL_ACC, { Opcode::ASL_ACC, AddressingMode::ACC, 2, core::HIGH}},
-        {Opcode::ASL_ZP, { Opcode::ASL_ZP, AddressingMode::ZP, 5, core::HIGH}},
-        {Opcode::ASL_ZPX, { Opcode::ASL_ZPX, AddressingMode::ZPX, 6, core::HIGH}},
-        {Opcode::ASL_ABS, { Opcode::ASL_ABS, AddressingMode::ABS, 6, core::HIGH}},
-        {Opcode::ASL_ABSX, { Opcode::ASL_ABSX, AddressingMode::ABSX, 7, core::HIGH}},
-        {Opcode::LSR_ACC, { Opcode::LSR_ACC, AddressingMode::ACC, 2, core::HIGH}},
-        {Opcode::LSR_ZP, { Opcode::LSR_ZP, AddressingMode::ZP, 5, core::HIGH}},
-        {Opcode::LSR_ZPX, { Opcode::LSR_ZPX, AddressingMode::ZPX, 6, core::HIGH}},
-        {Opcode::LSR_ABS, { Opcode::LSR_ABS, AddressingMode::ABS, 6, core::HIGH}},
-        {Opcode::LSR_ABSX, { Opcode::LSR_ABSX, AddressingMode::ABSX, 7, core::HIGH}},
-        {Opcode::ROL_ACC, { Opcode::ROL_ACC, AddressingMode::ACC, 2, core::HIGH}},
-        {Opcode::ROL_ZP, { Opcode::ROL_ZP, AddressingMode::ZP, 5, core::HIGH}},
-        {Opcode::ROL_ZPX, { Opcode::ROL_ZPX, AddressingMode::ZPX, 6, core::HIGH}},
-        {Opcode::ROL_ABS, { Opcode::ROL_ABS, AddressingMode::ABS, 6, core::HIGH}},
-        {Opcode::ROL_ABSX, { Opcode::ROL_ABSX, AddressingMode::ABSX, 7, core::HIGH}},
-        {Opcode::ROR_ACC, { Opcode::ROR_ACC, AddressingMode::ACC, 2, core::HIGH}},
-        {Opcode::ROR_ZP, { Opcode::ROR_ZP, AddressingMode::ZP, 5, core::HIGH}},
-        {Opcode::ROR_ZPX, { Opcode::ROR_ZPX, AddressingMode::ZPX, 6, core::HIGH}},
-        {Opcode::ROR_ABS, { Opcode::ROR_ABS, AddressingMode::ABS, 6, core::HIGH}},
-        {Opcode::ROR_ABSX, { Opcode::ROR_ABSX, AddressingMode::ABSX, 7, core::HIGH}},
+        {Opcode::INC_ACC, AddressingMode::ACC, 2, core::HIGH},
+        {Opcode::INC_ZP, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::INC_ZPX, AddressingMode::ZPX, 6, core::HIGH},
+        {Opcode::INC_ABS, AddressingMode::ABS, 6, core::HIGH},
+        {Opcode::INC_ABSX, AddressingMode::ABSX, 7, core::HIGH},
+        {Opcode::DEC_ACC, AddressingMode::ACC, 2, core::HIGH},
+        {Opcode::DEC_ZP, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::DEC_ZPX, AddressingMode::ZPX, 6, core::HIGH},
+        {Opcode::DEC_ABS, AddressingMode::ABS, 6, core::HIGH},
+        {Opcode::DEC_ABSX, AddressingMode::ABSX, 7, core::HIGH},
+        {Opcode::ASL_ACC, AddressingMode::ACC, 2, core::HIGH},
+        {Opcode::ASL_ZP, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::ASL_ZPX, AddressingMode::ZPX, 6, core::HIGH},
+        {Opcode::ASL_ABS, AddressingMode::ABS, 6, core::HIGH},
+        {Opcode::ASL_ABSX, AddressingMode::ABSX, 7, core::HIGH},
+        {Opcode::LSR_ACC, AddressingMode::ACC, 2, core::HIGH},
+        {Opcode::LSR_ZP, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::LSR_ZPX, AddressingMode::ZPX, 6, core::HIGH},
+        {Opcode::LSR_ABS, AddressingMode::ABS, 6, core::HIGH},
+        {Opcode::LSR_ABSX, AddressingMode::ABSX, 7, core::HIGH},
+        {Opcode::ROL_ACC, AddressingMode::ACC, 2, core::HIGH},
+        {Opcode::ROL_ZP, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::ROL_ZPX, AddressingMode::ZPX, 6, core::HIGH},
+        {Opcode::ROL_ABS, AddressingMode::ABS, 6, core::HIGH},
+        {Opcode::ROL_ABSX, AddressingMode::ABSX, 7, core::HIGH},
+        {Opcode::ROR_ACC, AddressingMode::ACC, 2, core::HIGH},
+        {Opcode::ROR_ZP, AddressingMode::ZP, 5, core::HIGH},
+        {Opcode::ROR_ZPX, AddressingMode::ZPX, 6, core::HIGH},
+        {Opcode::ROR_ABS, AddressingMode::ABS, 6, core::HIGH},
+        {Opcode::ROR_ABSX, AddressingMode::ABSX, 7, core::HIGH},
 
         // Stack Operations
-        {Opcode::TSX, { Opcode::TSX, AddressingMode::IMP, 2, core::HIGH}},
-        {Opcode::TXS, { Opcode::TXS, AddressingMode::IMP, 2, core::HIGH}},
-        {Opcode::PHA, { Opcode::PHA, AddressingMode::IMP, 3, core::LOW}},
-        {Opcode::PLA, { Opcode::PLA, AddressingMode::IMP, 4, core::HIGH}},
-        {Opcode::PHP, { Opcode::PHP, AddressingMode::IMP, 3, core::LOW}},
-        {Opcode::PLP, { Opcode::PLP, AddressingMode::IMP, 4, core::HIGH}},
+        {Opcode::TSX, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::TXS, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::PHA, AddressingMode::IMP, 3, core::LOW},
+        {Opcode::PLA, AddressingMode::IMP, 4, core::HIGH},
+        {Opcode::PHP, AddressingMode::IMP, 3, core::LOW},
+        {Opcode::PLP, AddressingMode::IMP, 4, core::HIGH},
+        {Opcode::PHX, AddressingMode::IMP, 3, core::LOW},
+        {Opcode::PLX, AddressingMode::IMP, 4, core::HIGH},
+        {Opcode::PHY, AddressingMode::IMP, 3, core::LOW},
+        {Opcode::PLY, AddressingMode::IMP, 4, core::HIGH},
 
         // Jump & Calls
-        {Opcode::JMP_ABS, { Opcode::JMP_ABS, AddressingMode::ABS, 3, core::HIGH}},
-        {Opcode::JMP_IND, { Opcode::JMP_IND, AddressingMode::IND, 5, core::HIGH}},
-        {Opcode::JSR, { Opcode::JSR, AddressingMode::ABS, 6, core::LOW}},
-        {Opcode::RTS, { Opcode::RTS, AddressingMode::IMP, 6, core::LOW}},
+        {Opcode::JMP_ABS, AddressingMode::ABS, 3, core::HIGH},
+        {Opcode::JMP_IND, AddressingMode::IND, 5, core::HIGH},
+        {Opcode::JMP_IAX, AddressingMode::IAX, 6, core::HIGH},
+        {Opcode::JSR, AddressingMode::ABS, 6, core::LOW},
+        {Opcode::RTS, AddressingMode::IMP, 6, core::LOW},
+
+        // Branches, cycles when not taken. Taking one adds a cycle, and another when the target is on a
+        // different page than the next instruction. BRA is always taken.
+        {Opcode::BPL, AddressingMode::REL, 2, core::HIGH},
+        {Opcode::BMI, AddressingMode::REL, 2, core::HIGH},
+        {Opcode::BVC, AddressingMode::REL, 2, core::HIGH},
+        {Opcode::BVS, AddressingMode::REL, 2, core::HIGH},
+        {Opcode::BCC, AddressingMode::REL, 2, core::HIGH},
+        {Opcode::BCS, AddressingMode::REL, 2, core::HIGH},
+        {Opcode::BNE, AddressingMode::REL, 2, core::HIGH},
+        {Opcode::BEQ, AddressingMode::REL, 2, core::HIGH},
+        {Opcode::BRA, AddressingMode::REL, 2, core::HIGH},
+        {Opcode::BBR0, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBR1, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBR2, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBR3, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBR4, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBR5, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBR6, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBR7, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBS0, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBS1, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBS2, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBS3, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBS4, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBS5, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBS6, AddressingMode::ZPR, 5, core::HIGH},
+        {Opcode::BBS7, AddressingMode::ZPR, 5, core::HIGH},
 
-        // Branches
-        {Opcode::BPL, { Opcode::BPL, AddressingMode::REL, 4, core::HIGH}},
-        {Opcode::BMI, { Opcode::BMI, AddressingMode::REL, 4, core::HIGH}},
-        {Opcode::BVC, { Opcode::BVC, AddressingMode::REL, 4, core::HIGH}},
-        {Opcode::BVS, { Opcode::BVS, AddressingMode::REL, 4, core::HIGH}},
-        {Opcode::BCC, { Opcode::BCC, AddressingMode::REL, 4, core::HIGH}},
-        {Opcode::BCS, { Opcode::BCS, AddressingMode::REL, 4, core::HIGH}},
-        {Opcode::BNE, { Opcode::BNE, AddressingMode::REL, 4, core::HIGH}},
-        {Opcode::BEQ, { Opcode::BEQ, AddressingMode::REL, 4, core::HIGH}},
-
-
-        
-        {Opcode::NOP, {Opcode::NOP, AddressingMode::IMP, 2, core::HIGH}},
-        {Opcode::BRK, {Opcode::BRK, AddressingMode::IMP, 7, core::HIGH}},
-        {Opcode::RTI, {Opcode::RTI, AddressingMode::IMP, 6, core::HIGH}},
+        // Status Flag Changes
+        {Opcode::CLC, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::SEC, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::CLI, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::SEI, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::CLV, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::CLD, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::SED, AddressingMode::IMP, 2, core::HIGH},
+
+        // System Functions
+        {Opcode::NOP, AddressingMode::IMP, 2, core::HIGH},
+        {Opcode::BRK, AddressingMode::IMP, 7, core::HIGH},
+        {Opcode::RTI, AddressingMode::IMP, 6, core::HIGH},
+        {Opcode::WAI, AddressingMode::IMP, 3, core::HIGH},
+        {Opcode::STP, AddressingMode::IMP, 3, core::HIGH},
     };
-}
\ No newline at end of file
+
+    // The W65C02S executes every byte it assigns no instruction to as a NOP. Each one takes the length and
+    // cycles of its column: xx02 skips an immediate byte, xx03 and xx0B take a single cycle, 44, 54, D4
+    // and F4 read a zero page operand, DC and FC an absolute one, and 5C fetches an absolute operand it
+    // does not read, then takes five more cycles.
+    constexpr OpcodeInfo makeReservedOpcodeInfo(uint8_t value)
+    {
+        const auto opcode = static_cast<Opcode>(value);
+        switch (value)
+        {
+            case 0x44:
+                return { opcode, AddressingMode::ZP, 3, core::HIGH, 0, true };
+            case 0x54:
+            case 0xD4:
+            case 0xF4:
+                return { opcode, AddressingMode::ZPX, 4, core::HIGH, 0, true };
+            case 0x5C:
+                return { opcode, AddressingMode::ABS, 8, core::HIGH, 0, true };
+            case 0xDC:
+            case 0xFC:
+                return { opcode, AddressingMode::ABS, 4, core::HIGH, 0, true };
+            default:
+                break;
+        }
+        if ((value & 0x0F) == 0x02)
+        {
+            return { opcode, AddressingMode::IMM, 2, core::HIGH, 0, true };
+        }
+        return { opcode, AddressingMode::IMP, 1, core::HIGH, 0, true };
+    }
+
+    // Dense decode table indexed by the opcode byte, generated at compile time from ImplementedOpcodes
+    // and the reserved NOPs
+    constexpr std::array<OpcodeInfo, 256> makeOpcodeTable()
+    {
+        std::array<OpcodeInfo, 256> table{};
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            table[i] = makeReservedOpcodeInfo(static_cast<uint8_t>(i));
+        }
+        for (const auto& info : ImplementedOpcodes)
+        {
+            table[static_cast<uint8_t>(info.opcode)] = info;
+        }
+        return table;
+    }
+
+    inline constexpr std::array<OpcodeInfo, 256> OpcodeTable = makeOpcodeTable();
+
+    constexpr const OpcodeInfo& decodeOpcode(Opcode opcode)
+    {
+        return OpcodeTable[static_cast<uint8_t>(opcode)];
+    }
+
+    // Bytes taken by an instruction, including the opcode
+    constexpr uint8_t instructionLength(AddressingMode mode)
+    {
+        switch (mode)
+        {
+            case AddressingMode::IMP:
+            case AddressingMode::ACC:
+                return 1;
+            case AddressingMode::ABS:
+            case AddressingMode::ABSX:
+            case AddressingMode::ABSY:
+            case AddressingMode::IND:
+            case AddressingMode::IAX:
+            case AddressingMode::ZPR:
+                return 3;
+            default:
+                return 2;
+        }
+    }
+
+    // Cycles a taken branch adds, given the address of the next instruction and the branch target
+    constexpr uint8_t branchTakenCycles(uint16_t next, uint16_t target)
+    {
+        return ((next ^ target) & 0xFF00) != 0 ? 2 : 1;
+    }
+
+    constexpr size_t countReservedOpcodes()
+    {
+        size_t count = 0;
+        for (const auto& info : OpcodeTable)
+        {
+            count += info.reserved ? 1 : 0;
+        }
+        return count;
+    }
+    static_assert(countReservedOpcodes() + std::size(ImplementedOpcodes) == 256, "Duplicate opcode in ImplementedOpcodes");
+    static_assert(countReservedOpcodes() == 44, "The W65C02S leaves 44 opcodes unassigned");
+
+    // Longest instruction, the reserved NOP 5C. A taken BBR or BBS across a page takes 7.
+    constexpr uint8_t maxInstructionCycles()
+    {
+        uint8_t cycles = 0;
+        for (const auto& info : OpcodeTable)
+        {
+            cycles = std::max<uint8_t>(cycles, info.cycles + info.decimalCycles);
+        }
+        return cycles;
+    }
+}
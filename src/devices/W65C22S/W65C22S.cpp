@@ -3,26 +3,30 @@
 
 #include "core/bus.h"
 #include "core/defines.h"
+#include "core/trace.h"
 #include "spdlog/spdlog.h"
 #include <cstdint>
 #include <sys/types.h>
 
 namespace EaterEmulator::devices
 {
-    W65C22S::W65C22S(std::shared_ptr<core::Bus> bus) 
-        : core::BusSlave(bus, 0x6000)
+    W65C22S::W65C22S(std::shared_ptr<core::Bus> bus, core::AddressRange range) 
+        : core::BusSlave(bus, range.start), _range(range)
     {
     }
 
     W65C22S::~W65C22S() 
     {
-        spdlog::debug("W65C22S destroyed.");
+        // Pending timer events hold this device
+        cancelEvent(_t1Event);
+        cancelEvent(_t2Event);
+        log().debug("W65C22S destroyed.");
     }
 
     void W65C22S::handleBusNotification(uint16_t address, uint8_t rwb)
     {
         if (!shouldHandleAddress(address)) {
-            spdlog::debug("W65C22S: Address {:#04x} not handled by this device", address);
+            EATER_TRACE("W65C22S: Address {:#04x} not handled by this device", address);
             return; // If the pins are not for this device, do nothing
         }
 
@@ -39,16 +43,29 @@ namespace EaterEmulator::devices
 
     bool W65C22S::shouldHandleAddress(const uint16_t& address) const
     {
-        // Decode address from the address bus and check if it falls within the range of this VIA
-        // VIA is mapped to addresses 0x6000 to 0x7FFF so only if A13 and A14 are HIGH and A15 is LOW
-        // To avoid collision with ACIA, A12 must be LOW.
-        return (address & (1 << 15)) == 0 && (address & (1 << 14)) != 0 && (address & (1 << 13)) != 0 && (address & (1 << 12)) == 0; 
+        // On Ben Eater's board the VIA is selected when A13 and A14 are HIGH and A15 and A12 are LOW
+        return address >= _range.start && address <= _range.end;
+    }
+
+    std::vector<core::AddressRange> W65C22S::getAddressRanges() const
+    {
+        return { _range };
     }
 
     bool W65C22S::handleRead(Register reg)
     {
         uint8_t data = readRegister(reg);
         _bus->setData(data);
+
+        // Reading the low counter bytes acknowledges the timer interrupts
+        if (reg == Register::T1CL)
+        {
+            clearInterruptFlags(IRQ_T1);
+        }
+        else if (reg == Register::T2CL)
+        {
+            clearInterruptFlags(IRQ_T2);
+        }
         return true;
     }
 
@@ -81,23 +98,78 @@ namespace EaterEmulator::devices
                 ddrMask = _ddrA;
                 return true;
             case Register::T1CL:
-            case Register::T1CH:
             case Register::T1LL:
+                _t1ll = data;
+                return true;
+            case Register::T1CH:
+                _t1lh = data;
+                startTimer1();
+                return true;
             case Register::T1LH:
+                _t1lh = data;
+                clearInterruptFlags(IRQ_T1);
+                return true;
             case Register::T2CL:
+                _t2ll = data;
+                return true;
             case Register::T2CH:
-            case Register::SR:
+                _t2Value = static_cast<uint16_t>((data << 8) | _t2ll);
+                startTimer2();
+                return true;
             case Register::ACR:
+                if ((data ^ _acr) & ACR_T2_PULSE_COUNT)
+                {
+                    // Carry the current T2 count over to the new mode
+                    if (data & ACR_T2_PULSE_COUNT)
+                    {
+                        _t2Value = timer2Counter();
+                        cancelEvent(_t2Event);
+                    }
+                    else
+                    {
+                        _t2Start = _bus->getScheduler().now();
+                        if (_t2Armed)
+                        {
+                            _t2Event = _bus->getScheduler().schedule(_t2Start + _t2Value + 1, [this](uint64_t cycle) { onTimer2Expired(cycle); });
+                        }
+                    }
+                }
+                _acr = data;
+                return true;
+            case Register::SR:
+                // Shift register is not emulated, the value is only stored
+                _sr = data;
+                return true;
             case Register::PCR:
+                _pcr = data;
+                return true;
             case Register::IFR:
+                // Writing a 1 clears the flag
+                clearInterruptFlags(data & ~IRQ_ANY);
+                return true;
             case Register::IER:
-                return false;
+                // Bit 7 selects whether the other set bits enable or disable their interrupt
+                if (data & IRQ_ANY)
+                {
+                    _ier |= data & ~IRQ_ANY;
+                }
+                else
+                {
+                    _ier &= ~data;
+                }
+                updateIRQ();
+                return true;
             default:
-                spdlog::error("W65C22S: Invalid register for write operation: {:#04x}", static_cast<int>(reg));
+                log().error("W65C22S: Invalid register for write operation: {:#04x}", static_cast<int>(reg));
                 return false;
         }
 
-        data = data & ddrMask;
+        writeToPeripheral(viaPort, data & ddrMask);
+        return true;
+    }
+
+    void W65C22S::writeToPeripheral(Port viaPort, uint8_t data)
+    {
         if (connections.count(viaPort)) 
         {
             auto& conn = connections.at(viaPort);
@@ -106,8 +178,6 @@ namespace EaterEmulator::devices
                 device.writeToPort(conn.peripheralPortId, data);
             }, conn.device);
         }
-
-        return true;
     }
 
     uint8_t W65C22S::readRegister(Register reg)
@@ -118,21 +188,197 @@ namespace EaterEmulator::devices
             case Register::DATA_A: return _dataA;
             case Register::DDR_B: return _ddrB;
             case Register::DDR_A: return _ddrA;
-            case Register::T1CL: return _t1cl;
-            case Register::T1CH: return _t1ch;
+            case Register::T1CL: return static_cast<uint8_t>(timer1Counter());
+            case Register::T1CH: return static_cast<uint8_t>(timer1Counter() >> 8);
             case Register::T1LL: return _t1ll;
             case Register::T1LH: return _t1lh;
-            case Register::T2CL: return _t2cl;
-            case Register::T2CH: return _t2ch;
+            case Register::T2CL: return static_cast<uint8_t>(timer2Counter());
+            case Register::T2CH: return static_cast<uint8_t>(timer2Counter() >> 8);
             case Register::SR: return _sr;
             case Register::ACR: return _acr;
             case Register::PCR: return _pcr;
-            case Register::IFR: return _ifr;
-            case Register::IER: return _ier;
+            case Register::IFR: return _ifr | ((_ifr & _ier) != 0 ? IRQ_ANY : 0);
+            case Register::IER: return _ier | IRQ_ANY;
             case Register::DATA_A2: return _dataA;
             default:
-                spdlog::error("W65C22S: Invalid register: {:#04x}", static_cast<int>(reg));
+                log().error("W65C22S: Invalid register: {:#04x}", static_cast<int>(reg));
                 return _dataA;
         }
     }
-} // namespace EaterEmulator
\ No newline at end of file
+
+    void W65C22S::saveState(core::StateWriter& writer) const
+    {
+        writer.write(_dataA);
+        writer.write(_dataB);
+        writer.write(_ddrA);
+        writer.write(_ddrB);
+        writer.write(_t1ll);
+        writer.write(_t1lh);
+        writer.write(_t2ll);
+        writer.write(_sr);
+        writer.write(_acr);
+        writer.write(_pcr);
+        writer.write(_ifr);
+        writer.write(_ier);
+        writer.write(_irqAsserted);
+        writer.write(_t1Start);
+        writer.write(_t1Value);
+        writer.write(_t1Event.has_value());
+        writer.write(_t2Start);
+        writer.write(_t2Value);
+        writer.write(_t2Armed);
+        writer.write(_t2Event.has_value());
+    }
+
+    void W65C22S::loadState(core::StateReader& reader)
+    {
+        _dataA = reader.read<uint8_t>();
+        _dataB = reader.read<uint8_t>();
+        _ddrA = reader.read<uint8_t>();
+        _ddrB = reader.read<uint8_t>();
+        _t1ll = reader.read<uint8_t>();
+        _t1lh = reader.read<uint8_t>();
+        _t2ll = reader.read<uint8_t>();
+        _sr = reader.read<uint8_t>();
+        _acr = reader.read<uint8_t>();
+        _pcr = reader.read<uint8_t>();
+        _ifr = reader.read<uint8_t>();
+        _ier = reader.read<uint8_t>();
+        // The CPU restores its own IRQ line, so the peripheral is not written
+        _irqAsserted = reader.read<bool>();
+        _t1Start = reader.read<uint64_t>();
+        _t1Value = reader.read<uint16_t>();
+        const bool t1Pending = reader.read<bool>();
+        _t2Start = reader.read<uint64_t>();
+        _t2Value = reader.read<uint16_t>();
+        _t2Armed = reader.read<bool>();
+        const bool t2Pending = reader.read<bool>();
+
+        // A pending expiry is always due when the counter it was scheduled for reaches zero
+        cancelEvent(_t1Event);
+        cancelEvent(_t2Event);
+        if (t1Pending)
+        {
+            _t1Event = _bus->getScheduler().schedule(_t1Start + _t1Value + 1, [this](uint64_t cycle) { onTimer1Expired(cycle); });
+        }
+        if (t2Pending)
+        {
+            _t2Event = _bus->getScheduler().schedule(_t2Start + _t2Value + 1, [this](uint64_t cycle) { onTimer2Expired(cycle); });
+        }
+    }
+
+    void W65C22S::pulsePB6()
+    {
+        if (!(_acr & ACR_T2_PULSE_COUNT))
+        {
+            return;
+        }
+        _t2Value--;
+        if (_t2Value == 0 && _t2Armed)
+        {
+            _t2Armed = false;
+            setInterruptFlags(IRQ_T2);
+        }
+    }
+
+    void W65C22S::startTimer1()
+    {
+        // Loading T1 transfers the latches into the counter and acknowledges its interrupt
+        cancelEvent(_t1Event);
+        clearInterruptFlags(IRQ_T1);
+        _t1Value = static_cast<uint16_t>((_t1lh << 8) | _t1ll);
+        _t1Start = _bus->getScheduler().now();
+        // The counter counts N..0 and the flag is set as it rolls over to 0xFFFF
+        _t1Event = _bus->getScheduler().schedule(_t1Start + _t1Value + 1, [this](uint64_t cycle) { onTimer1Expired(cycle); });
+    }
+
+    void W65C22S::startTimer2()
+    {
+        cancelEvent(_t2Event);
+        clearInterruptFlags(IRQ_T2);
+        _t2Armed = true;
+        if (_acr & ACR_T2_PULSE_COUNT)
+        {
+            return; // Counted down by pulsePB6
+        }
+        _t2Start = _bus->getScheduler().now();
+        _t2Event = _bus->getScheduler().schedule(_t2Start + _t2Value + 1, [this](uint64_t cycle) { onTimer2Expired(cycle); });
+    }
+
+    uint16_t W65C22S::timer1Counter() const
+    {
+        const auto now = _bus->getScheduler().now();
+        if (now < _t1Start)
+        {
+            // Free-run reload cycle, the counter still shows the rollover
+            return 0xFFFF;
+        }
+        // One-shot mode keeps counting down past zero; free-run is rebased on every reload
+        return static_cast<uint16_t>(_t1Value - (now - _t1Start));
+    }
+
+    uint16_t W65C22S::timer2Counter() const
+    {
+        if (_acr & ACR_T2_PULSE_COUNT)
+        {
+            return _t2Value;
+        }
+        return static_cast<uint16_t>(_t2Value - (_bus->getScheduler().now() - _t2Start));
+    }
+
+    void W65C22S::onTimer1Expired(uint64_t cycle)
+    {
+        _t1Event.reset();
+        setInterruptFlags(IRQ_T1);
+        if (_acr & ACR_T1_FREE_RUN)
+        {
+            // Reload from the latches on the cycle after the rollover, for a period of N + 2 cycles
+            _t1Value = static_cast<uint16_t>((_t1lh << 8) | _t1ll);
+            _t1Start = cycle + 1;
+            _t1Event = _bus->getScheduler().schedule(_t1Start + _t1Value + 1, [this](uint64_t next) { onTimer1Expired(next); });
+        }
+    }
+
+    void W65C22S::onTimer2Expired([[maybe_unused]] uint64_t cycle)
+    {
+        // T2 only interrupts once per load and keeps counting down
+        _t2Event.reset();
+        if (_t2Armed)
+        {
+            _t2Armed = false;
+            setInterruptFlags(IRQ_T2);
+        }
+    }
+
+    void W65C22S::cancelEvent(std::optional<core::Scheduler::EventId>& event)
+    {
+        if (event)
+        {
+            _bus->getScheduler().cancel(*event);
+            event.reset();
+        }
+    }
+
+    void W65C22S::setInterruptFlags(uint8_t flags)
+    {
+        _ifr |= flags;
+        updateIRQ();
+    }
+
+    void W65C22S::clearInterruptFlags(uint8_t flags)
+    {
+        _ifr &= ~flags;
+        updateIRQ();
+    }
+
+    void W65C22S::updateIRQ()
+    {
+        const bool asserted = (_ifr & _ier & ~IRQ_ANY) != 0;
+        if (asserted != _irqAsserted)
+        {
+            _irqAsserted = asserted;
+            // IRQB is active low
+            writeToPeripheral(Port::IRQ, asserted ? core::LOW : core::HIGH);
+        }
+    }
+} // namespace EaterEmulator
@@ -2,11 +2,14 @@
 
 #include "core/bus_slave.h"
 #include "core/defines.h"
+#include "core/scheduler.h"
+#include "core/state.h"
 
 #include "devices/HD44780LCD/LCDAdapter.h"
 #include "devices/W65C02S/CPUAdapter.h"
 
 #include <map>
+#include <optional>
 #include <variant>
 
 namespace EaterEmulator::devices
@@ -14,7 +17,7 @@ namespace EaterEmulator::devices
     using Peripherals = std::variant<LCDAdapter, CPUAdapter>;
 
     // VIA 6522 is a versatile I/O expander
-    class W65C22S : public core::BusSlave
+    class W65C22S : public core::BusSlave, public core::Stateful
     {
     public:
         enum class Register
@@ -44,10 +47,28 @@ namespace EaterEmulator::devices
             CB1,
             CB2,
             CA1,
-            CA2
+            CA2,
+            IRQ // IRQB output, written LOW while an enabled interrupt flag is set
         };
 
-        W65C22S(std::shared_ptr<core::Bus> bus);
+        // Interrupt flag and enable bits
+        static constexpr uint8_t IRQ_CA2 = 0x01;
+        static constexpr uint8_t IRQ_CA1 = 0x02;
+        static constexpr uint8_t IRQ_SR = 0x04;
+        static constexpr uint8_t IRQ_CB2 = 0x08;
+        static constexpr uint8_t IRQ_CB1 = 0x10;
+        static constexpr uint8_t IRQ_T2 = 0x20;
+        static constexpr uint8_t IRQ_T1 = 0x40;
+        static constexpr uint8_t IRQ_ANY = 0x80;
+
+        // Auxiliary control register bits
+        static constexpr uint8_t ACR_T2_PULSE_COUNT = 0x20;
+        static constexpr uint8_t ACR_T1_FREE_RUN = 0x40;
+
+        // Where Ben Eater's board decodes the VIA. The registers repeat every 16 bytes of the range.
+        static constexpr core::AddressRange DEFAULT_RANGE{0x6000, 0x6FFF};
+
+        W65C22S(std::shared_ptr<core::Bus> bus, core::AddressRange range = DEFAULT_RANGE);
         virtual ~W65C22S();
 
         W65C22S(const W65C22S&) = delete;
@@ -59,14 +80,23 @@ namespace EaterEmulator::devices
         void handleBusNotification(uint16_t address, uint8_t rwb) override;
 
         bool shouldHandleAddress(const uint16_t& address) const override;
+
+        std::vector<core::AddressRange> getAddressRanges() const override;
         
         std::string getName() const override { return "W65C22S"; }
 
+        // Registers and timers. Pending timer events are scheduled again on restore.
+        void saveState(core::StateWriter& writer) const override;
+        void loadState(core::StateReader& reader) override;
+
         void connect(Port viaPort, core::Peripheral auto device, int peripheralPortId)
         {
             connections[viaPort] = {device, peripheralPortId};
         }
 
+        // Falling edge on PB6, counted down by T2 in pulse counting mode
+        void pulsePB6();
+
     private:
         struct Connection {
             Peripherals device;
@@ -75,22 +105,47 @@ namespace EaterEmulator::devices
         std::map<Port, Connection> connections;
         bool handleRead(Register reg);
         bool handleWrite(Register reg);
+        void writeToPeripheral(Port viaPort, uint8_t data);
 
         uint8_t readRegister(Register reg);
-        uint8_t _dataA;
-        uint8_t _dataB;
-        uint8_t _ddrA;
-        uint8_t _ddrB;
-        uint8_t _t1cl;
-        uint8_t _t1ch;
-        uint8_t _t1ll;
-        uint8_t _t1lh;
-        uint8_t _t2cl;
-        uint8_t _t2ch;
-        uint8_t _sr;
-        uint8_t _acr;
-        uint8_t _pcr;
-        uint8_t _ifr;
-        uint8_t _ier;
+
+        // Timers only store the cycle they were loaded on; the counters are computed from the elapsed
+        // cycles when read and expiry is an event on the bus scheduler, so idle timers cost nothing.
+        void startTimer1();
+        void startTimer2();
+        uint16_t timer1Counter() const;
+        uint16_t timer2Counter() const;
+        void onTimer1Expired(uint64_t cycle);
+        void onTimer2Expired(uint64_t cycle);
+        void cancelEvent(std::optional<core::Scheduler::EventId>& event);
+
+        void setInterruptFlags(uint8_t flags);
+        void clearInterruptFlags(uint8_t flags);
+        void updateIRQ();
+
+        core::AddressRange _range;
+
+        uint8_t _dataA = 0;
+        uint8_t _dataB = 0;
+        uint8_t _ddrA = 0;
+        uint8_t _ddrB = 0;
+        uint8_t _t1ll = 0;
+        uint8_t _t1lh = 0;
+        uint8_t _t2ll = 0;
+        uint8_t _sr = 0;
+        uint8_t _acr = 0;
+        uint8_t _pcr = 0;
+        uint8_t _ifr = 0;
+        uint8_t _ier = 0;
+        bool _irqAsserted = false;
+
+        uint64_t _t1Start = 0; // Cycle T1 was loaded from its latches
+        uint16_t _t1Value = 0; // Value T1 was loaded with
+        std::optional<core::Scheduler::EventId> _t1Event;
+
+        uint64_t _t2Start = 0; // Cycle T2 was loaded, in timed mode
+        uint16_t _t2Value = 0; // Value T2 was loaded with, or the current count in pulse counting mode
+        bool _t2Armed = false; // T2 only interrupts once per load
+        std::optional<core::Scheduler::EventId> _t2Event;
     };
 } // namespace EaterEmulator
\ No newline at end of file
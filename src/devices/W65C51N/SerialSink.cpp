@@ -0,0 +1,53 @@
+#include "devices/W65C51N/SerialSink.h"
+
+#include "spdlog/spdlog.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace EaterEmulator::devices
+{
+    FileDescriptorSink::FileDescriptorSink(int fd, bool closeOnDestroy)
+        : _fd(fd), _closeOnDestroy(closeOnDestroy)
+    {
+    }
+
+    FileDescriptorSink::~FileDescriptorSink()
+    {
+        if (_closeOnDestroy)
+        {
+            close(_fd);
+        }
+    }
+
+    std::unique_ptr<FileDescriptorSink> FileDescriptorSink::openFile(const std::string& path)
+    {
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Cannot open serial output file " + path + ": " + std::strerror(errno));
+        }
+        return std::make_unique<FileDescriptorSink>(fd, true);
+    }
+
+    void FileDescriptorSink::write(std::span<const uint8_t> data)
+    {
+        while (!data.empty())
+        {
+            const auto written = ::write(_fd, data.data(), data.size());
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                spdlog::error("FileDescriptorSink: write failed: {}", std::strerror(errno));
+                return;
+            }
+            data = data.subspan(static_cast<size_t>(written));
+        }
+    }
+} // namespace EaterEmulator
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace EaterEmulator::devices
+{
+    // Destination for the characters transmitted by the W65C51N. The ACIA batches its output,
+    // so write() is called with whole chunks rather than once per character.
+    class SerialSink
+    {
+    public:
+        virtual ~SerialSink() = default;
+
+        virtual void write(std::span<const uint8_t> data) = 0;
+    };
+
+    // Writes to a file descriptor: stdout, a file or a pipe
+    class FileDescriptorSink : public SerialSink
+    {
+    public:
+        explicit FileDescriptorSink(int fd, bool closeOnDestroy = false);
+        ~FileDescriptorSink() override;
+
+        FileDescriptorSink(const FileDescriptorSink&) = delete;
+        FileDescriptorSink& operator=(const FileDescriptorSink&) = delete;
+        FileDescriptorSink(FileDescriptorSink&&) = delete;
+        FileDescriptorSink& operator=(FileDescriptorSink&&) = delete;
+
+        // Creates or truncates the file. Throws std::runtime_error if it cannot be opened.
+        static std::unique_ptr<FileDescriptorSink> openFile(const std::string& path);
+
+        void write(std::span<const uint8_t> data) override;
+
+    private:
+        int _fd;
+        bool _closeOnDestroy;
+    };
+
+    // Collects the output in memory, e.g. for tests and batch runs
+    class MemorySink : public SerialSink
+    {
+    public:
+        void write(std::span<const uint8_t> data) override { _data.insert(_data.end(), data.begin(), data.end()); }
+
+        const std::vector<uint8_t>& data() const { return _data; }
+        std::string str() const { return std::string(_data.begin(), _data.end()); }
+        void clear() { _data.clear(); }
+
+    private:
+        std::vector<uint8_t> _data;
+    };
+} // namespace EaterEmulator
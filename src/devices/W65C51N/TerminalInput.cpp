@@ -0,0 +1,71 @@
+
+#include "devices/W65C51N/TerminalInput.h"
+#include "devices/W65C51N/W65C51N.h"
+
+#include "spdlog/spdlog.h"
+
+#include <array>
+#include <chrono>
+#include <poll.h>
+#include <sys/types.h>
+#include <termios.h> // For termios functions
+#include <unistd.h>
+
+namespace EaterEmulator::devices
+{
+    TerminalInput::TerminalInput(W65C51N& acia, int fd)
+        : _acia(acia), _fd(fd), _thread([this](std::stop_token st) { readInput(st); })
+    {
+    }
+
+    TerminalInput::~TerminalInput()
+    {
+        spdlog::debug("TerminalInput destroyed.");
+    }
+
+    void TerminalInput::readInput(std::stop_token stopToken)
+    {
+        struct termios oldt, newt;
+        const bool terminal = isatty(_fd);
+        if (terminal)
+        {
+            // Get current terminal settings
+            tcgetattr(_fd, &oldt);
+            newt = oldt;
+
+            // Disable canonical mode (line buffering) and echoing
+            newt.c_lflag &= ~(ICANON | ECHO);
+            tcsetattr(_fd, TCSANOW, &newt);
+        }
+
+        std::array<uint8_t, 256> buffer;
+        while (!stopToken.stop_requested()) 
+        {
+            // Wait with a timeout so a stop request is noticed without further input
+            pollfd pfd{_fd, POLLIN, 0};
+            if (poll(&pfd, 1, 50) <= 0)
+            {
+                continue;
+            }
+            const auto count = read(_fd, buffer.data(), buffer.size());
+            if (count <= 0)
+            {
+                spdlog::debug("TerminalInput: End of input.");
+                break;
+            }
+            for (ssize_t i = 0; i < count; ++i)
+            {
+                // Back-pressure instead of dropping input when the CPU is not keeping up
+                while (!_acia.receive(buffer[i]) && !stopToken.stop_requested())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        }
+
+        if (terminal)
+        {
+            tcsetattr(_fd, TCSANOW, &oldt);
+        }
+    }
+} // namespace EaterEmulator
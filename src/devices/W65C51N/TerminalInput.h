@@ -0,0 +1,29 @@
+#pragma once
+
+#include <thread>
+
+namespace EaterEmulator::devices
+{
+    class W65C51N;
+
+    // Feeds a file descriptor, standard input by default, into an ACIA from a background thread.
+    // A terminal is switched to unbuffered, unechoed input while this exists and restored afterwards.
+    class TerminalInput
+    {
+    public:
+        explicit TerminalInput(W65C51N& acia, int fd = 0);
+        ~TerminalInput();
+
+        TerminalInput(const TerminalInput&) = delete;
+        TerminalInput& operator=(const TerminalInput&) = delete;
+        TerminalInput(TerminalInput&&) = delete;
+        TerminalInput& operator=(TerminalInput&&) = delete;
+
+    private:
+        void readInput(std::stop_token stopToken);
+
+        W65C51N& _acia;
+        int _fd;
+        std::jthread _thread; // Last, so it stops before the rest is destroyed
+    };
+} // namespace EaterEmulator
@@ -3,59 +3,38 @@
 
 #include "core/bus.h"
 #include "core/defines.h"
+#include "core/trace.h"
 #include "spdlog/spdlog.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdint>
 #include <cstdio>
-#include <iostream>
 #include <sys/types.h>
- #include <termios.h> // For termios functions
-#include <unistd.h>  // For STDIN_FILENO
+#include <unistd.h>  // For STDOUT_FILENO
 
 namespace EaterEmulator::devices
 {
-    W65C51N::W65C51N(std::shared_ptr<core::Bus> bus) 
-        : core::BusSlave(bus, 0x5000)
+    W65C51N::W65C51N(std::shared_ptr<core::Bus> bus, core::AddressRange range) 
+        : core::BusSlave(bus, range.start), _range(range), _txSink(std::make_shared<FileDescriptorSink>(STDOUT_FILENO))
     {
-        // Initialize the background thread for handling communication
-        _backgroundThread = std::jthread([this](std::stop_token st) 
-        {
-            struct termios oldt, newt;
-
-            // Get current terminal settings
-            tcgetattr(STDIN_FILENO, &oldt);
-            newt = oldt;
-
-            // Disable canonical mode (line buffering) and echoing
-            newt.c_lflag &= ~(ICANON | ECHO);
-            tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-            while (!st.stop_requested()) 
-            {
-                auto c = std::getchar();
-                if (c == EOF) {
-                    spdlog::error("Error reading from standard input.");
-                    continue;
-                }
-                this->_receiveData = static_cast<uint8_t>(c);
-                // If Receiver Data Register is already full, set the overrun flag
-                if (this->_status & (1 << 3))
-                {
-                    this->_status |= (1 << 2);
-                }
-                this->_status |= (1 << 3); // Set Receiver Data Register Full bit to full
-            }
-            tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-        });
+        _txBuffer.reserve(TX_FLUSH_THRESHOLD);
     }
 
     W65C51N::~W65C51N() 
     {
-        spdlog::debug("W65C51N destroyed.");
+        if (_rxPollEvent)
+        {
+            _bus->getScheduler().cancel(*_rxPollEvent);
+        }
+        flushTransmit();
+        log().debug("W65C51N destroyed.");
     }
 
     void W65C51N::handleBusNotification(uint16_t address, uint8_t rwb)
     {
         if (!shouldHandleAddress(address)) {
-            spdlog::debug("W65C51N: Address {:#04x} not handled by this device", address);
+            EATER_TRACE("W65C51N: Address {:#04x} not handled by this device", address);
             return; // If the pins are not for this device, do nothing
         }
 
@@ -72,10 +51,32 @@ namespace EaterEmulator::devices
 
     bool W65C51N::shouldHandleAddress(const uint16_t& address) const
     {
-        // Decode address from the address bus and check if it falls within the range of this VIA
-        // ACIA is mapped to 0x5000 - 0x50FF so only when A12 and A14 are HIGH and A15 is LOW.
-        // To avoid collision with VIA, A13 must be LOW.
-        return (address & (1 << 15)) == 0 && (address & (1 << 14)) != 0 && (address & (1 << 13)) == 0 && (address & (1 << 12)) != 0; 
+        // On Ben Eater's board the ACIA is selected when A12 and A14 are HIGH and A15 and A13 are LOW
+        return address >= _range.start && address <= _range.end;
+    }
+
+    std::vector<core::AddressRange> W65C51N::getAddressRanges() const
+    {
+        return { _range };
+    }
+
+    uint64_t W65C51N::getReadStableUntil(uint16_t address) const
+    {
+        switch (static_cast<Register>((address - _offset) & 0x0F))
+        {
+            case Register::STATUS:
+                if (!_rxRing.empty())
+                {
+                    return 0;
+                }
+                // TDRE comes up once the last character has been shifted out
+                return _bus->getScheduler().now() < _txIdleCycle ? _txIdleCycle : core::Scheduler::NEVER;
+            case Register::COMMAND:
+            case Register::CONTROL:
+                return core::Scheduler::NEVER;
+            default:
+                return 0;
+        }
     }
 
     bool W65C51N::handleRead(Register reg)
@@ -94,20 +95,23 @@ namespace EaterEmulator::devices
         {            
             case Register::DATA:
                 _transmitData = data;
-                std::cout << static_cast<char>(_transmitData);
-                std::flush(std::cout);
+                transmit(_transmitData);
                 break;
             case Register::STATUS:
-                _status = data;
+                // Programmed reset, the written value is ignored
+                _status &= ~STATUS_OVERRUN;
+                _command &= 0xE0;
+                updateReceivePolling();
                 break;
             case Register::COMMAND:
                 _command = data;
+                updateReceivePolling();
                 break;
             case Register::CONTROL:
                 _control = data;
                 break;
             default:
-                spdlog::error("W65C51N: Invalid register for write operation: {:#04x}", static_cast<int>(reg));
+                log().error("W65C51N: Invalid register for write operation: {:#04x}", static_cast<int>(reg));
                 return false;
         }
 
@@ -120,16 +124,217 @@ namespace EaterEmulator::devices
         {
             case Register::DATA: 
                 {
-                    auto mask = ~(1 << 3) & ~(1 << 2);
-                    _status = _status & mask;
+                    updateReceiver();
+                    const auto now = _bus->getScheduler().now();
+                    if (_flowControl && (_status & STATUS_RDRF) && _nextReceiveCycle <= now)
+                    {
+                        // The sender was held off until now, its next character takes a full frame
+                        _nextReceiveCycle = now + cyclesPerCharacter();
+                    }
+                    _status &= ~(STATUS_RDRF | STATUS_OVERRUN);
                     return _receiveData;
                 }
-            case Register::STATUS: return _status;
+            case Register::STATUS:
+                {
+                    updateReceiver();
+                    // The transmit register reads empty once the last character has been shifted out
+                    const uint8_t status = _status | (_bus->getScheduler().now() >= _txIdleCycle ? STATUS_TDRE : 0);
+                    // Reading the status acknowledges the interrupt
+                    _status &= ~STATUS_IRQ;
+                    updateIRQ();
+                    return status;
+                }
             case Register::COMMAND: return _command;
             case Register::CONTROL: return _control;
             default:
-                spdlog::error("W65C51N: Invalid register: {:#04x}", static_cast<int>(reg));
+                log().error("W65C51N: Invalid register: {:#04x}", static_cast<int>(reg));
                 return 0;
         }
     }
-} // namespace EaterEmulator
\ No newline at end of file
+
+    uint64_t W65C51N::cyclesPerCharacter() const
+    {
+        // Control register bits 0-3 select the baud rate. 0 is the 16x external clock, treated as 115200.
+        static constexpr std::array<double, 16> BAUD_RATES = {
+            115200, 50, 75, 109.92, 134.58, 150, 300, 600, 1200, 1800, 2400, 3600, 4800, 7200, 9600, 19200
+        };
+        const auto wordLength = 8 - ((_control >> 5) & 0x03);
+        const auto stopBits = (_control & 0x80) ? 2 : 1;
+        const auto parityBits = (_command & 0x20) ? 1 : 0;
+        const auto frameBits = 1 + wordLength + parityBits + stopBits;
+        const auto cycles = std::llround(static_cast<double>(_clockFrequency) * frameBits / BAUD_RATES[_control & 0x0F]);
+        return static_cast<uint64_t>(std::max<long long>(cycles, 1));
+    }
+
+    void W65C51N::updateReceiver()
+    {
+        // Characters are only moved when the CPU looks at the ACIA, with the cycles elapsed since the last
+        // character deciding how many have completed on the line in the meantime
+        const auto now = _bus->getScheduler().now();
+        while (_nextReceiveCycle <= now)
+        {
+            if (_flowControl && (_status & STATUS_RDRF))
+            {
+                break; // Sender held off until the data register is read
+            }
+            auto byte = _rxRing.pop();
+            if (!byte)
+            {
+                // Idle line, the next character cannot complete before now
+                _nextReceiveCycle = now;
+                break;
+            }
+            if (_status & STATUS_RDRF)
+            {
+                // Data register still full, the new character is lost
+                _status |= STATUS_OVERRUN;
+            }
+            else
+            {
+                _receiveData = *byte;
+                _status |= STATUS_RDRF;
+                if (isReceiveInterruptEnabled())
+                {
+                    _status |= STATUS_IRQ;
+                    updateIRQ();
+                }
+            }
+            _nextReceiveCycle += cyclesPerCharacter();
+        }
+    }
+
+    void W65C51N::updateReceivePolling()
+    {
+        auto& scheduler = _bus->getScheduler();
+        if (!isReceiveInterruptEnabled())
+        {
+            if (_rxPollEvent)
+            {
+                scheduler.cancel(*_rxPollEvent);
+                _rxPollEvent.reset();
+            }
+            return;
+        }
+        if (!_rxPollEvent)
+        {
+            // Input from the host is only seen when looked for, a character time apart like on the line
+            _rxPollEvent = scheduler.scheduleIn(cyclesPerCharacter(), [this](uint64_t) {
+                _rxPollEvent.reset();
+                updateReceiver();
+                updateReceivePolling();
+            });
+        }
+    }
+
+    void W65C51N::updateIRQ()
+    {
+        const bool asserted = (_status & STATUS_IRQ) != 0;
+        if (asserted != _irqAsserted)
+        {
+            _irqAsserted = asserted;
+            // IRQB is active low
+            writeToPeripheral(Port::IRQ, asserted ? core::LOW : core::HIGH);
+        }
+    }
+
+    void W65C51N::writeToPeripheral(Port port, uint8_t data)
+    {
+        if (auto it = connections.find(port); it != connections.end())
+        {
+            std::visit([&](auto& device) {
+                device.writeToPort(it->second.peripheralPortId, data);
+            }, it->second.device);
+        }
+    }
+
+    void W65C51N::saveState(core::StateWriter& writer) const
+    {
+        writer.write(_transmitData);
+        writer.write(_status);
+        writer.write(_command);
+        writer.write(_control);
+        writer.write(_receiveData);
+        writer.write(_nextReceiveCycle);
+        writer.write(_txIdleCycle);
+        writer.write(static_cast<uint32_t>(_txBuffer.size()));
+        writer.writeBytes(_txBuffer);
+    }
+
+    void W65C51N::loadState(core::StateReader& reader)
+    {
+        _transmitData = reader.read<uint8_t>();
+        _status = reader.read<uint8_t>();
+        _command = reader.read<uint8_t>();
+        _control = reader.read<uint8_t>();
+        _receiveData = reader.read<uint8_t>();
+        _nextReceiveCycle = reader.read<uint64_t>();
+        _txIdleCycle = reader.read<uint64_t>();
+        _irqAsserted = (_status & STATUS_IRQ) != 0;
+
+        if (_rxPollEvent)
+        {
+            _bus->getScheduler().cancel(*_rxPollEvent);
+            _rxPollEvent.reset();
+        }
+        updateReceivePolling();
+
+        // Output buffered after the save is rewound along with the rest of the machine
+        if (_txFlushEvent)
+        {
+            _bus->getScheduler().cancel(*_txFlushEvent);
+            _txFlushEvent.reset();
+        }
+        _txBuffer.resize(reader.read<uint32_t>());
+        reader.readBytes(_txBuffer);
+        if (!_txBuffer.empty())
+        {
+            scheduleTransmitFlush();
+        }
+    }
+
+    void W65C51N::setTransmitSink(std::shared_ptr<SerialSink> sink)
+    {
+        flushTransmit();
+        _txSink = std::move(sink);
+    }
+
+    void W65C51N::flushTransmit()
+    {
+        if (_txFlushEvent)
+        {
+            _bus->getScheduler().cancel(*_txFlushEvent);
+            _txFlushEvent.reset();
+        }
+        if (!_txBuffer.empty() && _txSink)
+        {
+            _txSink->write(_txBuffer);
+        }
+        _txBuffer.clear();
+    }
+
+    void W65C51N::transmit(uint8_t data)
+    {
+        // A character written while the previous one is still being sent follows it on the line
+        const auto now = _bus->getScheduler().now();
+        _txIdleCycle = std::max(now, _txIdleCycle) + cyclesPerCharacter();
+
+        _txBuffer.push_back(data);
+        if (data == '\n' || data == '\r' || _txBuffer.size() >= TX_FLUSH_THRESHOLD)
+        {
+            flushTransmit();
+        }
+        else if (!_txFlushEvent)
+        {
+            // Prompts and partial lines still show up shortly after they are sent
+            scheduleTransmitFlush();
+        }
+    }
+
+    void W65C51N::scheduleTransmitFlush()
+    {
+        _txFlushEvent = _bus->getScheduler().scheduleIn(std::max<uint64_t>(_clockFrequency / TX_FLUSH_DIVIDER, 1), [this](uint64_t) {
+            _txFlushEvent.reset();
+            flushTransmit();
+        });
+    }
+} // namespace EaterEmulator
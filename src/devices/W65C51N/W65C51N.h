@@ -2,18 +2,23 @@
 
 #include "core/bus_slave.h"
 #include "core/defines.h"
+#include "core/spsc_ring.h"
+#include "core/state.h"
 
 #include "devices/W65C02S/CPUAdapter.h"
+#include "devices/W65C51N/SerialSink.h"
 
 #include <map>
-#include <thread>
+#include <memory>
+#include <optional>
 #include <variant>
+#include <vector>
 
 namespace EaterEmulator::devices
 {
 
     // W65C51N is a serial communication interface
-    class W65C51N : public core::BusSlave
+    class W65C51N : public core::BusSlave, public core::Stateful
     {
     public:
         enum class Register
@@ -26,10 +31,33 @@ namespace EaterEmulator::devices
 
         enum class Port
         {
-            IRQ
+            IRQ // IRQB output, written LOW while the IRQ status bit is set
         };
 
-        W65C51N(std::shared_ptr<core::Bus> bus);
+        // Status register bits
+        static constexpr uint8_t STATUS_PARITY_ERROR = 0x01;
+        static constexpr uint8_t STATUS_FRAMING_ERROR = 0x02;
+        static constexpr uint8_t STATUS_OVERRUN = 0x04;
+        static constexpr uint8_t STATUS_RDRF = 0x08; // Receiver Data Register Full
+        static constexpr uint8_t STATUS_TDRE = 0x10; // Transmitter Data Register Empty
+        static constexpr uint8_t STATUS_IRQ = 0x80; // Interrupt occurred, cleared by reading the status register
+
+        // Command register bits
+        static constexpr uint8_t COMMAND_DTR = 0x01; // Data Terminal Ready, enables the receiver and its interrupt
+        static constexpr uint8_t COMMAND_IRD = 0x02; // Receiver Interrupt Request Disabled
+
+        static constexpr size_t RX_BUFFER_SIZE = 4096;
+
+        // Transmitted characters are passed to the sink at the end of a line, once this many are buffered,
+        // or after TX_FLUSH_DIVIDER-th of a second of emulated time, whichever comes first
+        static constexpr size_t TX_FLUSH_THRESHOLD = 4096;
+        static constexpr uint64_t TX_FLUSH_DIVIDER = 100;
+
+        // Where Ben Eater's board decodes the ACIA. The registers repeat every 16 bytes of the range.
+        static constexpr core::AddressRange DEFAULT_RANGE{0x5000, 0x5FFF};
+
+        // Input only arrives through receive(), e.g. from a TerminalInput
+        W65C51N(std::shared_ptr<core::Bus> bus, core::AddressRange range = DEFAULT_RANGE);
         virtual ~W65C51N();
 
         W65C51N(const W65C51N&) = delete;
@@ -41,30 +69,92 @@ namespace EaterEmulator::devices
         void handleBusNotification(uint16_t address, uint8_t rwb) override;
 
         bool shouldHandleAddress(const uint16_t& address) const override;
+
+        std::vector<core::AddressRange> getAddressRanges() const override;
         
         std::string getName() const override { return "W65C51N"; }
 
-        // void connect(Port viaPort, core::Peripheral auto device, int peripheralPortId)
-        // {
-        //     connections[viaPort] = {device, peripheralPortId};
-        // }
+        // The status register holds still while no input is waiting and the transmitter is not busy,
+        // the command and control registers until written
+        uint64_t getReadStableUntil(uint16_t address) const override;
+
+        // Registers, line timing and unflushed output. Input still waiting in the receive buffer came
+        // from the host rather than the machine and is left alone. The CPU restores its own IRQ line.
+        void saveState(core::StateWriter& writer) const override;
+        void loadState(core::StateReader& reader) override;
+
+        // Queue a byte arriving on RxD. Safe to call from one producer thread while the CPU runs.
+        // Returns false if the receive buffer is full. With the receive interrupt enabled (DTR set, IRD
+        // clear) the ACIA looks for input once per character time and interrupts when a character lands
+        // in the data register, otherwise only when the CPU reads its registers.
+        bool receive(uint8_t byte) { return _rxRing.push(byte); }
+
+        // CPU clock frequency, used to convert the programmed baud rate into cycles per character
+        void setClockFrequency(uint64_t frequency) { _clockFrequency = frequency; }
+        uint64_t getClockFrequency() const { return _clockFrequency; }
+
+        // With flow control (the default) the sender holds off while the receive register is full, as with
+        // an RTS/CTS handshake, so no input is lost. Without it, characters arriving while the register is
+        // still full are dropped and set the overrun bit, like an unhandshaked serial line.
+        void setFlowControl(bool enabled) { _flowControl = enabled; }
+        bool getFlowControl() const { return _flowControl; }
+
+        // Cycles one character takes on the line at the programmed baud rate and frame format
+        uint64_t cyclesPerCharacter() const;
+
+        // Where transmitted characters go, standard output by default
+        void setTransmitSink(std::shared_ptr<SerialSink> sink);
+
+        // Pass any buffered output to the sink now
+        void flushTransmit();
+
+        void connect(Port port, core::Peripheral auto device, int peripheralPortId)
+        {
+            connections[port] = {device, peripheralPortId};
+        }
 
     private:
-        // struct Connection {
-        //     Peripherals device;
-        //     int peripheralPortId;
-        // };
-        // std::map<Port, Connection> connections;
+        using Peripherals = std::variant<CPUAdapter>;
+        struct Connection {
+            Peripherals device;
+            int peripheralPortId;
+        };
+        std::map<Port, Connection> connections;
         bool handleRead(Register reg);
         bool handleWrite(Register reg);
 
         uint8_t readRegister(Register reg);
-        uint8_t _transmitData;
-        uint8_t _status;
-        uint8_t _command;
-        uint8_t _control;
-        uint8_t _receiveData;
 
-        std::jthread _backgroundThread;
+        // Move characters from the receive buffer into the data register, paced at the baud rate
+        void updateReceiver();
+        bool isReceiveInterruptEnabled() const { return (_command & (COMMAND_DTR | COMMAND_IRD)) == COMMAND_DTR; }
+        // Keeps an event looking for input due every character time while the receive interrupt is enabled
+        void updateReceivePolling();
+        void updateIRQ();
+        void writeToPeripheral(Port port, uint8_t data);
+
+        void transmit(uint8_t data);
+        void scheduleTransmitFlush();
+
+        core::AddressRange _range;
+
+        uint8_t _transmitData = 0;
+        uint8_t _status = 0;
+        uint8_t _command = 0;
+        uint8_t _control = 0;
+        uint8_t _receiveData = 0;
+
+        uint64_t _clockFrequency = 1'000'000;
+        bool _flowControl = true;
+        uint64_t _nextReceiveCycle = 0; // Earliest cycle the next character can complete
+        std::optional<core::Scheduler::EventId> _rxPollEvent;
+        bool _irqAsserted = false;
+
+        std::shared_ptr<SerialSink> _txSink;
+        std::vector<uint8_t> _txBuffer;
+        std::optional<core::Scheduler::EventId> _txFlushEvent;
+        uint64_t _txIdleCycle = 0; // Cycle the transmitter finishes sending the last character
+
+        core::SpscRing<uint8_t, RX_BUFFER_SIZE> _rxRing; // Filled by the input thread, drained by the CPU thread
     };
 } // namespace EaterEmulator
\ No newline at end of file
@@ -1,78 +1,254 @@
-#include <iostream>
-#include <fstream>
-#include <filesystem>
-#include <vector>
+#include <memory>
 #include <cstdint>
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
 
-#include "core/bus.h"
+#include "core/clock.h"
+#include "core/machine.h"
+#include "core/machine_config.h"
+#include "core/trace.h"
 
-#include "devices/ArduinoMega/ArduinoMega.h"
-#include "devices/EEPROM28C256/EEPROM28C256.h"
 #include "devices/HD44780LCD/HD44780LCD.h"
-#include "devices/HD44780LCD/LCDAdapter.h"
-#include "devices/SRAM62256/SRAM62256.h"
-#include "devices/W65C02S/CPUAdapter.h"
-#include "devices/W65C02S/W65C02S.h"
-#include "devices/W65C22S/W65C22S.h"
-#include "devices/W65C51N/W65C51N.h"
+#include "devices/HD44780LCD/LCDRenderer.h"
+#include "devices/W65C51N/TerminalInput.h"
 #include "spdlog/spdlog.h"
 
 using namespace EaterEmulator;
 
+namespace
+{
+    constexpr uint64_t DEFAULT_FREQUENCY = 1'000'000; // Ben Eater's 6502 runs at 1 MHz
+    // Emulated time run between two sleeps of the clock thread. Long enough that an idle CPU, skipped
+    // through in a few instructions per batch, hardly wakes the host, short enough for typing.
+    constexpr auto CLOCK_BATCH_DURATION = std::chrono::milliseconds(10);
+
+    struct Options
+    {
+        std::string romPath; // Overrides the config's ROM file
+        std::string configPath; // Empty for Ben Eater's board
+        std::optional<uint64_t> cpuFrequency; // Overrides the config's clock, devices derive their timing from it
+        double speed = 1.0; // Host pacing as a multiple of the emulated clock, 0 for turbo
+        uint64_t maxCycles = 0; // 0 runs until interrupted
+        std::string serialOutPath; // Empty sends ACIA output to stdout
+        std::optional<devices::HD44780LCD::Geometry> lcd = devices::HD44780LCD::Geometry{}; // Empty hides the LCD
+        double lcdFrameRate = devices::LCDRenderer::DEFAULT_FRAME_RATE;
+        std::string tracePath; // Empty leaves tracing off, "-" traces to stderr
+        std::string busTracePath; // Empty leaves the bus monitor out
+    };
+
+    std::atomic<bool> interrupted{false};
+
+    void printUsage(const char* program)
+    {
+        spdlog::info("Usage: {} [options] <path_to_rom>", program);
+        spdlog::info("  --rom <path>         ROM image to load (32K)");
+        spdlog::info("  --config <path>      Machine config with the memory map, clock and ROM, see core/machine_config.h");
+        spdlog::info("  --hz <frequency>     Run in real time at the given clock frequency (default {})", DEFAULT_FREQUENCY);
+        spdlog::info("  --speed <multiple>   Run at a multiple of real time, e.g. 2 or 0.5");
+        spdlog::info("  --turbo              Run unthrottled, as fast as the host allows");
+        spdlog::info("  --max-cycles <n>     Stop after n clock cycles");
+        spdlog::info("  --serial-out <path>  Write ACIA output to a file or pipe instead of stdout");
+        spdlog::info("  --lcd <layout>       LCD module to draw: 16x2 (default), 20x4 or off");
+        spdlog::info("  --lcd-fps <rate>     Maximum LCD redraws per second (default {})", devices::LCDRenderer::DEFAULT_FRAME_RATE);
+        spdlog::info("  --bus-trace <path>   Record every bus access to a binary trace, see bus_trace_decode");
+        spdlog::info("  --trace <path>       Write per-access trace output to a file, - for stderr (Debug or ENABLE_TRACE builds)");
+    }
+
+    std::optional<devices::HD44780LCD::Geometry> parseLCDLayout(const std::string& layout)
+    {
+        if (layout == "off") return std::nullopt;
+        if (layout == "16x2") return devices::HD44780LCD::Geometry{16, 2};
+        if (layout == "20x4") return devices::HD44780LCD::Geometry{20, 4};
+        throw std::invalid_argument("Unknown LCD layout " + layout);
+    }
+
+    std::optional<Options> parseOptions(int argc, char* argv[])
+    {
+        Options options;
+        double speed = 1.0;
+        bool turbo = false;
+        try
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                std::string_view arg = argv[i];
+                auto value = [&]() -> std::string {
+                    if (i + 1 >= argc)
+                    {
+                        throw std::invalid_argument(std::string(arg) + " requires a value");
+                    }
+                    return argv[++i];
+                };
+
+                if (arg == "--rom") options.romPath = value();
+                else if (arg == "--config") options.configPath = value();
+                else if (arg == "--hz") options.cpuFrequency = std::stoull(value());
+                else if (arg == "--speed") speed = std::stod(value());
+                else if (arg == "--turbo") turbo = true;
+                else if (arg == "--max-cycles") options.maxCycles = std::stoull(value());
+                else if (arg == "--serial-out") options.serialOutPath = value();
+                else if (arg == "--lcd") options.lcd = parseLCDLayout(value());
+                else if (arg == "--lcd-fps") options.lcdFrameRate = std::stod(value());
+                else if (arg == "--trace") options.tracePath = value();
+                else if (arg == "--bus-trace") options.busTracePath = value();
+                else if (arg == "--help" || arg == "-h") return std::nullopt;
+                else if (!arg.starts_with("--") && options.romPath.empty()) options.romPath = arg;
+                else throw std::invalid_argument("Unknown option " + std::string(arg));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Invalid arguments: {}", e.what());
+            return std::nullopt;
+        }
+
+        if (options.romPath.empty() && options.configPath.empty())
+        {
+            spdlog::error("No ROM file specified.");
+            return std::nullopt;
+        }
+        if (speed <= 0.0 || options.cpuFrequency == 0 || options.lcdFrameRate <= 0.0)
+        {
+            spdlog::error("Clock frequency, speed and LCD frame rate must be positive.");
+            return std::nullopt;
+        }
+        options.speed = turbo ? 0.0 : speed;
+        return options;
+    }
+}
+
 int main(int argc, char* argv[]) {
 
     spdlog::set_pattern("[%H:%M:%S %z] [%n] [%^---%L---%$] %v");
     spdlog::set_level(spdlog::level::info); 
-    if (argc < 2) 
+    auto options = parseOptions(argc, argv);
+    if (!options)
     {
-        spdlog::error("No ROM file specified.");
-        spdlog::info("Usage: {} <path_to_rom>", argv[0]);
+        printUsage(argv[0]);
         return 1;
     }
 
-    std::vector<uint8_t> rom; // Buffer to hold the ROM data
-    // Read the ROM into a buffer
-    if(auto ifs = std::ifstream { argv[1], std::ios::binary }) 
+    core::MachineConfig config;
+    try
     {
-        auto size = std::filesystem::file_size(argv[1]);
-        rom.resize(size);
-        ifs.seekg(0, std::ios::beg);
-        ifs.read(reinterpret_cast<char*>(rom.data()), rom.size());
+        if (!options->configPath.empty())
+        {
+            config = core::MachineConfig::load(options->configPath);
+        }
     }
-    else 
+    catch (const std::runtime_error& e)
     {
-        spdlog::error("Error reading ROM file: {}", argv[1]);
+        spdlog::error("{}", e.what());
         return 1;
     }
-    auto bus = std::make_shared<core::Bus>();
-    
-    auto cpu6502 = std::make_shared<devices::W65C02S>(bus);
-    cpu6502->reset();
-    devices::EEPROM28C256 rom28C256(rom, bus);
-    bus->addSlave(&rom28C256);
-    devices::SRAM62256 ram62256(bus);
-    bus->addSlave(&ram62256);
-    devices::W65C22S w65c22s(bus);
-    bus->addSlave(&w65c22s);
-    devices::W65C51N w65c51n(bus);
-    bus->addSlave(&w65c51n);
-    // devices::ArduinoMega arduinoMega(bus);
-    // bus->addSlave(&arduinoMega);
-
-    auto lcd = std::make_shared<devices::HD44780LCD>();
-    devices::LCDAdapter lcdAdapter(lcd);
-    w65c22s.connect(devices::W65C22S::Port::A, lcdAdapter, devices::LCDAdapter::CONTROL_PORT);
-    w65c22s.connect(devices::W65C22S::Port::B, lcdAdapter, devices::LCDAdapter::DATA_PORT);
-
-    devices::CPUAdapter cpuAdapter(cpu6502);
-    w65c22s.connect(devices::W65C22S::Port::CB2, cpuAdapter, devices::CPUAdapter::IRQ_PORT);
-    
-
-    while (true)
-    {
-        cpu6502->onClockStateChange(core::LOW);
-        cpu6502->onClockStateChange(core::HIGH);
-    }
-    
+    if (!options->romPath.empty())
+    {
+        config.romPath = options->romPath;
+    }
+    if (options->cpuFrequency)
+    {
+        config.clockFrequency = *options->cpuFrequency;
+    }
+    const uint64_t frequency = options->speed == 0.0 ? core::Clock::UNTHROTTLED
+        : static_cast<uint64_t>(static_cast<double>(config.clockFrequency) * options->speed);
+
+    // Declared before the machine so the writer drains the last records after the devices are gone
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> traceFile(nullptr, std::fclose);
+    std::optional<core::trace::Writer> traceWriter;
+    if (!options->tracePath.empty())
+    {
+        if (!core::trace::isCompiledIn())
+        {
+            spdlog::warn("Trace points are not compiled into this build, configure with -DENABLE_TRACE=ON");
+        }
+        std::FILE* file = stderr;
+        if (options->tracePath != "-")
+        {
+            traceFile.reset(std::fopen(options->tracePath.c_str(), "w"));
+            if (!traceFile)
+            {
+                spdlog::error("Error opening trace file: {}", options->tracePath);
+                return 1;
+            }
+            file = traceFile.get();
+        }
+        traceWriter.emplace(file);
+        core::trace::setEnabled(true);
+    }
+
+    std::unique_ptr<core::Machine> machine;
+    try
+    {
+        machine = std::make_unique<core::Machine>(config);
+        if (!options->serialOutPath.empty())
+        {
+            machine->getACIA().setTransmitSink(devices::FileDescriptorSink::openFile(options->serialOutPath));
+        }
+        if (!options->busTracePath.empty())
+        {
+            // A monitor sees every access, so RAM and ROM no longer take the bus fast path
+            machine->attachBusTrace(options->busTracePath);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("{}", e.what());
+        return 1;
+    }
+    devices::TerminalInput terminalInput(machine->getACIA());
+
+    std::optional<devices::LCDRenderer> lcdRenderer;
+    if (options->lcd)
+    {
+        lcdRenderer.emplace(machine->getLCD(), *options->lcd);
+        lcdRenderer->setFrameRate(options->lcdFrameRate);
+        lcdRenderer->setInPlace(isatty(STDOUT_FILENO));
+    }
+
+    core::Clock clock(frequency);
+    clock.setBatchDuration(CLOCK_BATCH_DURATION);
+    clock.setCycleLimit(options->maxCycles);
+    clock.registerObserver(&machine->getCPU());
+
+    std::signal(SIGINT, [](int) { interrupted.store(true); });
+    std::signal(SIGTERM, [](int) { interrupted.store(true); });
+
+    if (frequency == core::Clock::UNTHROTTLED)
+    {
+        spdlog::info("Running unthrottled");
+    }
+    else
+    {
+        spdlog::info("Running at {:.3f} MHz", static_cast<double>(frequency) / 1e6);
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    clock.start();
+    if (lcdRenderer)
+    {
+        lcdRenderer->start();
+    }
+    while (clock.isRunning() && !interrupted.load())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    clock.stop();
+    if (lcdRenderer)
+    {
+        lcdRenderer->stop();
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    const auto cycles = clock.getCycleCount();
+    spdlog::info("Ran {} cycles in {:.3f} s, effective {:.3f} MHz", cycles, elapsed.count(),
+        static_cast<double>(cycles) / elapsed.count() / 1e6);
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+// Test suite for the HD44780 controller state and its renderer
+#include "devices/HD44780LCD/HD44780LCD.h"
+#include "devices/HD44780LCD/LCDRenderer.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace EaterEmulator;
+
+class LCDTest : public ::testing::Test {
+protected:
+    std::shared_ptr<devices::HD44780LCD> lcd = std::make_shared<devices::HD44780LCD>();
+    std::ostringstream out;
+
+    void SetUp() override
+    {
+        instruction(0b00111000); // 8-bit mode, 2 lines
+        instruction(0b00001100); // Display on
+        instruction(0b00000110); // Increment
+        instruction(0b00000001); // Clear
+    }
+
+    // Latch a byte on the falling edge of E, as the VIA port writes do
+    void latch(uint8_t rs, uint8_t data)
+    {
+        lcd->writeDataLines(data);
+        lcd->setControlLines(rs, 0, true);
+        lcd->setControlLines(rs, 0, false);
+    }
+
+    void instruction(uint8_t data) { latch(0, data); }
+
+    void print(const std::string& text)
+    {
+        for (char c : text)
+        {
+            latch(1, static_cast<uint8_t>(c));
+        }
+    }
+
+    std::string frame(const std::vector<std::string>& rows)
+    {
+        const std::string border = "+" + std::string(rows.front().size(), '-') + "+\n";
+        std::string text = border;
+        for (const auto& row : rows)
+        {
+            text += "|" + row + "|\n";
+        }
+        return text + border;
+    }
+};
+
+TEST_F(LCDTest, SetDDRAMAddressSelectsSecondLine)
+{
+    print("Hello");
+    instruction(0x80 | 0x40);
+    print("world");
+
+    devices::LCDRenderer renderer(lcd, {16, 2}, out);
+    EXPECT_TRUE(renderer.renderIfChanged());
+    EXPECT_EQ(out.str(), frame({ "Hello           ", "world           " }));
+}
+
+TEST_F(LCDTest, AddressCounterWrapsToSecondLine)
+{
+    print(std::string(devices::HD44780LCD::LINE_LENGTH, 'a'));
+    print("b");
+
+    auto snapshot = lcd->takeSnapshot();
+    EXPECT_EQ(snapshot.ddram[devices::HD44780LCD::SECOND_LINE], 'b');
+    EXPECT_EQ(snapshot.addressCounter, devices::HD44780LCD::SECOND_LINE + 1);
+}
+
+TEST_F(LCDTest, FourRowLayoutContinuesLines)
+{
+    instruction(0x80 | 0x14);
+    print("third");
+    instruction(0x80 | 0x54);
+    print("fourth");
+
+    devices::LCDRenderer renderer(lcd, {20, 4}, out);
+    renderer.renderIfChanged();
+    const std::string blank(20, ' ');
+    EXPECT_EQ(out.str(), frame({ blank, blank, "third               ", "fourth              " }));
+}
+
+TEST_F(LCDTest, DisplayShiftMovesWindow)
+{
+    print("0123456789ABCDEFG");
+    instruction(0b00011000); // Shift display left
+
+    devices::LCDRenderer renderer(lcd, {16, 2}, out);
+    renderer.renderIfChanged();
+    EXPECT_EQ(out.str(), frame({ "123456789ABCDEFG", std::string(16, ' ') }));
+}
+
+TEST_F(LCDTest, SnapshotClearsDirtyCells)
+{
+    lcd->takeSnapshot();
+    instruction(0x80 | 0x42);
+    print("x");
+
+    auto snapshot = lcd->takeSnapshot();
+    EXPECT_EQ(snapshot.dirtyCells.count(), 1u);
+    EXPECT_TRUE(snapshot.dirtyCells.test(0x42));
+    EXPECT_TRUE(lcd->takeSnapshot().dirtyCells.none());
+}
+
+TEST_F(LCDTest, CGRAMWriteMarksCharacterDirty)
+{
+    lcd->takeSnapshot();
+    instruction(0x40 | (3 << 3)); // Character 3, row 0
+    print("\x1F\x11");
+
+    auto snapshot = lcd->takeSnapshot();
+    EXPECT_EQ(snapshot.dirtyCharacters, 1 << 3);
+    EXPECT_EQ(snapshot.cgram[3 << 3], 0x1F);
+    EXPECT_EQ(snapshot.cgram[(3 << 3) + 1], 0x11);
+    EXPECT_TRUE(snapshot.dirtyCells.none());
+}
+
+TEST_F(LCDTest, RendererCoalescesWrites)
+{
+    devices::LCDRenderer renderer(lcd, {16, 2}, out);
+    EXPECT_TRUE(renderer.renderIfChanged());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        instruction(0b00000010); // Home
+        print(std::to_string(i));
+    }
+    EXPECT_TRUE(renderer.renderIfChanged());
+    EXPECT_FALSE(renderer.renderIfChanged());
+    EXPECT_EQ(renderer.getFrameCount(), 2u);
+}
+
+TEST_F(LCDTest, InPlaceRedrawsOnlyDirtyRows)
+{
+    devices::LCDRenderer renderer(lcd, {16, 2}, out);
+    renderer.setInPlace(true);
+    renderer.renderIfChanged();
+    out.str("");
+
+    instruction(0x80 | 0x40);
+    print("hi");
+    EXPECT_TRUE(renderer.renderIfChanged());
+    EXPECT_EQ(out.str(), "\x1b[2A\r|hi              |\x1b[2B\r");
+
+    // Moving the cursor changes nothing visible
+    instruction(0x80);
+    EXPECT_FALSE(renderer.renderIfChanged());
+}
+
+TEST_F(LCDTest, RenderThreadIsRateLimited)
+{
+    devices::LCDRenderer renderer(lcd, {16, 2}, out);
+    renderer.setFrameRate(20);
+    renderer.start();
+
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    int i = 0;
+    while (std::chrono::steady_clock::now() < end)
+    {
+        instruction(0b00000010); // Home
+        print(std::to_string(i++ % 10));
+    }
+    renderer.stop();
+
+    // About 4 frames in 200 ms, with slack for a loaded host, and at least the final state
+    EXPECT_GE(renderer.getFrameCount(), 1u);
+    EXPECT_LE(renderer.getFrameCount(), 8u);
+}
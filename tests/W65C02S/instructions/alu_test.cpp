@@ -0,0 +1,169 @@
+// Test suite for the ALU kernels, checked against a plain implementation for every operand
+#include <gtest/gtest.h>
+
+#include "devices/W65C02S/alu.h"
+
+#include <cstdint>
+
+using namespace EaterEmulator;
+using namespace EaterEmulator::devices;
+
+namespace
+{
+    uint8_t flag(bool set, uint8_t mask)
+    {
+        return set ? mask : 0;
+    }
+
+    uint8_t withNZ(uint8_t status, uint8_t value)
+    {
+        status &= ~(STATUS_NEGATIVE | STATUS_ZERO);
+        return status | flag(value & 0x80, STATUS_NEGATIVE) | flag(value == 0, STATUS_ZERO);
+    }
+
+    int signedValue(uint8_t value)
+    {
+        return value < 0x80 ? value : value - 0x100;
+    }
+
+    // Decimal mode after Bruce Clark's description of the 65C02, which was checked against the chip
+    alu::Result referenceADC(uint8_t a, uint8_t operand, uint8_t status)
+    {
+        const int carry = status & STATUS_CARRY;
+        status &= ~(STATUS_NEGATIVE | STATUS_OVERFLOW | STATUS_ZERO | STATUS_CARRY);
+        if (!(status & STATUS_DECIMAL))
+        {
+            const int sum = a + operand + carry;
+            const int signedSum = signedValue(a) + signedValue(operand) + carry;
+            status |= flag(sum > 0xFF, STATUS_CARRY) | flag(signedSum < -128 || signedSum > 127, STATUS_OVERFLOW);
+            return { static_cast<uint8_t>(sum), withNZ(status, static_cast<uint8_t>(sum)) };
+        }
+        int low = (a & 0x0F) + (operand & 0x0F) + carry;
+        if (low >= 0x0A)
+        {
+            low = ((low + 0x06) & 0x0F) + 0x10;
+        }
+        int sum = (a & 0xF0) + (operand & 0xF0) + low;
+        const int signedSum = signedValue(a & 0xF0) + signedValue(operand & 0xF0) + low;
+        status |= flag(signedSum < -128 || signedSum > 127, STATUS_OVERFLOW);
+        if (sum >= 0xA0)
+        {
+            sum += 0x60;
+        }
+        status |= flag(sum > 0xFF, STATUS_CARRY);
+        return { static_cast<uint8_t>(sum), withNZ(status, static_cast<uint8_t>(sum)) };
+    }
+
+    alu::Result referenceSBC(uint8_t a, uint8_t operand, uint8_t status)
+    {
+        const int borrow = 1 - (status & STATUS_CARRY);
+        status &= ~(STATUS_NEGATIVE | STATUS_OVERFLOW | STATUS_ZERO | STATUS_CARRY);
+        int difference = a - operand - borrow;
+        const int signedDifference = signedValue(a) - signedValue(operand) - borrow;
+        status |= flag(difference >= 0, STATUS_CARRY) | flag(signedDifference < -128 || signedDifference > 127, STATUS_OVERFLOW);
+        if (status & STATUS_DECIMAL)
+        {
+            const int low = (a & 0x0F) - (operand & 0x0F) - borrow;
+            if (difference < 0)
+            {
+                difference -= 0x60;
+            }
+            if (low < 0)
+            {
+                difference -= 0x06;
+            }
+        }
+        return { static_cast<uint8_t>(difference), withNZ(status, static_cast<uint8_t>(difference)) };
+    }
+
+    // Every status register the kernels can see: carry and decimal on or off, the other flags set or not
+    constexpr uint8_t STATUSES[] = {
+        0x00,
+        STATUS_CARRY,
+        STATUS_DECIMAL,
+        STATUS_DECIMAL | STATUS_CARRY,
+        static_cast<uint8_t>(~STATUS_CARRY & ~STATUS_DECIMAL),
+        static_cast<uint8_t>(~STATUS_DECIMAL),
+        static_cast<uint8_t>(~STATUS_CARRY),
+        0xFF,
+    };
+}
+
+TEST(ALUTest, ADCMatchesReference)
+{
+    for (uint8_t status : STATUSES)
+    {
+        for (int a = 0; a < 0x100; ++a)
+        {
+            for (int operand = 0; operand < 0x100; ++operand)
+            {
+                const auto result = alu::adc(static_cast<uint8_t>(a), static_cast<uint8_t>(operand), status);
+                const auto expected = referenceADC(static_cast<uint8_t>(a), static_cast<uint8_t>(operand), status);
+                ASSERT_EQ(result.value, expected.value) << std::hex << a << " + " << operand << " status " << +status;
+                ASSERT_EQ(withNZ(result.status, result.value), expected.status) << std::hex << a << " + " << operand << " status " << +status;
+                ASSERT_EQ(result.status & (STATUS_NEGATIVE | STATUS_ZERO), 0);
+            }
+        }
+    }
+}
+
+TEST(ALUTest, SBCMatchesReference)
+{
+    for (uint8_t status : STATUSES)
+    {
+        for (int a = 0; a < 0x100; ++a)
+        {
+            for (int operand = 0; operand < 0x100; ++operand)
+            {
+                const auto result = alu::sbc(static_cast<uint8_t>(a), static_cast<uint8_t>(operand), status);
+                const auto expected = referenceSBC(static_cast<uint8_t>(a), static_cast<uint8_t>(operand), status);
+                ASSERT_EQ(result.value, expected.value) << std::hex << a << " - " << operand << " status " << +status;
+                ASSERT_EQ(withNZ(result.status, result.value), expected.status) << std::hex << a << " - " << operand << " status " << +status;
+                ASSERT_EQ(result.status & (STATUS_NEGATIVE | STATUS_ZERO), 0);
+            }
+        }
+    }
+}
+
+TEST(ALUTest, DecimalCountsThroughAllBCDValues)
+{
+    // A BCD counter wraps from 99 to 00 with a carry, every step a valid BCD byte
+    uint8_t value = 0x00;
+    for (int i = 1; i <= 100; ++i)
+    {
+        const auto result = alu::adc(value, 0x01, STATUS_DECIMAL);
+        value = result.value;
+        EXPECT_EQ(value, static_cast<uint8_t>(((i % 100) / 10) << 4 | (i % 10)));
+        EXPECT_EQ(result.status & STATUS_CARRY, i == 100 ? STATUS_CARRY : 0);
+    }
+}
+
+TEST(ALUTest, CompareAndShiftsMatchReference)
+{
+    for (uint8_t status : STATUSES)
+    {
+        for (int value = 0; value < 0x100; ++value)
+        {
+            const auto byte = static_cast<uint8_t>(value);
+            const uint8_t carry = status & STATUS_CARRY;
+            const uint8_t cleared = status & ~(STATUS_NEGATIVE | STATUS_ZERO | STATUS_CARRY);
+
+            for (int operand = 0; operand < 0x100; ++operand)
+            {
+                const auto difference = static_cast<uint8_t>(value - operand);
+                const auto result = alu::compare(byte, static_cast<uint8_t>(operand), status);
+                ASSERT_EQ(result.value, difference);
+                ASSERT_EQ(result.status, cleared | flag(value >= operand, STATUS_CARRY));
+            }
+
+            auto expect = [&](alu::Result result, uint8_t value, bool carryOut) {
+                EXPECT_EQ(result.value, value);
+                EXPECT_EQ(result.status, cleared | flag(carryOut, STATUS_CARRY));
+            };
+            expect(alu::asl(byte, status), static_cast<uint8_t>(byte << 1), byte & 0x80);
+            expect(alu::lsr(byte, status), static_cast<uint8_t>(byte >> 1), byte & 0x01);
+            expect(alu::rol(byte, status), static_cast<uint8_t>(byte << 1 | carry), byte & 0x80);
+            expect(alu::ror(byte, status), static_cast<uint8_t>(byte >> 1 | carry << 7), byte & 0x01);
+        }
+    }
+}
@@ -9,9 +9,8 @@ using namespace EaterEmulator;
 TEST_F(CPUInstructionTest, AND_IMM_Value) 
 {
     auto opcode = Opcode::AND_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37; // 00110111
     cpu->setAccumulator(0x42); // 01000010
@@ -34,9 +33,8 @@ TEST_F(CPUInstructionTest, AND_IMM_Value)
 TEST_F(CPUInstructionTest, AND_IMM_ZeroValue) 
 {
     auto opcode = Opcode::AND_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37; // 00110111
     cpu->setAccumulator(0x48); // 01001000
@@ -59,9 +57,8 @@ TEST_F(CPUInstructionTest, AND_IMM_ZeroValue)
 TEST_F(CPUInstructionTest, AND_IMM_NegativeValue) 
 {
     auto opcode = Opcode::AND_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xB7; // 10110111
     cpu->setAccumulator(0xC8); // 11001000
@@ -84,9 +81,8 @@ TEST_F(CPUInstructionTest, AND_IMM_NegativeValue)
 TEST_F(CPUInstructionTest, AND_ABS_Value) 
 {
     auto opcode = Opcode::AND_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
     memory[0xFFFE - MEMORY_OFFSET] = 0xFF;
@@ -111,9 +107,8 @@ TEST_F(CPUInstructionTest, AND_ABS_Value)
 TEST_F(CPUInstructionTest, AND_ABS_ZeroValue) 
 {
     auto opcode = Opcode::AND_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
     memory[0xFFFE - MEMORY_OFFSET] = 0xFF;
@@ -138,9 +133,8 @@ TEST_F(CPUInstructionTest, AND_ABS_ZeroValue)
 TEST_F(CPUInstructionTest, AND_ABS_NegativeValue) 
 {
     auto opcode = Opcode::AND_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
     memory[0xFFFE - MEMORY_OFFSET] = 0xFF;
@@ -165,9 +159,8 @@ TEST_F(CPUInstructionTest, AND_ABS_NegativeValue)
 TEST_F(CPUInstructionTest, AND_ABSX_Value) 
 {
     auto opcode = Opcode::AND_ABSX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
     memory[0xFFFE - MEMORY_OFFSET] = 0xFF;
@@ -193,9 +186,8 @@ TEST_F(CPUInstructionTest, AND_ABSX_Value)
 TEST_F(CPUInstructionTest, AND_ABSX_ZeroValue) 
 {
     auto opcode = Opcode::AND_ABSX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
     memory[0xFFFE - MEMORY_OFFSET] = 0xFF;
@@ -221,9 +213,8 @@ TEST_F(CPUInstructionTest, AND_ABSX_ZeroValue)
 TEST_F(CPUInstructionTest, AND_ABSX_NegativeValue) 
 {
     auto opcode = Opcode::AND_ABSX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
     memory[0xFFFE - MEMORY_OFFSET] = 0xFF;
@@ -249,9 +240,8 @@ TEST_F(CPUInstructionTest, AND_ABSX_NegativeValue)
 TEST_F(CPUInstructionTest, AND_ABSY_Value) 
 {
     auto opcode = Opcode::AND_ABSY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
     memory[0xFFFE - MEMORY_OFFSET] = 0xFF;
@@ -277,9 +267,8 @@ TEST_F(CPUInstructionTest, AND_ABSY_Value)
 TEST_F(CPUInstructionTest, AND_ABSY_ZeroValue) 
 {
     auto opcode = Opcode::AND_ABSY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
     memory[0xFFFE - MEMORY_OFFSET] = 0xFF;
@@ -305,9 +294,8 @@ TEST_F(CPUInstructionTest, AND_ABSY_ZeroValue)
 TEST_F(CPUInstructionTest, AND_ABSY_NegativeValue) 
 {
     auto opcode = Opcode::AND_ABSY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
     memory[0xFFFE - MEMORY_OFFSET] = 0xFF;
@@ -333,9 +321,8 @@ TEST_F(CPUInstructionTest, AND_ABSY_NegativeValue)
 TEST_F(CPUInstructionTest, AND_ZP_Value) 
 {
     auto opcode = Opcode::AND_ZP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
     cpu->setAccumulator(0x42); // 01000010
@@ -362,9 +349,8 @@ TEST_F(CPUInstructionTest, AND_ZP_Value)
 TEST_F(CPUInstructionTest, AND_ZP_ZeroValue) 
 {
     auto opcode = Opcode::AND_ZP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
     cpu->setAccumulator(0x48); // 01001000
@@ -391,9 +377,8 @@ TEST_F(CPUInstructionTest, AND_ZP_ZeroValue)
 TEST_F(CPUInstructionTest, AND_ZP_NegativeValue) 
 {
     auto opcode = Opcode::AND_ZP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
     cpu->setAccumulator(0xC8); // 11001000
@@ -420,9 +405,8 @@ TEST_F(CPUInstructionTest, AND_ZP_NegativeValue)
 TEST_F(CPUInstructionTest, AND_ZPX_Value) 
 {
     auto opcode = Opcode::AND_ZPX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x80;
     cpu->setAccumulator(0x42); // 01000010
@@ -450,9 +434,8 @@ TEST_F(CPUInstructionTest, AND_ZPX_Value)
 TEST_F(CPUInstructionTest, AND_ZPX_ZeroValue) 
 {
     auto opcode = Opcode::AND_ZPX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x80;
     cpu->setAccumulator(0x48); // 01001000
@@ -480,9 +463,8 @@ TEST_F(CPUInstructionTest, AND_ZPX_ZeroValue)
 TEST_F(CPUInstructionTest, AND_ZPX_NegativeValue) 
 {
     auto opcode = Opcode::AND_ZPX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x80;
     cpu->setAccumulator(0xC8); // 11001000
@@ -510,9 +492,8 @@ TEST_F(CPUInstructionTest, AND_ZPX_NegativeValue)
 TEST_F(CPUInstructionTest, AND_ZPX_OverflowValue) 
 {
     auto opcode = Opcode::AND_ZPX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x80;
     cpu->setAccumulator(0x42); // 01000010
@@ -0,0 +1,203 @@
+// Test suite for BIT and the test-and-set/reset bit opcodes (TRB, TSB, RMB, SMB)
+#include "cpu_instruction_test.h"
+#include "devices/SRAM62256/SRAM62256.h"
+#include <cstdint>
+
+using namespace EaterEmulator;
+
+TEST_F(CPUInstructionTest, BIT_IMM_OnlySetsZero)
+{
+    auto opcode = Opcode::BIT_IMM;
+    const auto& info = decodeOpcode(opcode);
+    EXPECT_EQ(info.cycles, 2);
+    auto cycles = info.cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0xC0; // Bits 7 and 6 set, ignored by the immediate form
+    cpu->setAccumulator(0x0F);
+    cpu->setStatus(0x00);
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+
+    for (int i = 0; i < cycles; ++i)
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+
+    EXPECT_EQ(cpu->getStatus(), devices::STATUS_ZERO);
+    EXPECT_EQ(cpu->getAccumulator(), 0x0F);
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFD + 1);
+}
+
+TEST_F(CPUInstructionTest, BIT_ZPX_SetsFlagsFromMemory)
+{
+    auto opcode = Opcode::BIT_ZPX;
+    const auto& info = decodeOpcode(opcode);
+    EXPECT_EQ(info.cycles, 4);
+    auto cycles = info.cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0x30;
+    cpu->setAccumulator(0x01);
+    cpu->setXRegister(0x05);
+    cpu->setStatus(0x00);
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x0035] = 0xC1;
+    bus->addSlave(ram.get());
+
+    for (int i = 0; i < cycles; ++i)
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+
+    EXPECT_EQ(cpu->getStatus(), devices::STATUS_NEGATIVE | devices::STATUS_OVERFLOW);
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFD + 1);
+}
+
+TEST_F(CPUInstructionTest, BIT_ABSX_SetsFlagsFromMemory)
+{
+    auto opcode = Opcode::BIT_ABSX;
+    const auto& info = decodeOpcode(opcode);
+    EXPECT_EQ(info.cycles, 4);
+    auto cycles = info.cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0x00;
+    memory[0xFFFE - MEMORY_OFFSET] = 0x20;
+    cpu->setAccumulator(0x02);
+    cpu->setXRegister(0x10);
+    cpu->setStatus(0x00);
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x2010] = 0x40;
+    bus->addSlave(ram.get());
+
+    for (int i = 0; i < cycles; ++i)
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+
+    EXPECT_EQ(cpu->getStatus(), devices::STATUS_OVERFLOW | devices::STATUS_ZERO);
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFE + 1);
+}
+
+TEST_F(CPUInstructionTest, TSB_ZP_SetsBitsAndTestsOldValue)
+{
+    auto opcode = Opcode::TSB_ZP;
+    const auto& info = decodeOpcode(opcode);
+    EXPECT_EQ(info.cycles, 5);
+    auto cycles = info.cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0x37;
+    cpu->setAccumulator(0x0F);
+    cpu->setStatus(devices::STATUS_NEGATIVE);
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x0037] = 0xF0;
+    bus->addSlave(ram.get());
+
+    for (int i = 0; i < cycles; ++i)
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+
+    EXPECT_EQ(ram->getMemory()[0x0037], 0xFF);
+    EXPECT_EQ(cpu->getStatus(), devices::STATUS_NEGATIVE | devices::STATUS_ZERO); // No bit of A was set, N untouched
+    EXPECT_EQ(cpu->getAccumulator(), 0x0F);
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFD + 1);
+}
+
+TEST_F(CPUInstructionTest, TRB_ABS_ClearsBitsAndTestsOldValue)
+{
+    auto opcode = Opcode::TRB_ABS;
+    const auto& info = decodeOpcode(opcode);
+    EXPECT_EQ(info.cycles, 6);
+    auto cycles = info.cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0x37;
+    memory[0xFFFE - MEMORY_OFFSET] = 0x20;
+    cpu->setAccumulator(0x0F);
+    cpu->setStatus(devices::STATUS_ZERO);
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x2037] = 0x3C;
+    bus->addSlave(ram.get());
+
+    for (int i = 0; i < cycles; ++i)
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+
+    EXPECT_EQ(ram->getMemory()[0x2037], 0x30);
+    EXPECT_EQ(cpu->getStatus(), 0x00); // Bits 2 and 3 of A were set in memory
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFE + 1);
+}
+
+TEST_F(CPUInstructionTest, RMB_ClearsSelectedBit)
+{
+    for (uint8_t bit = 0; bit < 8; ++bit)
+    {
+        auto opcode = static_cast<Opcode>(static_cast<uint8_t>(Opcode::RMB0) + (bit << 4));
+        const auto& info = decodeOpcode(opcode);
+        EXPECT_EQ(info.cycles, 5);
+        auto cycles = info.cycles;
+        memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+        memory[0xFFFD - MEMORY_OFFSET] = 0x37;
+        bus = std::make_shared<core::Bus>();
+        cpu = std::make_unique<devices::W65C02S>(bus);
+        cpu->reset();
+        cpu->setResetStage(2);
+        rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+        bus->addSlave(rom.get());
+        auto ram = std::make_unique<devices::SRAM62256>(bus);
+        ram->getMemory()[0x0037] = 0xFF;
+        bus->addSlave(ram.get());
+
+        for (int i = 0; i < cycles; ++i)
+        {
+            cpu->onClockStateChange(core::LOW);
+            cpu->onClockStateChange(core::HIGH);
+        }
+
+        EXPECT_EQ(ram->getMemory()[0x0037], static_cast<uint8_t>(~(1 << bit))) << "RMB" << static_cast<int>(bit);
+        EXPECT_EQ(cpu->getStatus(), 0x00);
+        EXPECT_EQ(cpu->getProgramCounter(), 0xFFFD + 1);
+    }
+}
+
+TEST_F(CPUInstructionTest, SMB_SetsSelectedBit)
+{
+    for (uint8_t bit = 0; bit < 8; ++bit)
+    {
+        auto opcode = static_cast<Opcode>(static_cast<uint8_t>(Opcode::SMB0) + (bit << 4));
+        const auto& info = decodeOpcode(opcode);
+        EXPECT_EQ(info.cycles, 5);
+        auto cycles = info.cycles;
+        memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+        memory[0xFFFD - MEMORY_OFFSET] = 0x37;
+        bus = std::make_shared<core::Bus>();
+        cpu = std::make_unique<devices::W65C02S>(bus);
+        cpu->reset();
+        cpu->setResetStage(2);
+        rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+        bus->addSlave(rom.get());
+        auto ram = std::make_unique<devices::SRAM62256>(bus);
+        bus->addSlave(ram.get());
+
+        for (int i = 0; i < cycles; ++i)
+        {
+            cpu->onClockStateChange(core::LOW);
+            cpu->onClockStateChange(core::HIGH);
+        }
+
+        EXPECT_EQ(ram->getMemory()[0x0037], 1 << bit) << "SMB" << static_cast<int>(bit);
+        EXPECT_EQ(cpu->getProgramCounter(), 0xFFFD + 1);
+    }
+}
@@ -8,9 +8,8 @@ using namespace EaterEmulator;
 TEST_F(CPUInstructionTest, EOR_IMM_XorsImmediateValue) 
 {
     auto opcode = Opcode::EOR_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0xF0
     cpu->setAccumulator(0xF0);
@@ -36,9 +35,8 @@ TEST_F(CPUInstructionTest, EOR_IMM_XorsImmediateValue)
 TEST_F(CPUInstructionTest, EOR_IMM_SetsZeroFlag) 
 {
     auto opcode = Opcode::EOR_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0xAA
     cpu->setAccumulator(0xAA);
@@ -64,9 +62,8 @@ TEST_F(CPUInstructionTest, EOR_IMM_SetsZeroFlag)
 TEST_F(CPUInstructionTest, EOR_IMM_ClearsNegativeFlag) 
 {
     auto opcode = Opcode::EOR_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0x80 (negative)
     cpu->setAccumulator(0x80);
@@ -92,9 +89,8 @@ TEST_F(CPUInstructionTest, EOR_IMM_ClearsNegativeFlag)
 TEST_F(CPUInstructionTest, EOR_ZP_XorsZeroPageValue) 
 {
     auto opcode = Opcode::EOR_ZP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0x55
     cpu->setAccumulator(0x55);
@@ -127,9 +123,8 @@ TEST_F(CPUInstructionTest, EOR_ZP_XorsZeroPageValue)
 TEST_F(CPUInstructionTest, EOR_ABS_XorsAbsoluteValue) 
 {
     auto opcode = Opcode::EOR_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0x12
     cpu->setAccumulator(0x12);
@@ -163,9 +158,8 @@ TEST_F(CPUInstructionTest, EOR_ABS_XorsAbsoluteValue)
 TEST_F(CPUInstructionTest, EOR_ZPX_XorsZeroPageXValue) 
 {
     auto opcode = Opcode::EOR_ZPX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0xFF and X register to 0x05
     cpu->setAccumulator(0xFF);
@@ -9,9 +9,8 @@ using namespace EaterEmulator;
 TEST_F(CPUInstructionTest, JMP_ABS) 
 {
     auto opcode = Opcode::JMP_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -33,10 +32,9 @@ TEST_F(CPUInstructionTest, JMP_ABS)
 TEST_F(CPUInstructionTest, JSR) 
 {
     auto opcode = Opcode::JSR;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
+    const auto& info = decodeOpcode(opcode);
     cpu->setResetStage(0); // Not enough room to start from reset vector, perform full reset
-    auto cycles = it->second.cycles + 2; // + 2 for the reset stages.
+    auto cycles = info.cycles + 2; // + 2 for the reset stages.
     memory[0xFFFC - MEMORY_OFFSET] = 0x05;
     memory[0xFFFD - MEMORY_OFFSET] = 0xFF;
 
@@ -70,10 +68,9 @@ TEST_F(CPUInstructionTest, JSR)
 TEST_F(CPUInstructionTest, RTS) 
 {
     auto opcode = Opcode::RTS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
+    const auto& info = decodeOpcode(opcode);
     cpu->setResetStage(0); // Not enough room to start from reset vector, perform full reset
-    auto cycles = it->second.cycles + 2; // + 2 for the reset stages.
+    auto cycles = info.cycles + 2; // + 2 for the reset stages.
     memory[0xFFFC - MEMORY_OFFSET] = 0x0A;
     memory[0xFFFD - MEMORY_OFFSET] = 0xFF;
 
@@ -105,10 +102,9 @@ TEST_F(CPUInstructionTest, RTS)
 TEST_F(CPUInstructionTest, BEQ_PositiveOffsetSamePageTakeBranch) 
 {
     auto opcode = Opcode::BEQ;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
+    const auto& info = decodeOpcode(opcode);
     cpu->setResetStage(0); // Not enough room to start from reset vector, perform full reset
-    auto cycles = 4 + 2; // 3 + BEQ branch taken same page + 2 for the reset stages.
+    auto cycles = 3 + 2; // BEQ taken on the same page + 2 for the reset stages.
     memory[0xFFFC - MEMORY_OFFSET] = 0x05;
     memory[0xFFFD - MEMORY_OFFSET] = 0xFF;
 
@@ -134,10 +130,9 @@ TEST_F(CPUInstructionTest, BEQ_PositiveOffsetSamePageTakeBranch)
 TEST_F(CPUInstructionTest, BEQ_PositiveOffsetSamePageDontTakeBranch) 
 {
     auto opcode = Opcode::BEQ;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
+    const auto& info = decodeOpcode(opcode);
     cpu->setResetStage(0); // Not enough room to start from reset vector, perform full reset
-    auto cycles = 3 + 2; // 2 + BEQ branch not taken + 2 for the reset stages.
+    auto cycles = 2 + 2; // BEQ not taken + 2 for the reset stages.
     memory[0xFFFC - MEMORY_OFFSET] = 0x05;
     memory[0xFFFD - MEMORY_OFFSET] = 0xFF;
 
@@ -163,10 +158,9 @@ TEST_F(CPUInstructionTest, BEQ_PositiveOffsetSamePageDontTakeBranch)
 TEST_F(CPUInstructionTest, BEQ_NegativeOffsetSamePageTakeBranch) 
 {
     auto opcode = Opcode::BEQ;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
+    const auto& info = decodeOpcode(opcode);
     cpu->setResetStage(0); // Not enough room to start from reset vector, perform full reset
-    auto cycles = 4 + 2; // 3 + BEQ branch taken same page + 2 for the reset stages.
+    auto cycles = 3 + 2; // BEQ taken on the same page + 2 for the reset stages.
     memory[0xFFFC - MEMORY_OFFSET] = 0x05;
     memory[0xFFFD - MEMORY_OFFSET] = 0xFF;
 
@@ -192,10 +186,9 @@ TEST_F(CPUInstructionTest, BEQ_NegativeOffsetSamePageTakeBranch)
 TEST_F(CPUInstructionTest, BEQ_NegativeOffsetSamePageDontTakeBranch) 
 {
     auto opcode = Opcode::BEQ;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
+    const auto& info = decodeOpcode(opcode);
     cpu->setResetStage(0); // Not enough room to start from reset vector, perform full reset
-    auto cycles = 3 + 2; // 2 + BEQ branch not taken + 2 for the reset stages.
+    auto cycles = 2 + 2; // BEQ not taken + 2 for the reset stages.
     memory[0xFFFC - MEMORY_OFFSET] = 0x05;
     memory[0xFFFD - MEMORY_OFFSET] = 0xFF;
 
@@ -221,10 +214,9 @@ TEST_F(CPUInstructionTest, BEQ_NegativeOffsetSamePageDontTakeBranch)
 TEST_F(CPUInstructionTest, BNE_PositiveOffsetSamePageTakeBranch) 
 {
     auto opcode = Opcode::BNE;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
+    const auto& info = decodeOpcode(opcode);
     cpu->setResetStage(0); // Not enough room to start from reset vector, perform full reset
-    auto cycles = 4 + 2; // 3 + BNE branch taken same page + 2 for the reset stages.
+    auto cycles = 3 + 2; // BNE taken on the same page + 2 for the reset stages.
     memory[0xFFFC - MEMORY_OFFSET] = 0x05;
     memory[0xFFFD - MEMORY_OFFSET] = 0xFF;
 
@@ -250,10 +242,9 @@ TEST_F(CPUInstructionTest, BNE_PositiveOffsetSamePageTakeBranch)
 TEST_F(CPUInstructionTest, BNE_PositiveOffsetSamePageDontTakeBranch) 
 {
     auto opcode = Opcode::BNE;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
+    const auto& info = decodeOpcode(opcode);
     cpu->setResetStage(0); // Not enough room to start from reset vector, perform full reset
-    auto cycles = 3 + 2; // 2 + BNE branch not taken + 2 for the reset stages.
+    auto cycles = 2 + 2; // BNE not taken + 2 for the reset stages.
     memory[0xFFFC - MEMORY_OFFSET] = 0x05;
     memory[0xFFFD - MEMORY_OFFSET] = 0xFF;
 
@@ -279,10 +270,9 @@ TEST_F(CPUInstructionTest, BNE_PositiveOffsetSamePageDontTakeBranch)
 TEST_F(CPUInstructionTest, BNE_NegativeOffsetSamePageTakeBranch) 
 {
     auto opcode = Opcode::BNE;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
+    const auto& info = decodeOpcode(opcode);
     cpu->setResetStage(0); // Not enough room to start from reset vector, perform full reset
-    auto cycles = 4 + 2; // 3 + BNE branch taken same page + 2 for the reset stages.
+    auto cycles = 3 + 2; // BNE taken on the same page + 2 for the reset stages.
     memory[0xFFFC - MEMORY_OFFSET] = 0x05;
     memory[0xFFFD - MEMORY_OFFSET] = 0xFF;
 
@@ -308,10 +298,9 @@ TEST_F(CPUInstructionTest, BNE_NegativeOffsetSamePageTakeBranch)
 TEST_F(CPUInstructionTest, BNE_NegativeOffsetSamePageDontTakeBranch) 
 {
     auto opcode = Opcode::BNE;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
+    const auto& info = decodeOpcode(opcode);
     cpu->setResetStage(0); // Not enough room to start from reset vector, perform full reset
-    auto cycles = 3 + 2; // 2 + BNE branch not taken + 2 for the reset stages.
+    auto cycles = 2 + 2; // BNE not taken + 2 for the reset stages.
     memory[0xFFFC - MEMORY_OFFSET] = 0x05;
     memory[0xFFFD - MEMORY_OFFSET] = 0xFF;
 
@@ -332,4 +321,178 @@ TEST_F(CPUInstructionTest, BNE_NegativeOffsetSamePageDontTakeBranch)
     EXPECT_EQ(cpu->getProgramCounter(), 0xFF07);
     uint8_t status = cpu->getStatus();
     EXPECT_EQ(status, statusBefore); // Status should remain unchanged
-}
\ No newline at end of file
+}
+TEST_F(CPUInstructionTest, JMP_IAX) 
+{
+    auto opcode = Opcode::JMP_IAX;
+    const auto& info = decodeOpcode(opcode);
+    cpu->setResetStage(0); // Not enough room to start from reset vector, perform full reset
+    auto cycles = info.cycles + 2; // + 2 for the reset stages.
+    memory[0xFFFC - MEMORY_OFFSET] = 0x05;
+    memory[0xFFFD - MEMORY_OFFSET] = 0xFF;
+
+    memory[0xFF05 - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFF06 - MEMORY_OFFSET] = 0x10;
+    memory[0xFF07 - MEMORY_OFFSET] = 0xFF;
+
+    // Jump table entry 2
+    memory[0xFF14 - MEMORY_OFFSET] = 0x37;
+    memory[0xFF15 - MEMORY_OFFSET] = 0x90;
+
+    cpu->setXRegister(0x04);
+    uint8_t statusBefore = cpu->getStatus();
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    
+    for (int i = 0; i < cycles; ++i) 
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+    
+    EXPECT_EQ(cpu->getProgramCounter(), 0x9037);
+    uint8_t status = cpu->getStatus();
+    EXPECT_EQ(status, statusBefore); // Status should remain unchanged
+}
+
+TEST_F(CPUInstructionTest, BRA_NegativeOffsetAlwaysTaken) 
+{
+    auto opcode = Opcode::BRA;
+    const auto& info = decodeOpcode(opcode);
+    EXPECT_EQ(info.cycles, 2);
+    cpu->setResetStage(0); // Not enough room to start from reset vector, perform full reset
+    auto cycles = info.cycles + 1 + 2; // + 1 taken + 2 for the reset stages.
+    memory[0xFFFC - MEMORY_OFFSET] = 0x05;
+    memory[0xFFFD - MEMORY_OFFSET] = 0xFF;
+
+    memory[0xFF05 - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFF06 - MEMORY_OFFSET] = 0xFC;
+
+    cpu->setStatus(0x00);
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    
+    for (int i = 0; i < cycles; ++i) 
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+    
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFF03);
+    EXPECT_EQ(cpu->getStatus(), 0x00); // Status should remain unchanged
+}
+
+TEST_F(CPUInstructionTest, BBR_TakesBranchOnClearBit) 
+{
+    for (uint8_t bit = 0; bit < 8; ++bit)
+    {
+        auto opcode = static_cast<Opcode>(static_cast<uint8_t>(Opcode::BBR0) + (bit << 4));
+        const auto& info = decodeOpcode(opcode);
+        EXPECT_EQ(info.cycles, 5);
+        auto cycles = info.cycles + 1; // Taken on the same page
+        memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+        memory[0xFFFD - MEMORY_OFFSET] = 0x37;
+        memory[0xFFFE - MEMORY_OFFSET] = 0xF0;
+        bus = std::make_shared<core::Bus>();
+        cpu = std::make_unique<devices::W65C02S>(bus);
+        cpu->reset();
+        cpu->setResetStage(2);
+        rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+        bus->addSlave(rom.get());
+        auto ram = std::make_unique<devices::SRAM62256>(bus);
+        ram->getMemory()[0x0037] = static_cast<uint8_t>(~(1 << bit));
+        bus->addSlave(ram.get());
+
+        for (int i = 0; i < cycles; ++i)
+        {
+            cpu->onClockStateChange(core::LOW);
+            cpu->onClockStateChange(core::HIGH);
+        }
+
+        EXPECT_EQ(cpu->getProgramCounter(), 0xFFFF - 0x10) << "BBR" << static_cast<int>(bit);
+    }
+}
+
+TEST_F(CPUInstructionTest, BBS_FallsThroughOnClearBit) 
+{
+    auto opcode = Opcode::BBS3;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0x37;
+    memory[0xFFFE - MEMORY_OFFSET] = 0xF0;
+    uint8_t statusBefore = cpu->getStatus();
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x0037] = 0xF7;
+    bus->addSlave(ram.get());
+
+    for (int i = 0; i < cycles; ++i)
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFF);
+    uint8_t status = cpu->getStatus();
+    EXPECT_EQ(status, statusBefore); // Status should remain unchanged
+}
+
+TEST_F(CPUInstructionTest, BranchesAddTakenAndPageCrossingCycles)
+{
+    struct BranchCase
+    {
+        const char* name;
+        uint16_t address;
+        std::vector<uint8_t> code;
+        uint8_t status;
+        uint16_t target;
+        int cycles;
+    };
+    // $37 holds 0xFE, bit 0 clear
+    const BranchCase cases[] = {
+        {"BNE not taken", 0x8000, {0xD0, 0x10}, devices::STATUS_ZERO, 0x8002, 2},
+        {"BNE taken", 0x8010, {0xD0, 0x10}, 0x00, 0x8022, 3},
+        {"BNE taken across a page", 0x80F0, {0xD0, 0x10}, 0x00, 0x8102, 4},
+        {"BNE taken back across a page", 0x8200, {0xD0, 0xF0}, 0x00, 0x81F2, 4},
+        {"BRA", 0x8300, {0x80, 0x10}, 0x00, 0x8312, 3},
+        {"BRA across a page", 0x83F0, {0x80, 0x10}, 0x00, 0x8402, 4},
+        {"BBS0 not taken", 0x8500, {0x8F, 0x37, 0x10}, 0x00, 0x8503, 5},
+        {"BBR0 taken", 0x8600, {0x0F, 0x37, 0x10}, 0x00, 0x8613, 6},
+        {"BBR0 taken across a page", 0x86F0, {0x0F, 0x37, 0x10}, 0x00, 0x8703, 7},
+    };
+    std::fill(memory.begin(), memory.end(), static_cast<uint8_t>(Opcode::NOP));
+    for (const auto& c : cases)
+    {
+        std::copy(c.code.begin(), c.code.end(), memory.begin() + (c.address - MEMORY_OFFSET));
+    }
+
+    for (const auto& c : cases)
+    {
+        bus = std::make_shared<core::Bus>();
+        cpu = std::make_unique<devices::W65C02S>(bus);
+        cpu->reset();
+        cpu->setResetStage(2);
+        cpu->setProgramCounter(c.address);
+        cpu->setStatus(c.status);
+        rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+        bus->addSlave(rom.get());
+        auto ram = std::make_unique<devices::SRAM62256>(bus);
+        ram->getMemory()[0x0037] = 0xFE;
+        bus->addSlave(ram.get());
+
+        for (int i = 0; i < c.cycles; ++i)
+        {
+            cpu->onClockStateChange(core::LOW);
+            cpu->onClockStateChange(core::HIGH);
+        }
+        EXPECT_EQ(cpu->getProgramCounter(), c.target) << c.name;
+
+        // The next cycle fetches the NOP at the target
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+        EXPECT_EQ(cpu->getProgramCounter(), c.target + 1) << c.name;
+        EXPECT_EQ(cpu->getInstructionCount(), 2u) << c.name;
+    }
+}
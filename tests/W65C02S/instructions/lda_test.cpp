@@ -9,9 +9,8 @@ using namespace EaterEmulator;
 TEST_F(CPUInstructionTest, LDA_IMM_LoadsImmediateValue) 
 {
     auto opcode = Opcode::LDA_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x42;
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -32,9 +31,8 @@ TEST_F(CPUInstructionTest, LDA_IMM_LoadsImmediateValue)
 TEST_F(CPUInstructionTest, LDA_IMM_LoadsImmediateNegativeValue) 
 {
     auto opcode = Opcode::LDA_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x8E;
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -55,9 +53,8 @@ TEST_F(CPUInstructionTest, LDA_IMM_LoadsImmediateNegativeValue)
 TEST_F(CPUInstructionTest, LDA_IMM_LoadsImmediateZeroValue) 
 {
     auto opcode = Opcode::LDA_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x00;
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -78,9 +75,8 @@ TEST_F(CPUInstructionTest, LDA_IMM_LoadsImmediateZeroValue)
 TEST_F(CPUInstructionTest, LDA_ABS_LoadsAbsoluteValue) 
 {
     auto opcode = Opcode::LDA_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -103,9 +99,8 @@ TEST_F(CPUInstructionTest, LDA_ABS_LoadsAbsoluteValue)
 TEST_F(CPUInstructionTest, LDA_ABS_LoadsAbsoluteNegativeValue) 
 {
     auto opcode = Opcode::LDA_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -128,9 +123,8 @@ TEST_F(CPUInstructionTest, LDA_ABS_LoadsAbsoluteNegativeValue)
 TEST_F(CPUInstructionTest, LDA_ABS_LoadsAbsoluteZeroValue) 
 {
     auto opcode = Opcode::LDA_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -153,9 +147,8 @@ TEST_F(CPUInstructionTest, LDA_ABS_LoadsAbsoluteZeroValue)
 TEST_F(CPUInstructionTest, LDA_ABSX_LoadsAbsoluteXValue) 
 {
     auto opcode = Opcode::LDA_ABSX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -179,9 +172,8 @@ TEST_F(CPUInstructionTest, LDA_ABSX_LoadsAbsoluteXValue)
 TEST_F(CPUInstructionTest, LDA_ABSX_LoadsAbsoluteNegativeXValue) 
 {
     auto opcode = Opcode::LDA_ABSX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -205,9 +197,8 @@ TEST_F(CPUInstructionTest, LDA_ABSX_LoadsAbsoluteNegativeXValue)
 TEST_F(CPUInstructionTest, LDA_ABSX_LoadsAbsoluteXZeroValue) 
 {
     auto opcode = Opcode::LDA_ABSX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -231,9 +222,8 @@ TEST_F(CPUInstructionTest, LDA_ABSX_LoadsAbsoluteXZeroValue)
 TEST_F(CPUInstructionTest, LDA_ABSY_LoadsAbsoluteYValue) 
 {
     auto opcode = Opcode::LDA_ABSY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -257,9 +247,8 @@ TEST_F(CPUInstructionTest, LDA_ABSY_LoadsAbsoluteYValue)
 TEST_F(CPUInstructionTest, LDA_ABSX_LoadsAbsoluteYNegativeValue) 
 {
     auto opcode = Opcode::LDA_ABSY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -283,9 +272,8 @@ TEST_F(CPUInstructionTest, LDA_ABSX_LoadsAbsoluteYNegativeValue)
 TEST_F(CPUInstructionTest, LDA_ABSX_LoadsAbsoluteYZeroValue) 
 {
     auto opcode = Opcode::LDA_ABSY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -309,9 +297,8 @@ TEST_F(CPUInstructionTest, LDA_ABSX_LoadsAbsoluteYZeroValue)
 TEST_F(CPUInstructionTest, LDA_ZP_LoadsZeroPageValue) 
 {
     auto opcode = Opcode::LDA_ZP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -336,9 +323,8 @@ TEST_F(CPUInstructionTest, LDA_ZP_LoadsZeroPageValue)
 TEST_F(CPUInstructionTest, LDA_ZP_LoadsZeroPageNegativeValue) 
 {
     auto opcode = Opcode::LDA_ZP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -363,9 +349,8 @@ TEST_F(CPUInstructionTest, LDA_ZP_LoadsZeroPageNegativeValue)
 TEST_F(CPUInstructionTest, LDA_ZP_LoadsZeroPageZeroValue) 
 {
     auto opcode = Opcode::LDA_ZP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -390,9 +375,8 @@ TEST_F(CPUInstructionTest, LDA_ZP_LoadsZeroPageZeroValue)
 TEST_F(CPUInstructionTest, LDA_ZPX_LoadsZeroPageXValue) 
 {
     auto opcode = Opcode::LDA_ZPX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x80;
     cpu->setXRegister(0x0F);
@@ -418,9 +402,8 @@ TEST_F(CPUInstructionTest, LDA_ZPX_LoadsZeroPageXValue)
 TEST_F(CPUInstructionTest, LDA_ZPX_LoadsZeroPageXNegativeValue) 
 {
     auto opcode = Opcode::LDA_ZPX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x80;
     cpu->setXRegister(0x0F);
@@ -446,9 +429,8 @@ TEST_F(CPUInstructionTest, LDA_ZPX_LoadsZeroPageXNegativeValue)
 TEST_F(CPUInstructionTest, LDA_ZPX_LoadsZeroPageXZeroValue) 
 {
     auto opcode = Opcode::LDA_ZPX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x80;
     cpu->setXRegister(0x0F);
@@ -474,9 +456,8 @@ TEST_F(CPUInstructionTest, LDA_ZPX_LoadsZeroPageXZeroValue)
 TEST_F(CPUInstructionTest, LDA_ZPX_LoadsZeroPageXOverflowValue) 
 {
     auto opcode = Opcode::LDA_ZPX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x80;
     cpu->setXRegister(0xFF);
@@ -502,9 +483,8 @@ TEST_F(CPUInstructionTest, LDA_ZPX_LoadsZeroPageXOverflowValue)
 TEST_F(CPUInstructionTest, LDA_INDX_LoadsValue) 
 {
     auto opcode = Opcode::LDA_INDX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x34; // Pointer address
     
@@ -537,9 +517,8 @@ TEST_F(CPUInstructionTest, LDA_INDX_LoadsValue)
 TEST_F(CPUInstructionTest, LDA_INDY_LoadsValue) 
 {
     auto opcode = Opcode::LDA_INDY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0xF0; // Pointer address
     
@@ -567,4 +546,38 @@ TEST_F(CPUInstructionTest, LDA_INDY_LoadsValue)
     uint8_t status = cpu->getStatus();
     EXPECT_EQ(status & devices::STATUS_ZERO, 0); // Zero flag should not be set
     EXPECT_EQ(status & devices::STATUS_NEGATIVE, 0); // Negative flag should not be set
-}
\ No newline at end of file
+}
+TEST_F(CPUInstructionTest, LDA_ZPI_LoadsValue) 
+{
+    auto opcode = Opcode::LDA_ZPI;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0xF0; // Pointer address
+    
+    cpu->setYRegister(0x05); // Not added by the (zp) form
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    
+    // Address
+    ram->getMemory()[0x00F0] = 0x00;
+    ram->getMemory()[0x00F1] = 0x03;
+
+    // Value
+    ram->getMemory()[0x0300] = 0x91;
+    ram->getMemory()[0x0305] = 0x11;
+    bus->addSlave(ram.get());
+    
+    for (int i = 0; i < cycles; ++i) 
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+    EXPECT_EQ(cpu->getAccumulator(), 0x91);
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFD + 1);
+    uint8_t status = cpu->getStatus();
+    EXPECT_EQ(status & devices::STATUS_ZERO, 0); // Zero flag should not be set
+    EXPECT_NE(status & devices::STATUS_NEGATIVE, 0); // Negative flag should be set
+}
@@ -9,9 +9,8 @@ using namespace EaterEmulator;
 TEST_F(CPUInstructionTest, LDX_IMM_LoadsImmediateValue) 
 {
     auto opcode = Opcode::LDX_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x42;
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -32,9 +31,8 @@ TEST_F(CPUInstructionTest, LDX_IMM_LoadsImmediateValue)
 TEST_F(CPUInstructionTest, LDX_IMM_LoadsImmediateNegativeValue) 
 {
     auto opcode = Opcode::LDX_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x8E;
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -55,9 +53,8 @@ TEST_F(CPUInstructionTest, LDX_IMM_LoadsImmediateNegativeValue)
 TEST_F(CPUInstructionTest, LDX_IMM_LoadsImmediateZeroValue) 
 {
     auto opcode = Opcode::LDX_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x00;
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -78,9 +75,8 @@ TEST_F(CPUInstructionTest, LDX_IMM_LoadsImmediateZeroValue)
 TEST_F(CPUInstructionTest, LDX_ABS_LoadsAbsoluteValue) 
 {
     auto opcode = Opcode::LDX_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -103,9 +99,8 @@ TEST_F(CPUInstructionTest, LDX_ABS_LoadsAbsoluteValue)
 TEST_F(CPUInstructionTest, LDX_ABS_LoadsAbsoluteNegativeValue) 
 {
     auto opcode = Opcode::LDX_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -128,9 +123,8 @@ TEST_F(CPUInstructionTest, LDX_ABS_LoadsAbsoluteNegativeValue)
 TEST_F(CPUInstructionTest, LDX_ABS_LoadsAbsoluteZeroValue) 
 {
     auto opcode = Opcode::LDX_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -153,9 +147,8 @@ TEST_F(CPUInstructionTest, LDX_ABS_LoadsAbsoluteZeroValue)
 TEST_F(CPUInstructionTest, LDX_ABSY_LoadsAbsoluteYValue) 
 {
     auto opcode = Opcode::LDX_ABSY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -179,9 +172,8 @@ TEST_F(CPUInstructionTest, LDX_ABSY_LoadsAbsoluteYValue)
 TEST_F(CPUInstructionTest, LDX_ABSX_LoadsAbsoluteYNegativeValue) 
 {
     auto opcode = Opcode::LDX_ABSY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -205,9 +197,8 @@ TEST_F(CPUInstructionTest, LDX_ABSX_LoadsAbsoluteYNegativeValue)
 TEST_F(CPUInstructionTest, LDX_ABSX_LoadsAbsoluteYZeroValue) 
 {
     auto opcode = Opcode::LDX_ABSY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x80;
@@ -231,9 +222,8 @@ TEST_F(CPUInstructionTest, LDX_ABSX_LoadsAbsoluteYZeroValue)
 TEST_F(CPUInstructionTest, LDX_ZP_LoadsZeroPageValue) 
 {
     auto opcode = Opcode::LDX_ZP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -258,9 +248,8 @@ TEST_F(CPUInstructionTest, LDX_ZP_LoadsZeroPageValue)
 TEST_F(CPUInstructionTest, LDX_ZP_LoadsZeroPageNegativeValue) 
 {
     auto opcode = Opcode::LDX_ZP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -285,9 +274,8 @@ TEST_F(CPUInstructionTest, LDX_ZP_LoadsZeroPageNegativeValue)
 TEST_F(CPUInstructionTest, LDX_ZP_LoadsZeroPageZeroValue) 
 {
     auto opcode = Opcode::LDX_ZP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -8,9 +8,8 @@ using namespace EaterEmulator;
 TEST_F(CPUInstructionTest, ORA_IMM_OrsImmediateValue) 
 {
     auto opcode = Opcode::ORA_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0x0F
     cpu->setAccumulator(0x0F);
@@ -36,9 +35,8 @@ TEST_F(CPUInstructionTest, ORA_IMM_OrsImmediateValue)
 TEST_F(CPUInstructionTest, ORA_IMM_SetsZeroFlag) 
 {
     auto opcode = Opcode::ORA_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0x00
     cpu->setAccumulator(0x00);
@@ -64,9 +62,8 @@ TEST_F(CPUInstructionTest, ORA_IMM_SetsZeroFlag)
 TEST_F(CPUInstructionTest, ORA_IMM_PreservesExistingBits) 
 {
     auto opcode = Opcode::ORA_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0x55
     cpu->setAccumulator(0x55);
@@ -92,9 +89,8 @@ TEST_F(CPUInstructionTest, ORA_IMM_PreservesExistingBits)
 TEST_F(CPUInstructionTest, ORA_IMM_SetsNegativeFlag) 
 {
     auto opcode = Opcode::ORA_IMM;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0x00
     cpu->setAccumulator(0x00);
@@ -120,9 +116,8 @@ TEST_F(CPUInstructionTest, ORA_IMM_SetsNegativeFlag)
 TEST_F(CPUInstructionTest, ORA_ZP_OrsZeroPageValue) 
 {
     auto opcode = Opcode::ORA_ZP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0x11
     cpu->setAccumulator(0x11);
@@ -155,9 +150,8 @@ TEST_F(CPUInstructionTest, ORA_ZP_OrsZeroPageValue)
 TEST_F(CPUInstructionTest, ORA_ABS_OrsAbsoluteValue) 
 {
     auto opcode = Opcode::ORA_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0x0F
     cpu->setAccumulator(0x0F);
@@ -191,9 +185,8 @@ TEST_F(CPUInstructionTest, ORA_ABS_OrsAbsoluteValue)
 TEST_F(CPUInstructionTest, ORA_ZPX_OrsZeroPageXValue) 
 {
     auto opcode = Opcode::ORA_ZPX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     
     // Set accumulator to 0x08 and X register to 0x03
     cpu->setAccumulator(0x08);
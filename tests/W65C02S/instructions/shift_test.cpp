@@ -0,0 +1,126 @@
+// Test suite for ASL, LSR, ROL and ROR
+#include "cpu_instruction_test.h"
+#include "devices/SRAM62256/SRAM62256.h"
+#include <cstdint>
+
+using namespace EaterEmulator;
+
+TEST_F(CPUInstructionTest, ASL_ACC_ShiftsIntoCarry) 
+{
+    auto opcode = Opcode::ASL_ACC;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
+    cpu->setAccumulator(0x80);
+    cpu->setStatus(0x00);
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    
+    for (int i = 0; i < cycles; ++i) 
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+    
+    EXPECT_EQ(cpu->getAccumulator(), 0x00);
+    EXPECT_EQ(cpu->getStatus(), devices::STATUS_ZERO | devices::STATUS_CARRY);
+}
+
+TEST_F(CPUInstructionTest, ASL_ZP_SetsFlagsFromMemory) 
+{
+    auto opcode = Opcode::ASL_ZP;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
+    cpu->setAccumulator(0x00);
+    cpu->setStatus(devices::STATUS_CARRY | devices::STATUS_ZERO);
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0x10;
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x0010] = 0x41;
+    bus->addSlave(ram.get());
+    
+    for (int i = 0; i < cycles; ++i) 
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+    
+    // N and Z follow the shifted byte, not A, and the carry is cleared
+    EXPECT_EQ(ram->getMemory()[0x0010], 0x82);
+    EXPECT_EQ(cpu->getAccumulator(), 0x00);
+    EXPECT_EQ(cpu->getStatus(), devices::STATUS_NEGATIVE);
+}
+
+TEST_F(CPUInstructionTest, LSR_ACC_ShiftsIntoCarry) 
+{
+    auto opcode = Opcode::LSR_ACC;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
+    cpu->setAccumulator(0x01);
+    cpu->setStatus(devices::STATUS_NEGATIVE);
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    
+    for (int i = 0; i < cycles; ++i) 
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+    
+    EXPECT_EQ(cpu->getAccumulator(), 0x00);
+    EXPECT_EQ(cpu->getStatus(), devices::STATUS_ZERO | devices::STATUS_CARRY);
+}
+
+TEST_F(CPUInstructionTest, ROL_ABS_RotatesThroughCarry) 
+{
+    auto opcode = Opcode::ROL_ABS;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
+    cpu->setAccumulator(0x80);
+    cpu->setStatus(devices::STATUS_CARRY);
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0x00;
+    memory[0xFFFE - MEMORY_OFFSET] = 0x02;
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x0200] = 0x80;
+    bus->addSlave(ram.get());
+    
+    for (int i = 0; i < cycles; ++i) 
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+    
+    EXPECT_EQ(ram->getMemory()[0x0200], 0x01);
+    EXPECT_EQ(cpu->getStatus(), devices::STATUS_CARRY);
+}
+
+TEST_F(CPUInstructionTest, ROR_ZP_RotatesThroughCarry) 
+{
+    auto opcode = Opcode::ROR_ZP;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
+    cpu->setAccumulator(0x01);
+    cpu->setStatus(devices::STATUS_CARRY);
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0x10;
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x0010] = 0x02;
+    bus->addSlave(ram.get());
+    
+    for (int i = 0; i < cycles; ++i) 
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+    
+    EXPECT_EQ(ram->getMemory()[0x0010], 0x81);
+    EXPECT_EQ(cpu->getStatus(), devices::STATUS_NEGATIVE);
+}
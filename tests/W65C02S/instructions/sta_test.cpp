@@ -9,9 +9,8 @@ using namespace EaterEmulator;
 TEST_F(CPUInstructionTest, STA_ABS_StoreValue) 
 {
     auto opcode = Opcode::STA_ABS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     memory[0xFFFD - MEMORY_OFFSET] = 0x37;
     memory[0xFFFE - MEMORY_OFFSET] = 0x20;
@@ -33,4 +32,34 @@ TEST_F(CPUInstructionTest, STA_ABS_StoreValue)
     EXPECT_EQ(cpu->getProgramCounter(), 0xFFFE + 1);
     uint8_t status = cpu->getStatus();
     EXPECT_EQ(status, statusBefore); // Status should remain unchanged
-}
\ No newline at end of file
+}
+TEST_F(CPUInstructionTest, STA_ZPI_StoreValue) 
+{
+    auto opcode = Opcode::STA_ZPI;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0x40; // Pointer address
+    cpu->setAccumulator(0x42);
+    cpu->setYRegister(0x05);
+    uint8_t statusBefore = cpu->getStatus();
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x0040] = 0x37;
+    ram->getMemory()[0x0041] = 0x20;
+    bus->addSlave(ram.get());
+    
+    for (int i = 0; i < cycles; ++i) 
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+    
+    auto ramMemory = ram->getMemory();
+    EXPECT_EQ(ramMemory[0x2037], 0x42);
+    EXPECT_EQ(ramMemory[0x203C], 0x00);
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFD + 1);
+    uint8_t status = cpu->getStatus();
+    EXPECT_EQ(status, statusBefore); // Status should remain unchanged
+}
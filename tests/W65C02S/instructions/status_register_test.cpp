@@ -0,0 +1,388 @@
+// Test suite for the lazily evaluated status register, checked against a model CPU that computes N and Z
+// eagerly on every instruction
+#include "cpu_instruction_test.h"
+#include "devices/SRAM62256/SRAM62256.h"
+#include "devices/W65C02S/StatusRegister.h"
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace EaterEmulator;
+using namespace EaterEmulator::devices;
+
+namespace
+{
+    constexpr uint8_t NZ_MASK = STATUS_NEGATIVE | STATUS_ZERO;
+
+    // The status register as a plain byte with every flag updated as soon as an instruction changes it,
+    // and the instructions that set or read flags, written independently of the core. Code runs from a
+    // byte vector at 0x8000, zero page and the stack are modelled.
+    struct EagerCPU
+    {
+        uint8_t a = 0;
+        uint8_t x = 0;
+        uint8_t y = 0;
+        uint8_t sp = 0xFF;
+        uint8_t status = 0;
+        uint16_t pc = 0x8000;
+        std::array<uint8_t, 0x200> ram{};
+        uint8_t pushed = 0; // Last byte PHP pushed
+
+        void setFlag(uint8_t flag, bool value) { status = value ? status | flag : status & ~flag; }
+        void setNZ(uint8_t value)
+        {
+            setFlag(STATUS_NEGATIVE, value & 0x80);
+            setFlag(STATUS_ZERO, value == 0);
+        }
+        void push(uint8_t value) { ram[0x0100 + sp--] = value; }
+        uint8_t pull() { return ram[0x0100 + ++sp]; }
+
+        void adc(uint8_t operand)
+        {
+            const int carry = status & STATUS_CARRY;
+            if (status & STATUS_DECIMAL)
+            {
+                // WDC 65C02: the low digit is adjusted first, V comes from the sum before the high digit is
+                int low = (a & 0x0F) + (operand & 0x0F) + carry;
+                if (low >= 0x0A)
+                {
+                    low = ((low + 0x06) & 0x0F) + 0x10;
+                }
+                int sum = (a & 0xF0) + (operand & 0xF0) + low;
+                const int signedSum = static_cast<int8_t>(a & 0xF0) + static_cast<int8_t>(operand & 0xF0) + low;
+                setFlag(STATUS_OVERFLOW, signedSum < -128 || signedSum > 127);
+                if (sum >= 0xA0)
+                {
+                    sum += 0x60;
+                }
+                setFlag(STATUS_CARRY, sum >= 0x100);
+                a = static_cast<uint8_t>(sum);
+            }
+            else
+            {
+                const int sum = a + operand + carry;
+                setFlag(STATUS_OVERFLOW, ~(a ^ operand) & (a ^ sum) & 0x80);
+                setFlag(STATUS_CARRY, sum > 0xFF);
+                a = static_cast<uint8_t>(sum);
+            }
+            setNZ(a);
+        }
+
+        void sbc(uint8_t operand)
+        {
+            const int borrow = 1 - (status & STATUS_CARRY);
+            int difference = a - operand - borrow;
+            setFlag(STATUS_OVERFLOW, (a ^ operand) & (a ^ difference) & 0x80);
+            setFlag(STATUS_CARRY, difference >= 0);
+            if (status & STATUS_DECIMAL)
+            {
+                const int low = (a & 0x0F) - (operand & 0x0F) - borrow;
+                if (difference < 0)
+                {
+                    difference -= 0x60;
+                }
+                if (low < 0)
+                {
+                    difference -= 0x06;
+                }
+            }
+            a = static_cast<uint8_t>(difference);
+            setNZ(a);
+        }
+
+        void compare(uint8_t reg, uint8_t operand)
+        {
+            setFlag(STATUS_CARRY, reg >= operand);
+            setNZ(static_cast<uint8_t>(reg - operand));
+        }
+
+        uint8_t shift(uint8_t opcode, uint8_t value)
+        {
+            const uint8_t carryIn = status & STATUS_CARRY;
+            uint8_t result = 0;
+            switch (opcode & 0xE0)
+            {
+                case 0x00: result = static_cast<uint8_t>(value << 1); setFlag(STATUS_CARRY, value & 0x80); break; // ASL
+                case 0x20: result = static_cast<uint8_t>(value << 1 | carryIn); setFlag(STATUS_CARRY, value & 0x80); break; // ROL
+                case 0x40: result = value >> 1; setFlag(STATUS_CARRY, value & 0x01); break; // LSR
+                default: result = static_cast<uint8_t>(value >> 1 | carryIn << 7); setFlag(STATUS_CARRY, value & 0x01); break; // ROR
+            }
+            setNZ(result);
+            return result;
+        }
+
+        void branch(bool taken, uint8_t offset)
+        {
+            if (taken)
+            {
+                pc = static_cast<uint16_t>(pc + static_cast<int8_t>(offset));
+            }
+        }
+
+        void step(const std::vector<uint8_t>& code)
+        {
+            const uint8_t opcode = code[pc - 0x8000];
+            const uint8_t operand = pc - 0x8000 + 1 < static_cast<int>(code.size()) ? code[pc - 0x8000 + 1] : 0;
+            uint8_t& memory = ram[operand];
+            switch (opcode)
+            {
+                case 0xA9: a = operand; setNZ(a); pc += 2; break; // LDA #
+                case 0xA5: a = memory; setNZ(a); pc += 2; break; // LDA zp
+                case 0xA2: x = operand; setNZ(x); pc += 2; break; // LDX #
+                case 0xA0: y = operand; setNZ(y); pc += 2; break; // LDY #
+                case 0x85: memory = a; pc += 2; break; // STA zp
+                case 0x69: adc(operand); pc += 2; break; // ADC #
+                case 0x65: adc(memory); pc += 2; break; // ADC zp
+                case 0xE9: sbc(operand); pc += 2; break; // SBC #
+                case 0xE5: sbc(memory); pc += 2; break; // SBC zp
+                case 0x29: a &= operand; setNZ(a); pc += 2; break; // AND #
+                case 0x09: a |= operand; setNZ(a); pc += 2; break; // ORA #
+                case 0x49: a ^= operand; setNZ(a); pc += 2; break; // EOR #
+                case 0xC9: compare(a, operand); pc += 2; break; // CMP #
+                case 0xE0: compare(x, operand); pc += 2; break; // CPX #
+                case 0xC0: compare(y, operand); pc += 2; break; // CPY #
+                case 0x89: setFlag(STATUS_ZERO, (a & operand) == 0); pc += 2; break; // BIT #
+                case 0x24: // BIT zp
+                    setFlag(STATUS_NEGATIVE, memory & 0x80);
+                    setFlag(STATUS_OVERFLOW, memory & 0x40);
+                    setFlag(STATUS_ZERO, (a & memory) == 0);
+                    pc += 2;
+                    break;
+                case 0x04: setFlag(STATUS_ZERO, (a & memory) == 0); memory |= a; pc += 2; break; // TSB zp
+                case 0x14: setFlag(STATUS_ZERO, (a & memory) == 0); memory &= ~a; pc += 2; break; // TRB zp
+                case 0xE6: setNZ(++memory); pc += 2; break; // INC zp
+                case 0xC6: setNZ(--memory); pc += 2; break; // DEC zp
+                case 0x06: case 0x26: case 0x46: case 0x66: memory = shift(opcode, memory); pc += 2; break; // Shift zp
+                case 0x0A: case 0x2A: case 0x4A: case 0x6A: a = shift(opcode, a); pc += 1; break; // Shift A
+                case 0x1A: setNZ(++a); pc += 1; break; // INC A
+                case 0x3A: setNZ(--a); pc += 1; break; // DEC A
+                case 0xE8: setNZ(++x); pc += 1; break; // INX
+                case 0xCA: setNZ(--x); pc += 1; break; // DEX
+                case 0xC8: setNZ(++y); pc += 1; break; // INY
+                case 0x88: setNZ(--y); pc += 1; break; // DEY
+                case 0xAA: x = a; setNZ(x); pc += 1; break; // TAX
+                case 0x8A: a = x; setNZ(a); pc += 1; break; // TXA
+                case 0xA8: y = a; setNZ(y); pc += 1; break; // TAY
+                case 0x98: a = y; setNZ(a); pc += 1; break; // TYA
+                case 0x9A: sp = x; pc += 1; break; // TXS
+                case 0x18: setFlag(STATUS_CARRY, false); pc += 1; break; // CLC
+                case 0x38: setFlag(STATUS_CARRY, true); pc += 1; break; // SEC
+                case 0xB8: setFlag(STATUS_OVERFLOW, false); pc += 1; break; // CLV
+                case 0xD8: setFlag(STATUS_DECIMAL, false); pc += 1; break; // CLD
+                case 0xF8: setFlag(STATUS_DECIMAL, true); pc += 1; break; // SED
+                case 0x48: push(a); pc += 1; break; // PHA
+                case 0xDA: push(x); pc += 1; break; // PHX
+                case 0x5A: push(y); pc += 1; break; // PHY
+                case 0x08: pushed = status; push(status); pc += 1; break; // PHP
+                case 0x68: a = pull(); setNZ(a); pc += 1; break; // PLA
+                case 0xFA: x = pull(); setNZ(x); pc += 1; break; // PLX
+                case 0x7A: y = pull(); setNZ(y); pc += 1; break; // PLY
+                case 0x28: status = pull() & ~STATUS_BREAK; pc += 1; break; // PLP
+                case 0x10: pc += 2; branch(!(status & STATUS_NEGATIVE), operand); break; // BPL
+                case 0x30: pc += 2; branch(status & STATUS_NEGATIVE, operand); break; // BMI
+                case 0x50: pc += 2; branch(!(status & STATUS_OVERFLOW), operand); break; // BVC
+                case 0x70: pc += 2; branch(status & STATUS_OVERFLOW, operand); break; // BVS
+                case 0x90: pc += 2; branch(!(status & STATUS_CARRY), operand); break; // BCC
+                case 0xB0: pc += 2; branch(status & STATUS_CARRY, operand); break; // BCS
+                case 0xD0: pc += 2; branch(!(status & STATUS_ZERO), operand); break; // BNE
+                case 0xF0: pc += 2; branch(status & STATUS_ZERO, operand); break; // BEQ
+                default: FAIL() << "No model for opcode " << std::hex << static_cast<int>(opcode);
+            }
+        }
+    };
+
+    // Random instructions, each followed by a PHP so every status byte is also seen as the CPU pushes it.
+    // Branches skip a LDY # when taken, pulls take back what was pushed and zero page is $10 to $17.
+    std::vector<uint8_t> makeRandomProgram(std::mt19937& random, size_t size)
+    {
+        constexpr uint8_t IMMEDIATE[] = { 0xA9, 0xA2, 0xA0, 0x69, 0xE9, 0x29, 0x09, 0x49, 0xC9, 0xE0, 0xC0, 0x89 };
+        constexpr uint8_t ZERO_PAGE[] = { 0xA5, 0x85, 0x65, 0xE5, 0x24, 0x04, 0x14, 0xE6, 0xC6, 0x06, 0x26, 0x46, 0x66 };
+        constexpr uint8_t IMPLIED[] = {
+            0x0A, 0x2A, 0x4A, 0x6A, 0x1A, 0x3A, 0xE8, 0xCA, 0xC8, 0x88, 0xAA, 0x8A, 0xA8, 0x98,
+            0x18, 0x38, 0xB8, 0xD8, 0xF8, 0x48, 0xDA, 0x5A, 0x68, 0xFA, 0x7A, 0x28,
+        };
+        constexpr uint8_t BRANCHES[] = { 0x10, 0x30, 0x50, 0x70, 0x90, 0xB0, 0xD0, 0xF0 };
+        auto pick = [&random](const auto& choices) {
+            return choices[std::uniform_int_distribution<size_t>(0, std::size(choices) - 1)(random)];
+        };
+        std::uniform_int_distribution<int> byte(0x00, 0xFF);
+        std::uniform_int_distribution<int> kind(0, 9);
+
+        std::vector<uint8_t> program;
+        int depth = 0;
+        while (program.size() < size)
+        {
+            switch (kind(random))
+            {
+                case 0: case 1: case 2:
+                    program.insert(program.end(), { pick(IMMEDIATE), static_cast<uint8_t>(byte(random)) });
+                    break;
+                case 3: case 4:
+                    program.insert(program.end(), { pick(ZERO_PAGE), static_cast<uint8_t>(0x10 + (byte(random) & 0x07)) });
+                    break;
+                case 5:
+                    program.insert(program.end(), { pick(BRANCHES), 0x02, 0xA0, static_cast<uint8_t>(byte(random)) });
+                    break;
+                default:
+                {
+                    const uint8_t opcode = pick(IMPLIED);
+                    const bool pull = opcode == 0x68 || opcode == 0xFA || opcode == 0x7A || opcode == 0x28;
+                    const bool push = opcode == 0x48 || opcode == 0xDA || opcode == 0x5A;
+                    if (pull && depth == 0)
+                    {
+                        continue;
+                    }
+                    depth += push ? 1 : pull ? -1 : 0;
+                    program.push_back(opcode);
+                    break;
+                }
+            }
+            program.push_back(0x08); // PHP
+            depth++;
+            if (depth >= 0x40)
+            {
+                // LDX #$FF, PHP, TXS, PHP
+                program.insert(program.end(), { 0xA2, 0xFF, 0x08, 0x9A, 0x08 });
+                depth = 1;
+            }
+        }
+        return program;
+    }
+}
+
+class StatusModelTest : public CPUInstructionTest {
+protected:
+    std::unique_ptr<devices::SRAM62256> ram;
+    // Second machine running the same ROM on the clock-phase core
+    std::shared_ptr<core::Bus> referenceBus;
+    std::unique_ptr<devices::W65C02S> referenceCpu;
+    std::unique_ptr<devices::EEPROM28C256> referenceRom;
+    std::unique_ptr<devices::SRAM62256> referenceRam;
+
+    void SetUp() override {
+        CPUInstructionTest::SetUp();
+        ram = std::make_unique<devices::SRAM62256>(bus);
+        bus->addSlave(ram.get());
+        referenceBus = std::make_shared<core::Bus>();
+        referenceCpu = std::make_unique<devices::W65C02S>(referenceBus);
+        referenceCpu->reset();
+        referenceCpu->setResetStage(2);
+        referenceRam = std::make_unique<devices::SRAM62256>(referenceBus);
+        referenceBus->addSlave(referenceRam.get());
+    }
+
+    void TearDown() override {
+        referenceCpu.reset();
+        referenceRom.reset();
+        referenceRam.reset();
+        ram.reset();
+        CPUInstructionTest::TearDown();
+    }
+
+    void loadProgram(const std::vector<uint8_t>& program) {
+        std::copy(program.begin(), program.end(), memory.begin());
+        rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+        bus->addSlave(rom.get());
+        referenceRom = std::make_unique<devices::EEPROM28C256>(memory, referenceBus);
+        referenceBus->addSlave(referenceRom.get());
+        cpu->setProgramCounter(0x8000);
+        referenceCpu->setProgramCounter(0x8000);
+    }
+
+    void expectMatchesModel(const devices::W65C02S& core, devices::SRAM62256& coreRam, const EagerCPU& model,
+        uint8_t opcode, const char* name) {
+        EXPECT_EQ(core.getStatus(), model.status) << name;
+        EXPECT_EQ(core.getProgramCounter(), model.pc) << name;
+        EXPECT_EQ(core.getAccumulator(), model.a) << name;
+        EXPECT_EQ(core.getXRegister(), model.x) << name;
+        EXPECT_EQ(core.getYRegister(), model.y) << name;
+        EXPECT_EQ(core.getStackPointer(), model.sp) << name;
+        if (opcode == 0x08)
+        {
+            EXPECT_EQ(coreRam.getMemory()[0x0100 + static_cast<uint8_t>(model.sp + 1)], model.pushed) << name << " PHP";
+        }
+    }
+};
+
+TEST(StatusRegisterTest, SetAndGetRoundTripEveryByte)
+{
+    for (int value = 0; value < 0x100; ++value)
+    {
+        StatusRegister status(static_cast<uint8_t>(value));
+        EXPECT_EQ(status.get(), value);
+        EXPECT_EQ(status.zero(), (value & STATUS_ZERO) != 0);
+        EXPECT_EQ(status.negative(), (value & STATUS_NEGATIVE) != 0);
+    }
+}
+
+TEST(StatusRegisterTest, BitTakesNAndZFromDifferentBytes)
+{
+    StatusRegister status;
+    status.setNZ(0x80, 0x00);
+    EXPECT_EQ(status.get(), STATUS_NEGATIVE | STATUS_ZERO);
+    status.setZ(0x01);
+    EXPECT_EQ(status.get(), STATUS_NEGATIVE);
+    status.setFlags(0xFF);
+    EXPECT_EQ(status.get(), 0xFF & ~STATUS_ZERO); // N and Z in the flags are ignored
+}
+
+TEST_F(StatusModelTest, MatchesEagerModelOverRandomInstructions)
+{
+    std::mt19937 random(6502);
+    const auto program = makeRandomProgram(random, 0x7000);
+    loadProgram(program);
+
+    EagerCPU model;
+    model.status = cpu->getStatus();
+    referenceCpu->setStatus(model.status);
+    int instructions = 0;
+    while (model.pc < 0x8000 + program.size())
+    {
+        const uint8_t opcode = program[model.pc - 0x8000];
+        model.step(program);
+        const auto cycles = cpu->step();
+        ASSERT_GT(cycles, 0);
+        for (int i = 0; i < cycles; ++i)
+        {
+            referenceCpu->onClockStateChange(core::LOW);
+            referenceCpu->onClockStateChange(core::HIGH);
+        }
+        expectMatchesModel(*cpu, *ram, model, opcode, "instruction-stepped");
+        expectMatchesModel(*referenceCpu, *referenceRam, model, opcode, "clock-phase");
+        if (HasFailure())
+        {
+            FAIL() << "Diverged from the model after instruction " << instructions << ", opcode " << std::hex
+                << static_cast<int>(opcode) << " before " << model.pc;
+        }
+        instructions++;
+    }
+    EXPECT_GT(instructions, 8000);
+}
+
+TEST_F(CPUInstructionTest, PendingFlagsSurviveSaveAndLoad)
+{
+    // LDA #$00 leaves Z to be worked out from the result when read
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(Opcode::LDA_IMM);
+    memory[0xFFFD - MEMORY_OFFSET] = 0x00;
+    cpu->setStatus(STATUS_NEGATIVE | STATUS_CARRY);
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+
+    for (int i = 0; i < decodeOpcode(Opcode::LDA_IMM).cycles; ++i)
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+
+    std::vector<uint8_t> state;
+    core::StateWriter writer(state);
+    cpu->saveState(writer);
+
+    devices::W65C02S restored(bus);
+    core::StateReader reader(state);
+    restored.loadState(reader);
+    EXPECT_EQ(cpu->getStatus(), STATUS_ZERO | STATUS_CARRY);
+    EXPECT_EQ(restored.getStatus(), STATUS_ZERO | STATUS_CARRY);
+}
@@ -0,0 +1,774 @@
+// Test suite for the instruction-stepped core, checked against the clock-phase core
+#include "cpu_instruction_test.h"
+#include "devices/SRAM62256/SRAM62256.h"
+#include <cstdint>
+
+using namespace EaterEmulator;
+
+namespace
+{
+    // Loop over loads, stores, arithmetic, read-modify-write, stack and jumps on every addressing mode
+    const std::vector<uint8_t> MIXED_PROGRAM = {
+        0xA2, 0xFF,         // 8000: LDX #$FF
+        0x9A,               //       TXS
+        0xA9, 0x12,         //       LDA #$12
+        0x85, 0x10,         //       STA $10
+        0xA9, 0x34,         //       LDA #$34
+        0x8D, 0x11, 0x02,   //       STA $0211
+        0xA9, 0x00,         //       LDA #$00
+        0x85, 0x20,         //       STA $20
+        0xA9, 0x02,         //       LDA #$02
+        0x85, 0x21,         //       STA $21
+        0xA0, 0x03,         //       LDY #$03
+        0xB1, 0x20,         // loop: LDA ($20),Y
+        0x18,               //       CLC
+        0x65, 0x10,         //       ADC $10
+        0x91, 0x20,         //       STA ($20),Y
+        0xA2, 0x01,         //       LDX #$01
+        0xB5, 0x0F,         //       LDA $0F,X
+        0x2A,               //       ROL A
+        0x06, 0x10,         //       ASL $10
+        0xF6, 0x0F,         //       INC $0F,X
+        0xCE, 0x11, 0x02,   //       DEC $0211
+        0x49, 0xFF,         //       EOR #$FF
+        0x19, 0x11, 0x02,   //       ORA $0211,Y
+        0x21, 0x1F,         //       AND ($1F,X)
+        0xC9, 0x40,         //       CMP #$40
+        0xE0, 0x01,         //       CPX #$01
+        0xC4, 0x10,         //       CPY $10
+        0x24, 0x10,         //       BIT $10
+        0x48,               //       PHA
+        0x08,               //       PHP
+        0x68,               //       PLA
+        0x28,               //       PLP
+        0x20, 0x54, 0x80,   //       JSR sub
+        0x38,               //       SEC
+        0xE9, 0x05,         //       SBC #$05
+        0x6E, 0x11, 0x02,   //       ROR $0211
+        0x4A,               //       LSR A
+        0x88,               //       DEY
+        0xD0, 0xCD,         //       BNE loop
+        0xA9, 0x00,         //       LDA #$00
+        0x85, 0x30,         //       STA $30
+        0xA9, 0x80,         //       LDA #$80
+        0x85, 0x31,         //       STA $31
+        0x6C, 0x30, 0x00,   //       JMP ($0030)
+        0xAA,               // sub:  TAX
+        0xE8,               //       INX
+        0x8A,               //       TXA
+        0x60,               //       RTS
+    };
+
+    // Loop over the instructions the 65C02 added to the NMOS set
+    const std::vector<uint8_t> CMOS_PROGRAM = {
+        0xA2, 0xFF,         // 8000:       LDX #$FF
+        0x9A,               //             TXS
+        0xA9, 0x00,         //             LDA #$00
+        0x85, 0x20,         //             STA $20
+        0xA9, 0x02,         //             LDA #$02
+        0x85, 0x21,         //             STA $21
+        0xA0, 0x05,         //             LDY #$05
+        0xB2, 0x20,         // 800D: loop: LDA ($20)
+        0x69, 0x11,         //             ADC #$11
+        0x92, 0x20,         //             STA ($20)
+        0x5A,               //             PHY
+        0xDA,               //             PHX
+        0xFA,               //             PLX
+        0x7A,               //             PLY
+        0x64, 0x10,         //             STZ $10
+        0x04, 0x10,         //             TSB $10
+        0x1C, 0x00, 0x02,   //             TRB $0200
+        0xB7, 0x10,         //             SMB3 $10
+        0x07, 0x10,         //             RMB0 $10
+        0xBF, 0x10, 0x02,   //             BBS3 $10,skip
+        0xE8,               //             INX
+        0xE8,               //             INX
+        0x1F, 0x10, 0x01,   // 8027: skip: BBR1 $10,next
+        0xE8,               //             INX
+        0x89, 0x40,         // 802B: next: BIT #$40
+        0x34, 0x0F,         //             BIT $0F,X
+        0x3C, 0xF0, 0x01,   //             BIT $01F0,X
+        0x74, 0x11,         //             STZ $11,X
+        0x9C, 0x01, 0x02,   //             STZ $0201
+        0x9E, 0x10, 0x02,   //             STZ $0210,X
+        0x12, 0x20,         //             ORA ($20)
+        0x32, 0x20,         //             AND ($20)
+        0x52, 0x20,         //             EOR ($20)
+        0xD2, 0x20,         //             CMP ($20)
+        0xF2, 0x20,         //             SBC ($20)
+        0x88,               //             DEY
+        0xF0, 0x02,         //             BEQ done
+        0x80, 0xC4,         //             BRA loop
+        0xA2, 0x02,         // 8049: done: LDX #$02
+        0x7C, 0x4E, 0x80,   //             JMP (table,X)
+        0x00, 0x00,         // 804E: table
+        0x00, 0x80,         //             .word $8000
+    };
+}
+
+class StepTest : public CPUInstructionTest {
+protected:
+    // Second machine running the same ROM on the clock-phase core
+    std::shared_ptr<core::Bus> referenceBus;
+    std::unique_ptr<devices::W65C02S> referenceCpu;
+    std::unique_ptr<devices::EEPROM28C256> referenceRom;
+    std::unique_ptr<devices::SRAM62256> ram;
+    std::unique_ptr<devices::SRAM62256> referenceRam;
+
+    void SetUp() override {
+        CPUInstructionTest::SetUp();
+        cpu->setResetStage(0);
+        referenceBus = std::make_shared<core::Bus>();
+        referenceCpu = std::make_unique<devices::W65C02S>(referenceBus);
+        referenceCpu->reset();
+        ram = std::make_unique<devices::SRAM62256>(bus);
+        bus->addSlave(ram.get());
+        referenceRam = std::make_unique<devices::SRAM62256>(referenceBus);
+        referenceBus->addSlave(referenceRam.get());
+    }
+
+    void TearDown() override {
+        referenceCpu.reset();
+        referenceRom.reset();
+        referenceRam.reset();
+        ram.reset();
+        CPUInstructionTest::TearDown();
+    }
+
+    void loadProgram(const std::vector<uint8_t>& program) {
+        std::copy(program.begin(), program.end(), memory.begin());
+        memory[0xFFFC - MEMORY_OFFSET] = 0x00; // Reset vector low
+        memory[0xFFFD - MEMORY_OFFSET] = 0x80; // Reset vector high (0x8000)
+        rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+        bus->addSlave(rom.get());
+        referenceRom = std::make_unique<devices::EEPROM28C256>(memory, referenceBus);
+        referenceBus->addSlave(referenceRom.get());
+    }
+
+    void clockReference(int cycles) {
+        for (int i = 0; i < cycles; ++i) {
+            referenceCpu->onClockStateChange(core::LOW);
+            referenceCpu->onClockStateChange(core::HIGH);
+        }
+    }
+
+    void expectSameState() {
+        EXPECT_EQ(cpu->getAccumulator(), referenceCpu->getAccumulator());
+        EXPECT_EQ(cpu->getXRegister(), referenceCpu->getXRegister());
+        EXPECT_EQ(cpu->getYRegister(), referenceCpu->getYRegister());
+        EXPECT_EQ(cpu->getStackPointer(), referenceCpu->getStackPointer());
+        EXPECT_EQ(cpu->getProgramCounter(), referenceCpu->getProgramCounter());
+        EXPECT_EQ(cpu->getStatus(), referenceCpu->getStatus());
+        EXPECT_EQ(cpu->getCycleCount(), referenceCpu->getCycleCount());
+        EXPECT_EQ(cpu->getInstructionCount(), referenceCpu->getInstructionCount());
+    }
+};
+
+TEST_F(StepTest, ResetReadsVector)
+{
+    loadProgram({ static_cast<uint8_t>(Opcode::NOP) });
+
+    EXPECT_EQ(cpu->step(), 2);
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8000);
+}
+
+TEST_F(StepTest, StepCreditsDecodeTableCycles)
+{
+    loadProgram({
+        static_cast<uint8_t>(Opcode::LDA_IMM), 0x42,
+        static_cast<uint8_t>(Opcode::STA_ABS), 0x00, 0x02,
+        static_cast<uint8_t>(Opcode::INC_ABSX), 0x00, 0x02,
+    });
+    cpu->step(); // Reset
+
+    EXPECT_EQ(cpu->step(), decodeOpcode(Opcode::LDA_IMM).cycles);
+    EXPECT_EQ(cpu->step(), decodeOpcode(Opcode::STA_ABS).cycles);
+    EXPECT_EQ(cpu->step(), decodeOpcode(Opcode::INC_ABSX).cycles);
+    EXPECT_EQ(cpu->getCycleCount(), 2u + 2 + 4 + 7);
+    EXPECT_EQ(ram->getMemory()[0x0200], 0x43);
+}
+
+TEST_F(StepTest, RunInstructionsReturnsCycles)
+{
+    loadProgram({
+        static_cast<uint8_t>(Opcode::LDX_IMM), 0x05,
+        static_cast<uint8_t>(Opcode::DEX),
+        static_cast<uint8_t>(Opcode::BNE), 0xFD,
+        static_cast<uint8_t>(Opcode::NOP),
+    });
+    cpu->step(); // Reset
+
+    // LDX, then 5 x (DEX, BNE), then NOP. BNE is taken on the same page 4 times.
+    auto cycles = cpu->runInstructions(1 + 5 * 2 + 1);
+    EXPECT_EQ(cycles, 2u + 5 * (2 + 2) + 4 + 2);
+    EXPECT_EQ(cpu->getXRegister(), 0x00);
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8006);
+}
+
+TEST_F(StepTest, MatchesClockPhaseCore)
+{
+    loadProgram(MIXED_PROGRAM);
+
+    for (int i = 0; i < 500; ++i)
+    {
+        auto cycles = cpu->step();
+        ASSERT_GT(cycles, 0);
+        clockReference(cycles);
+        expectSameState();
+        if (HasFailure())
+        {
+            FAIL() << "Cores diverged after instruction " << i << " at PC " << std::hex << cpu->getProgramCounter();
+        }
+    }
+    EXPECT_EQ(ram->getMemory(), referenceRam->getMemory());
+    // The loop ran from decoded ROM
+    EXPECT_GT(cpu->getDecodeCache().getDecodedCount(), 0u);
+}
+
+TEST_F(StepTest, IRQMatchesClockPhaseCore)
+{
+    memory[0xFFFE - MEMORY_OFFSET] = 0x00; // IRQ vector low
+    memory[0xFFFF - MEMORY_OFFSET] = 0x90; // IRQ vector high (0x9000)
+    memory[0x9000 - MEMORY_OFFSET] = static_cast<uint8_t>(Opcode::RTI);
+    loadProgram({
+        static_cast<uint8_t>(Opcode::CLI),
+        static_cast<uint8_t>(Opcode::NOP),
+        static_cast<uint8_t>(Opcode::NOP),
+    });
+
+    clockReference(cpu->step()); // Reset
+    clockReference(cpu->step()); // CLI
+    cpu->setIRQ(core::LOW);
+    referenceCpu->setIRQ(core::LOW);
+
+    EXPECT_EQ(cpu->step(), decodeOpcode(Opcode::BRK).cycles);
+    clockReference(decodeOpcode(Opcode::BRK).cycles);
+    expectSameState();
+    EXPECT_EQ(cpu->getProgramCounter(), 0x9000);
+    EXPECT_EQ(cpu->getStatus() & devices::STATUS_INTERRUPT, devices::STATUS_INTERRUPT);
+}
+
+TEST_F(StepTest, ScheduledEventRaisesIRQBetweenInstructions)
+{
+    memory[0xFFFE - MEMORY_OFFSET] = 0x00; // IRQ vector low
+    memory[0xFFFF - MEMORY_OFFSET] = 0x90; // IRQ vector high (0x9000)
+    loadProgram({
+        static_cast<uint8_t>(Opcode::CLI),
+        static_cast<uint8_t>(Opcode::NOP),
+        static_cast<uint8_t>(Opcode::NOP),
+        static_cast<uint8_t>(Opcode::NOP),
+    });
+
+    // Reset (2) + CLI (2) + NOP (2) end on cycle 6, the event is due in the middle of the second NOP
+    bus->getScheduler().schedule(7, [this](uint64_t) { cpu->setIRQ(core::LOW); });
+
+    cpu->runInstructions(4); // Reset, CLI, NOP, NOP
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8003);
+
+    EXPECT_EQ(cpu->step(), decodeOpcode(Opcode::BRK).cycles);
+    EXPECT_EQ(cpu->getProgramCounter(), 0x9000);
+}
+
+TEST_F(StepTest, RunsCodeFromRAMWithoutCaching)
+{
+    // Copies INX; RTS into RAM at $0300 and calls it, then changes it to DEX; RTS and calls it again
+    loadProgram({
+        0xA9, 0xE8,         // 8000: LDA #$E8   ; INX
+        0x8D, 0x00, 0x03,   //       STA $0300
+        0xA9, 0x60,         //       LDA #$60   ; RTS
+        0x8D, 0x01, 0x03,   //       STA $0301
+        0xA2, 0x10,         //       LDX #$10
+        0x20, 0x00, 0x03,   //       JSR $0300
+        0xA9, 0xCA,         //       LDA #$CA   ; DEX
+        0x8D, 0x00, 0x03,   //       STA $0300
+        0x20, 0x00, 0x03,   //       JSR $0300
+        0x20, 0x00, 0x03,   //       JSR $0300
+        0xEA,               //       NOP
+    });
+    cpu->step(); // Reset
+
+    cpu->runInstructions(8); // Up to the first RTS
+    EXPECT_EQ(cpu->getXRegister(), 0x11);
+    cpu->runInstructions(5);
+    EXPECT_EQ(cpu->getXRegister(), 0x10);
+    cpu->runInstructions(2);
+    EXPECT_EQ(cpu->getXRegister(), 0x0F);
+}
+
+TEST_F(StepTest, BusMonitorSeesEveryInstructionFetch)
+{
+    loadProgram({
+        static_cast<uint8_t>(Opcode::LDX_IMM), 0x05,
+        static_cast<uint8_t>(Opcode::DEX),
+        static_cast<uint8_t>(Opcode::BNE), 0xFD,
+        static_cast<uint8_t>(Opcode::NOP),
+    });
+    cpu->runInstructions(3); // Reset, LDX, DEX: caches the start of the program
+
+    // Slave without ranges, notified of every access
+    class Monitor : public core::BusSlave
+    {
+    public:
+        using core::BusSlave::BusSlave;
+        void handleBusNotification(uint16_t address, [[maybe_unused]] uint8_t rwb) override { accesses.push_back(address); }
+        std::string getName() const override { return "Monitor"; }
+        std::vector<uint16_t> accesses;
+    } monitor(bus);
+    bus->addSlave(&monitor);
+
+    cpu->step(); // BNE, taken
+    cpu->step(); // DEX
+    EXPECT_EQ(monitor.accesses, std::vector<uint16_t>({ 0x8003, 0x8004, 0x8002 }));
+    EXPECT_EQ(cpu->getDecodeCache().getDecodedCount(), 0u);
+    EXPECT_EQ(cpu->getXRegister(), 0x03);
+}
+
+TEST_F(StepTest, ThreadedMatchesClockPhaseCore)
+{
+    loadProgram(MIXED_PROGRAM);
+
+    for (int i = 0; i < 500; ++i)
+    {
+        auto cycles = cpu->runInstructionsThreaded(1);
+        ASSERT_GT(cycles, 0u);
+        clockReference(static_cast<int>(cycles));
+        expectSameState();
+        if (HasFailure())
+        {
+            FAIL() << "Cores diverged after instruction " << i << " at PC " << std::hex << cpu->getProgramCounter();
+        }
+    }
+    EXPECT_EQ(ram->getMemory(), referenceRam->getMemory());
+}
+
+TEST_F(StepTest, ThreadedBatchMatchesClockPhaseCore)
+{
+    loadProgram(MIXED_PROGRAM);
+
+    // Reset sequence included, the batch hands it to step()
+    auto cycles = cpu->runInstructionsThreaded(500);
+    clockReference(static_cast<int>(cycles));
+    expectSameState();
+    EXPECT_EQ(ram->getMemory(), referenceRam->getMemory());
+}
+
+TEST_F(StepTest, CMOSInstructionsMatchClockPhaseCore)
+{
+    loadProgram(CMOS_PROGRAM);
+
+    for (int i = 0; i < 500; ++i)
+    {
+        auto cycles = cpu->step();
+        ASSERT_GT(cycles, 0);
+        clockReference(cycles);
+        expectSameState();
+        if (HasFailure())
+        {
+            FAIL() << "Cores diverged after instruction " << i << " at PC " << std::hex << cpu->getProgramCounter();
+        }
+    }
+    EXPECT_EQ(ram->getMemory(), referenceRam->getMemory());
+}
+
+TEST_F(StepTest, ThreadedCMOSInstructionsMatchClockPhaseCore)
+{
+    loadProgram(CMOS_PROGRAM);
+
+    auto cycles = cpu->runInstructionsThreaded(500);
+    clockReference(static_cast<int>(cycles));
+    expectSameState();
+    EXPECT_EQ(ram->getMemory(), referenceRam->getMemory());
+}
+
+TEST_F(StepTest, ReservedOpcodesAreNOPsInBothCores)
+{
+    // Every opcode without an instruction, with operands pointing at RAM
+    std::vector<uint8_t> program;
+    uint64_t expected = 2; // Reset
+    for (int value = 0; value < 0x100; ++value)
+    {
+        const auto& info = decodeOpcode(static_cast<Opcode>(value));
+        if (!info.reserved)
+        {
+            continue;
+        }
+        program.push_back(static_cast<uint8_t>(value));
+        program.insert(program.end(), instructionLength(info.addressingMode) - 1, 0x02);
+        expected += info.cycles;
+    }
+    loadProgram(program);
+
+    cpu->step(); // Reset
+    clockReference(2);
+    for (int value = 0; value < 0x100; ++value)
+    {
+        const auto& info = decodeOpcode(static_cast<Opcode>(value));
+        if (!info.reserved)
+        {
+            continue;
+        }
+        EXPECT_EQ(cpu->step(), info.cycles) << std::hex << value;
+        clockReference(info.cycles);
+        expectSameState();
+    }
+    EXPECT_EQ(cpu->getCycleCount(), expected);
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8000 + program.size());
+}
+
+TEST_F(StepTest, ThreadedReservedOpcodesMatchClockPhaseCore)
+{
+    std::vector<uint8_t> program;
+    for (int value = 0; value < 0x100; ++value)
+    {
+        const auto& info = decodeOpcode(static_cast<Opcode>(value));
+        if (info.reserved)
+        {
+            program.push_back(static_cast<uint8_t>(value));
+            program.insert(program.end(), instructionLength(info.addressingMode) - 1, 0x02);
+        }
+    }
+    loadProgram(program);
+
+    auto cycles = cpu->runInstructionsThreaded(1 + 44);
+    clockReference(static_cast<int>(cycles));
+    expectSameState();
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8000 + program.size());
+}
+
+TEST_F(StepTest, DecimalModeMatchesClockPhaseCore)
+{
+    loadProgram({
+        0xF8,               // 8000:       SED
+        0xA9, 0x00,         //             LDA #$00
+        0xA2, 0x00,         //             LDX #$00
+        0x18,               // 8005: loop: CLC
+        0x69, 0x07,         //             ADC #$07
+        0x85, 0x10,         //             STA $10
+        0x38,               //             SEC
+        0xE5, 0x11,         //             SBC $11
+        0x65, 0x10,         //             ADC $10
+        0xE8,               //             INX
+        0xD0, 0xF3,         //             BNE loop
+        0xD8,               //             CLD
+        0x69, 0x07,         //             ADC #$07
+        0x4C, 0x00, 0x80,   //             JMP $8000
+    });
+    ram->getMemory()[0x0011] = 0x19;
+    referenceRam->getMemory()[0x0011] = 0x19;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto cycles = cpu->step();
+        ASSERT_GT(cycles, 0);
+        clockReference(cycles);
+        expectSameState();
+        if (HasFailure())
+        {
+            FAIL() << "Cores diverged after instruction " << i << " at PC " << std::hex << cpu->getProgramCounter();
+        }
+    }
+    EXPECT_EQ(ram->getMemory(), referenceRam->getMemory());
+}
+
+TEST_F(StepTest, DecimalModeAddsACycleToADCAndSBC)
+{
+    loadProgram({
+        static_cast<uint8_t>(Opcode::SED),
+        static_cast<uint8_t>(Opcode::ADC_IMM), 0x01,
+        static_cast<uint8_t>(Opcode::SBC_IMM), 0x01,
+        static_cast<uint8_t>(Opcode::CMP_IMM), 0x01,
+        static_cast<uint8_t>(Opcode::CLD),
+        static_cast<uint8_t>(Opcode::ADC_IMM), 0x01,
+    });
+    cpu->step(); // Reset
+
+    EXPECT_EQ(cpu->step(), 2);
+    EXPECT_EQ(cpu->step(), 3);
+    EXPECT_EQ(cpu->step(), 3);
+    EXPECT_EQ(cpu->step(), 2);
+    EXPECT_EQ(cpu->step(), 2);
+    EXPECT_EQ(cpu->step(), 2);
+}
+
+TEST_F(StepTest, ThreadedDecimalModeMatchesClockPhaseCore)
+{
+    loadProgram({
+        0xF8,               // 8000:       SED
+        0x18,               // 8001: loop: CLC
+        0x69, 0x01,         //             ADC #$01
+        0xE9, 0x00,         //             SBC #$00
+        0x4C, 0x01, 0x80,   //             JMP loop
+    });
+
+    auto cycles = cpu->runInstructionsThreaded(400);
+    clockReference(static_cast<int>(cycles));
+    expectSameState();
+}
+
+TEST_F(StepTest, ThreadedTakesIRQ)
+{
+    memory[0xFFFE - MEMORY_OFFSET] = 0x00; // IRQ vector low
+    memory[0xFFFF - MEMORY_OFFSET] = 0x90; // IRQ vector high (0x9000)
+    memory[0x9000 - MEMORY_OFFSET] = static_cast<uint8_t>(Opcode::RTI);
+    loadProgram({
+        static_cast<uint8_t>(Opcode::CLI),
+        static_cast<uint8_t>(Opcode::NOP),
+        static_cast<uint8_t>(Opcode::NOP),
+    });
+    // Reset (2) + CLI (2) end on cycle 4, the event is due in the middle of the first NOP
+    bus->getScheduler().schedule(5, [this](uint64_t) { cpu->setIRQ(core::LOW); });
+
+    EXPECT_EQ(cpu->runInstructionsThreaded(4), 2u + 2u + 2u + decodeOpcode(Opcode::BRK).cycles);
+    EXPECT_EQ(cpu->getProgramCounter(), 0x9000);
+    EXPECT_EQ(cpu->getStatus() & devices::STATUS_INTERRUPT, devices::STATUS_INTERRUPT);
+}
+
+TEST_F(StepTest, RunCyclesFastForwardsJumpToSelf)
+{
+    memory[0xFFFE - MEMORY_OFFSET] = 0x00; // IRQ vector low
+    memory[0xFFFF - MEMORY_OFFSET] = 0x90; // IRQ vector high (0x9000)
+    const std::vector<uint8_t> handler = {
+        0xE8,               // 9000:       INX
+        0x4C, 0x01, 0x90,   // 9001: halt: JMP halt
+    };
+    std::copy(handler.begin(), handler.end(), memory.begin() + (0x9000 - MEMORY_OFFSET));
+    loadProgram({
+        0x58,               // 8000:       CLI
+        0xA9, 0x42,         //             LDA #$42
+        0x4C, 0x03, 0x80,   // 8003: loop: JMP loop
+    });
+    bus->getScheduler().schedule(100'001, [this](uint64_t) { cpu->setIRQ(core::LOW); });
+    referenceBus->getScheduler().schedule(100'001, [this](uint64_t) { referenceCpu->setIRQ(core::LOW); });
+
+    EXPECT_GE(cpu->runCycles(200'000), 200'000u);
+    clockReference(static_cast<int>(cpu->getCycleCount()));
+    expectSameState();
+    EXPECT_EQ(cpu->getXRegister(), 1);
+    EXPECT_EQ(cpu->getProgramCounter(), 0x9001);
+    EXPECT_GT(cpu->getFastForwardedCycles(), 199'000u);
+}
+
+TEST_F(StepTest, RunCyclesFastForwardsPollingLoop)
+{
+    memory[0xFFFE - MEMORY_OFFSET] = 0x00; // IRQ vector low
+    memory[0xFFFF - MEMORY_OFFSET] = 0x90; // IRQ vector high (0x9000)
+    const std::vector<uint8_t> handler = {
+        0xA9, 0x01,         // 9000:       LDA #$01
+        0x8D, 0x00, 0x02,   //             STA $0200
+        0x4C, 0x0A, 0x80,   //             JMP done
+    };
+    std::copy(handler.begin(), handler.end(), memory.begin() + (0x9000 - MEMORY_OFFSET));
+    loadProgram({
+        0x58,               // 8000:       CLI
+        0xAD, 0x00, 0x02,   // 8001: wait: LDA $0200
+        0x29, 0x01,         //             AND #$01
+        0xF0, 0xF9,         //             BEQ wait
+        0xEA,               //             NOP
+        0xEA,               //             NOP
+        0xE8,               // 800A: done: INX
+        0x4C, 0x0A, 0x80,   //             JMP done
+    });
+    bus->getScheduler().schedule(50'003, [this](uint64_t) { cpu->setIRQ(core::LOW); });
+    referenceBus->getScheduler().schedule(50'003, [this](uint64_t) { referenceCpu->setIRQ(core::LOW); });
+
+    cpu->runCycles(100'000);
+    clockReference(static_cast<int>(cpu->getCycleCount()));
+    expectSameState();
+    EXPECT_EQ(ram->getMemory(), referenceRam->getMemory());
+    EXPECT_EQ(ram->getMemory()[0x0200], 0x01);
+    // The polling loop up to the interrupt was skipped, the INX loop after it is not idle
+    EXPECT_GT(cpu->getFastForwardedCycles(), 49'000u);
+    EXPECT_LT(cpu->getFastForwardedCycles(), 50'003u);
+}
+
+TEST_F(StepTest, InstructionsLeaveIdleLoopsRunning)
+{
+    loadProgram({
+        0x4C, 0x00, 0x80,   // 8000: loop: JMP loop
+    });
+
+    EXPECT_EQ(cpu->runInstructions(1001), 2u + 1000u * 3u);
+    EXPECT_EQ(cpu->getFastForwardedCycles(), 0u);
+}
+
+TEST_F(StepTest, RunCyclesFastForwardsBitBranchLoops)
+{
+    memory[0xFFFE - MEMORY_OFFSET] = 0x00; // IRQ vector low
+    memory[0xFFFF - MEMORY_OFFSET] = 0x90; // IRQ vector high (0x9000)
+    const std::vector<uint8_t> handler = {
+        0xF7, 0x10,         // 9000:       SMB7 $10
+        0x4C, 0x01, 0x80,   //             JMP wait
+    };
+    std::copy(handler.begin(), handler.end(), memory.begin() + (0x9000 - MEMORY_OFFSET));
+    loadProgram({
+        0x58,               // 8000:       CLI
+        0x7F, 0x10, 0xFD,   // 8001: wait: BBR7 $10,wait
+        0xE8,               //             INX
+        0x80, 0xFE,         // 8005: halt: BRA halt
+    });
+    bus->getScheduler().schedule(40'001, [this](uint64_t) { cpu->setIRQ(core::LOW); });
+    referenceBus->getScheduler().schedule(40'001, [this](uint64_t) { referenceCpu->setIRQ(core::LOW); });
+
+    EXPECT_GE(cpu->runCycles(100'000), 100'000u);
+    clockReference(static_cast<int>(cpu->getCycleCount()));
+    expectSameState();
+    EXPECT_EQ(ram->getMemory(), referenceRam->getMemory());
+    EXPECT_EQ(cpu->getXRegister(), 1);
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8005);
+    // Both the polling loop and the branch to itself were skipped
+    EXPECT_GT(cpu->getFastForwardedCycles(), 98'000u);
+}
+
+TEST_F(StepTest, RunCyclesSkipsWAIToScheduledIRQ)
+{
+    memory[0xFFFE - MEMORY_OFFSET] = 0x00; // IRQ vector low
+    memory[0xFFFF - MEMORY_OFFSET] = 0x90; // IRQ vector high (0x9000)
+    const std::vector<uint8_t> handler = {
+        0xE8,               // 9000: INX
+        0x40,               //       RTI
+    };
+    std::copy(handler.begin(), handler.end(), memory.begin() + (0x9000 - MEMORY_OFFSET));
+    loadProgram({
+        0x58,               // 8000:       CLI
+        0xCB,               // 8001: wait: WAI
+        0xC8,               //             INY
+        0x4C, 0x01, 0x80,   //             JMP wait
+    });
+    for (uint64_t cycle : {20'000u, 50'001u, 50'002u, 80'000u})
+    {
+        bus->getScheduler().schedule(cycle, [this](uint64_t) { cpu->setIRQ(core::LOW); });
+        bus->getScheduler().schedule(cycle + 8, [this](uint64_t) { cpu->setIRQ(core::HIGH); });
+        referenceBus->getScheduler().schedule(cycle, [this](uint64_t) { referenceCpu->setIRQ(core::LOW); });
+        referenceBus->getScheduler().schedule(cycle + 8, [this](uint64_t) { referenceCpu->setIRQ(core::HIGH); });
+    }
+
+    EXPECT_EQ(cpu->runCycles(100'000), 100'000u);
+    clockReference(100'000);
+    expectSameState();
+    EXPECT_EQ(cpu->getXRegister(), referenceCpu->getXRegister());
+    EXPECT_TRUE(cpu->isWaiting());
+    EXPECT_GT(cpu->getFastForwardedCycles(), 99'000u);
+}
+
+TEST_F(StepTest, WAIMatchesClockPhaseCoreOnMaskedIRQ)
+{
+    loadProgram({
+        0x78,               // 8000: SEI
+        0xCB,               //       WAI
+        0xC8,               //       INY
+        0xDB,               //       STP
+    });
+    bus->getScheduler().schedule(1'000, [this](uint64_t) { cpu->setIRQ(core::LOW); });
+    referenceBus->getScheduler().schedule(1'000, [this](uint64_t) { referenceCpu->setIRQ(core::LOW); });
+
+    while (cpu->getCycleCount() < 2'000)
+    {
+        cpu->step();
+    }
+    clockReference(static_cast<int>(cpu->getCycleCount()));
+    expectSameState();
+    EXPECT_EQ(cpu->getYRegister(), 1);
+    EXPECT_TRUE(cpu->isStopped());
+    EXPECT_EQ(cpu->getFastForwardedCycles(), 0u);
+}
+
+TEST_F(StepTest, ThreadedWaitsForIRQ)
+{
+    memory[0xFFFE - MEMORY_OFFSET] = 0x00; // IRQ vector low
+    memory[0xFFFF - MEMORY_OFFSET] = 0x90; // IRQ vector high (0x9000)
+    memory[0x9000 - MEMORY_OFFSET] = 0xDB; // STP
+    loadProgram({
+        0x58,               // 8000: CLI
+        0xCB,               //       WAI
+    });
+    bus->getScheduler().schedule(300, [this](uint64_t) { cpu->setIRQ(core::LOW); });
+    referenceBus->getScheduler().schedule(300, [this](uint64_t) { referenceCpu->setIRQ(core::LOW); });
+
+    const uint64_t cycles = cpu->runInstructionsThreaded(400);
+    EXPECT_EQ(cycles, cpu->getCycleCount());
+    clockReference(static_cast<int>(cycles));
+    expectSameState();
+    EXPECT_TRUE(cpu->isStopped());
+}
+
+TEST_F(StepTest, RunCyclesRunsOutTheClockAfterSTP)
+{
+    loadProgram({
+        0xDB,               // 8000: STP
+    });
+
+    EXPECT_EQ(cpu->runCycles(1'000'000), 1'000'000u);
+    EXPECT_TRUE(cpu->isStopped());
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8001);
+    EXPECT_EQ(cpu->getFastForwardedCycles(), 1'000'000u - 5u);
+}
+
+TEST_F(StepTest, BranchesAddTakenAndPageCrossingCycles)
+{
+    const std::vector<std::pair<uint16_t, std::vector<uint8_t>>> blocks = {
+        {0x8080, {0x80, 0x6E}},         // 8080: BRA $80F0
+        {0x80F0, {0xF0, 0x10}},         // 80F0: BEQ $8102
+        {0x80F4, {0x8F, 0x10, 0x10,     // 80F4: BBS0 $10,$8107
+                  0x0F, 0x10, 0x10}},   // 80F7: BBR0 $10,$810A
+        {0x8102, {0x80, 0xF0}},         // 8102: BRA $80F4
+        {0x810A, {0x0F, 0x10, 0x01,     // 810A: BBR0 $10,$810E
+                  0x00,                 //       BRK
+                  0xEA}},               // 810E: NOP
+    };
+    for (const auto& [address, code] : blocks)
+    {
+        std::copy(code.begin(), code.end(), memory.begin() + (address - MEMORY_OFFSET));
+    }
+    loadProgram({
+        0xA9, 0x00,         // 8000: LDA #$00
+        0xD0, 0x10,         //       BNE $8014
+        0xF0, 0x7A,         //       BEQ $8080
+    });
+
+    // Reset, LDA, BNE not taken, BEQ taken, BRA, BEQ and BRA across a page, BBS0 not taken,
+    // BBR0 taken across a page, BBR0 taken, NOP
+    const uint8_t expected[] = { 2, 2, 2, 3, 3, 4, 4, 5, 7, 6, 2 };
+    for (uint8_t cycles : expected)
+    {
+        EXPECT_EQ(cpu->step(), cycles) << "at PC " << std::hex << cpu->getProgramCounter();
+        clockReference(cycles);
+        expectSameState();
+    }
+    EXPECT_EQ(cpu->getProgramCounter(), 0x810F);
+}
+
+TEST_F(StepTest, ThreadedBranchesAddTakenAndPageCrossingCycles)
+{
+    const std::vector<uint8_t> loop = {
+        0xC8,               // 80FC: loop: INY
+        0xCA,               //             DEX
+        0xD0, 0xFC,         // 80FE:       BNE loop, back from the next page
+    };
+    std::copy(loop.begin(), loop.end(), memory.begin() + (0x80FC - MEMORY_OFFSET));
+    loadProgram({
+        0xA2, 0x05,         // 8000:       LDX #$05
+        0x4C, 0xFC, 0x80,   //             JMP loop
+    });
+
+    // Reset, LDX, JMP, then 5 x (INY, DEX, BNE) with BNE taken across the page 4 times
+    EXPECT_EQ(cpu->runInstructionsThreaded(3 + 5 * 3), 2u + 2 + 3 + 5 * (2 + 2 + 2) + 4 * 2);
+    clockReference(static_cast<int>(cpu->getCycleCount()));
+    expectSameState();
+    EXPECT_EQ(cpu->getYRegister(), 5);
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8100);
+}
+
+TEST_F(StepTest, RunCyclesFastForwardsBranchAcrossAPage)
+{
+    memory[0x80FE - MEMORY_OFFSET] = 0x80;  // 80FE: halt: BRA halt, back from the next page
+    memory[0x80FF - MEMORY_OFFSET] = 0xFE;
+    loadProgram({
+        0x4C, 0xFE, 0x80,   // 8000: JMP halt
+    });
+
+    EXPECT_GE(cpu->runCycles(10'000), 10'000u);
+    clockReference(static_cast<int>(cpu->getCycleCount()));
+    expectSameState();
+    EXPECT_EQ((cpu->getCycleCount() - 2 - 3) % 4, 0u);
+    EXPECT_GT(cpu->getFastForwardedCycles(), 9'000u);
+}
@@ -0,0 +1,112 @@
+// Test suite for STZ opcode
+#include "cpu_instruction_test.h"
+#include "devices/SRAM62256/SRAM62256.h"
+#include <cstdint>
+
+using namespace EaterEmulator;
+
+TEST_F(CPUInstructionTest, STZ_ZP_StoresZero)
+{
+    auto opcode = Opcode::STZ_ZP;
+    const auto& info = decodeOpcode(opcode);
+    EXPECT_EQ(info.cycles, 3);
+    auto cycles = info.cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0x37;
+    cpu->setAccumulator(0x42);
+    uint8_t statusBefore = cpu->getStatus();
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x0037] = 0xFF;
+    bus->addSlave(ram.get());
+
+    for (int i = 0; i < cycles; ++i)
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+
+    EXPECT_EQ(ram->getMemory()[0x0037], 0x00);
+    EXPECT_EQ(cpu->getAccumulator(), 0x42);
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFD + 1);
+    EXPECT_EQ(cpu->getStatus(), statusBefore); // Status should remain unchanged
+}
+
+TEST_F(CPUInstructionTest, STZ_ZPX_StoresZeroWrappingInZeroPage)
+{
+    auto opcode = Opcode::STZ_ZPX;
+    const auto& info = decodeOpcode(opcode);
+    EXPECT_EQ(info.cycles, 4);
+    auto cycles = info.cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
+    cpu->setXRegister(0x20);
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x0010] = 0xFF;
+    ram->getMemory()[0x0110] = 0xFF;
+    bus->addSlave(ram.get());
+
+    for (int i = 0; i < cycles; ++i)
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+
+    EXPECT_EQ(ram->getMemory()[0x0010], 0x00);
+    EXPECT_EQ(ram->getMemory()[0x0110], 0xFF);
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFD + 1);
+}
+
+TEST_F(CPUInstructionTest, STZ_ABS_StoresZero)
+{
+    auto opcode = Opcode::STZ_ABS;
+    const auto& info = decodeOpcode(opcode);
+    EXPECT_EQ(info.cycles, 4);
+    auto cycles = info.cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0x37;
+    memory[0xFFFE - MEMORY_OFFSET] = 0x20;
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x2037] = 0xFF;
+    bus->addSlave(ram.get());
+
+    for (int i = 0; i < cycles; ++i)
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+
+    EXPECT_EQ(ram->getMemory()[0x2037], 0x00);
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFE + 1);
+}
+
+TEST_F(CPUInstructionTest, STZ_ABSX_StoresZero)
+{
+    auto opcode = Opcode::STZ_ABSX;
+    const auto& info = decodeOpcode(opcode);
+    EXPECT_EQ(info.cycles, 5);
+    auto cycles = info.cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
+    memory[0xFFFD - MEMORY_OFFSET] = 0xF0;
+    memory[0xFFFE - MEMORY_OFFSET] = 0x20;
+    cpu->setXRegister(0x20);
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    ram->getMemory()[0x2110] = 0xFF;
+    bus->addSlave(ram.get());
+
+    for (int i = 0; i < cycles; ++i)
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+
+    EXPECT_EQ(ram->getMemory()[0x2110], 0x00);
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFE + 1);
+}
@@ -10,9 +10,8 @@ using namespace EaterEmulator;
 TEST_F(CPUInstructionTest, PHA_PushValue) 
 {
     auto opcode = Opcode::PHA;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     cpu->setAccumulator(0x42);
     uint8_t statusBefore = cpu->getStatus();
@@ -38,9 +37,8 @@ TEST_F(CPUInstructionTest, PHA_PushValue)
 TEST_F(CPUInstructionTest, PLA_PullValue) 
 {
     auto opcode = Opcode::PLA;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     cpu->setAccumulator(0x00);
     uint8_t statusBefore = cpu->getStatus();
@@ -67,9 +65,8 @@ TEST_F(CPUInstructionTest, PLA_PullValue)
 TEST_F(CPUInstructionTest, PHP_PushStatus) 
 {
     auto opcode = Opcode::PHP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     cpu->setStatus(devices::STATUS_NEGATIVE | devices::STATUS_ZERO);
     uint8_t statusBefore = cpu->getStatus();
@@ -95,9 +92,8 @@ TEST_F(CPUInstructionTest, PHP_PushStatus)
 TEST_F(CPUInstructionTest, PLP_PullStatus) 
 {
     auto opcode = Opcode::PLP;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     cpu->setStatus(0x00);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
@@ -116,4 +112,61 @@ TEST_F(CPUInstructionTest, PLP_PullStatus)
     EXPECT_EQ(cpu->getStatus(), devices::STATUS_NEGATIVE | devices::STATUS_ZERO);
     EXPECT_EQ(cpu->getStackPointer(), 0xFF);
     EXPECT_EQ(cpu->getProgramCounter(), 0xFFFC + 1);
-}
\ No newline at end of file
+}
+TEST_F(CPUInstructionTest, PHX_PHY_PushValues) 
+{
+    const auto& info = decodeOpcode(Opcode::PHX);
+    auto cycles = info.cycles + decodeOpcode(Opcode::PHY).cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(Opcode::PHX);
+    memory[0xFFFD - MEMORY_OFFSET] = static_cast<uint8_t>(Opcode::PHY);
+    cpu->setXRegister(0x42);
+    cpu->setYRegister(0x24);
+    cpu->setStackPointer(0xFF);
+    uint8_t statusBefore = cpu->getStatus();
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    bus->addSlave(ram.get());
+    
+    for (int i = 0; i < cycles; ++i) 
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+    
+    auto ramMemory = ram->getMemory();
+    EXPECT_EQ(ramMemory[0x01FF], 0x42);
+    EXPECT_EQ(ramMemory[0x01FE], 0x24);
+    EXPECT_EQ(cpu->getStackPointer(), 0xFD);
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFD + 1);
+    uint8_t status = cpu->getStatus();
+    EXPECT_EQ(status, statusBefore); // Status should remain unchanged
+}
+
+TEST_F(CPUInstructionTest, PLX_PLY_PullValues) 
+{
+    const auto& info = decodeOpcode(Opcode::PLX);
+    auto cycles = info.cycles + decodeOpcode(Opcode::PLY).cycles;
+    memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(Opcode::PLX);
+    memory[0xFFFD - MEMORY_OFFSET] = static_cast<uint8_t>(Opcode::PLY);
+    rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+    bus->addSlave(rom.get());
+    auto ram = std::make_unique<devices::SRAM62256>(bus);
+    bus->addSlave(ram.get());
+    cpu->setStackPointer(0xFD);
+    cpu->setStatus(0x00);
+    ram->getMemory()[0x01FE] = 0x80;
+    ram->getMemory()[0x01FF] = 0x00;
+    
+    for (int i = 0; i < cycles; ++i) 
+    {
+        cpu->onClockStateChange(core::LOW);
+        cpu->onClockStateChange(core::HIGH);
+    }
+    
+    EXPECT_EQ(cpu->getXRegister(), 0x80);
+    EXPECT_EQ(cpu->getYRegister(), 0x00);
+    EXPECT_EQ(cpu->getStackPointer(), 0xFF);
+    EXPECT_EQ(cpu->getProgramCounter(), 0xFFFD + 1);
+    EXPECT_EQ(cpu->getStatus(), devices::STATUS_ZERO); // Flags follow the last value pulled
+}
@@ -9,9 +9,8 @@ using namespace EaterEmulator;
 TEST_F(CPUInstructionTest, TAX_TransferValue) 
 {
     auto opcode = Opcode::TAX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -35,9 +34,8 @@ TEST_F(CPUInstructionTest, TAX_TransferValue)
 TEST_F(CPUInstructionTest, TAX_TransferNegativeValue) 
 {
     auto opcode = Opcode::TAX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -61,9 +59,8 @@ TEST_F(CPUInstructionTest, TAX_TransferNegativeValue)
 TEST_F(CPUInstructionTest, TAX_TransferZeroValue) 
 {
     auto opcode = Opcode::TAX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -87,9 +84,8 @@ TEST_F(CPUInstructionTest, TAX_TransferZeroValue)
 TEST_F(CPUInstructionTest, TXA_TransferValue) 
 {
     auto opcode = Opcode::TXA;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -113,9 +109,8 @@ TEST_F(CPUInstructionTest, TXA_TransferValue)
 TEST_F(CPUInstructionTest, TXA_TransferNegativeValue) 
 {
     auto opcode = Opcode::TXA;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -139,9 +134,8 @@ TEST_F(CPUInstructionTest, TXA_TransferNegativeValue)
 TEST_F(CPUInstructionTest, TXA_TransferZeroValue) 
 {
     auto opcode = Opcode::TXA;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -165,9 +159,8 @@ TEST_F(CPUInstructionTest, TXA_TransferZeroValue)
 TEST_F(CPUInstructionTest, TAY_TransferValue) 
 {
     auto opcode = Opcode::TAY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -191,9 +184,8 @@ TEST_F(CPUInstructionTest, TAY_TransferValue)
 TEST_F(CPUInstructionTest, TAY_TransferNegativeValue) 
 {
     auto opcode = Opcode::TAY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -217,9 +209,8 @@ TEST_F(CPUInstructionTest, TAY_TransferNegativeValue)
 TEST_F(CPUInstructionTest, TAY_TransferZeroValue) 
 {
     auto opcode = Opcode::TAY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -243,9 +234,8 @@ TEST_F(CPUInstructionTest, TAY_TransferZeroValue)
 TEST_F(CPUInstructionTest, TYA_TransferValue) 
 {
     auto opcode = Opcode::TYA;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -269,9 +259,8 @@ TEST_F(CPUInstructionTest, TYA_TransferValue)
 TEST_F(CPUInstructionTest, TYA_TransferNegativeValue) 
 {
     auto opcode = Opcode::TYA;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -295,9 +284,8 @@ TEST_F(CPUInstructionTest, TYA_TransferNegativeValue)
 TEST_F(CPUInstructionTest, TYA_TransferZeroValue) 
 {
     auto opcode = Opcode::TYA;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -321,9 +309,8 @@ TEST_F(CPUInstructionTest, TYA_TransferZeroValue)
 TEST_F(CPUInstructionTest, TSX_TransferValue) 
 {
     auto opcode = Opcode::TSX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -347,9 +334,8 @@ TEST_F(CPUInstructionTest, TSX_TransferValue)
 TEST_F(CPUInstructionTest, TSX_TransferNegativeValue) 
 {
     auto opcode = Opcode::TSX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -373,9 +359,8 @@ TEST_F(CPUInstructionTest, TSX_TransferNegativeValue)
 TEST_F(CPUInstructionTest, TSX_TransferZeroValue) 
 {
     auto opcode = Opcode::TSX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -399,9 +384,8 @@ TEST_F(CPUInstructionTest, TSX_TransferZeroValue)
 TEST_F(CPUInstructionTest, TXS_TransferValue) 
 {
     auto opcode = Opcode::TXS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -425,9 +409,8 @@ TEST_F(CPUInstructionTest, TXS_TransferValue)
 TEST_F(CPUInstructionTest, TXS_TransferNegativeValue) 
 {
     auto opcode = Opcode::TXS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -452,9 +435,8 @@ TEST_F(CPUInstructionTest, TXS_TransferNegativeValue)
 TEST_F(CPUInstructionTest, TXS_TransferZeroValue) 
 {
     auto opcode = Opcode::TXS;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -479,9 +461,8 @@ TEST_F(CPUInstructionTest, TXS_TransferZeroValue)
 TEST_F(CPUInstructionTest, INX_IncrementXValue) 
 {
     auto opcode = Opcode::INX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -504,9 +485,8 @@ TEST_F(CPUInstructionTest, INX_IncrementXValue)
 TEST_F(CPUInstructionTest, INX_IncrementXToNegativeValue) 
 {
     auto opcode = Opcode::INX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -529,9 +509,8 @@ TEST_F(CPUInstructionTest, INX_IncrementXToNegativeValue)
 TEST_F(CPUInstructionTest, INX_IncrementXToZeroValue) 
 {
     auto opcode = Opcode::INX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -554,9 +533,8 @@ TEST_F(CPUInstructionTest, INX_IncrementXToZeroValue)
 TEST_F(CPUInstructionTest, INY_IncrementXValue) 
 {
     auto opcode = Opcode::INY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -579,9 +557,8 @@ TEST_F(CPUInstructionTest, INY_IncrementXValue)
 TEST_F(CPUInstructionTest, INY_IncrementXToNegativeValue) 
 {
     auto opcode = Opcode::INY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -604,9 +581,8 @@ TEST_F(CPUInstructionTest, INY_IncrementXToNegativeValue)
 TEST_F(CPUInstructionTest, INY_IncrementXToZeroValue) 
 {
     auto opcode = Opcode::INY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -629,9 +605,8 @@ TEST_F(CPUInstructionTest, INY_IncrementXToZeroValue)
 TEST_F(CPUInstructionTest, DEX_DecrementXValue) 
 {
     auto opcode = Opcode::DEX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -654,9 +629,8 @@ TEST_F(CPUInstructionTest, DEX_DecrementXValue)
 TEST_F(CPUInstructionTest, DEX_DecrementXToNegativeValue) 
 {
     auto opcode = Opcode::DEX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -679,9 +653,8 @@ TEST_F(CPUInstructionTest, DEX_DecrementXToNegativeValue)
 TEST_F(CPUInstructionTest, DEX_DecrementXToZeroValue) 
 {
     auto opcode = Opcode::DEX;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -704,9 +677,8 @@ TEST_F(CPUInstructionTest, DEX_DecrementXToZeroValue)
 TEST_F(CPUInstructionTest, DEY_DecrementXValue) 
 {
     auto opcode = Opcode::DEY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -729,9 +701,8 @@ TEST_F(CPUInstructionTest, DEY_DecrementXValue)
 TEST_F(CPUInstructionTest, DEY_DecrementXToNegativeValue) 
 {
     auto opcode = Opcode::DEY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -754,9 +725,8 @@ TEST_F(CPUInstructionTest, DEY_DecrementXToNegativeValue)
 TEST_F(CPUInstructionTest, DEY_DecrementXToZeroValue) 
 {
     auto opcode = Opcode::DEY;
-    auto it = OpcodeMap.find(opcode);
-    ASSERT_NE(it, OpcodeMap.end()) << "Opcode not found in map";
-    auto cycles = it->second.cycles;
+    const auto& info = decodeOpcode(opcode);
+    auto cycles = info.cycles;
     memory[0xFFFC - MEMORY_OFFSET] = static_cast<uint8_t>(opcode);
     rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
     bus->addSlave(rom.get());
@@ -0,0 +1,233 @@
+// Test suite for WAI and STP
+#include "cpu_instruction_test.h"
+#include "devices/SRAM62256/SRAM62256.h"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+using namespace EaterEmulator;
+
+class WaitTest : public CPUInstructionTest {
+protected:
+    std::unique_ptr<devices::SRAM62256> ram;
+
+    void SetUp() override {
+        CPUInstructionTest::SetUp();
+        ram = std::make_unique<devices::SRAM62256>(bus);
+        bus->addSlave(ram.get());
+        cpu->setResetStage(0);
+    }
+
+    void TearDown() override {
+        ram.reset();
+        CPUInstructionTest::TearDown();
+    }
+
+    // Program at 0x8000, IRQ handler at 0x9000
+    void loadProgram(const std::vector<uint8_t>& program, const std::vector<uint8_t>& handler) {
+        std::copy(program.begin(), program.end(), memory.begin());
+        std::copy(handler.begin(), handler.end(), memory.begin() + (0x9000 - MEMORY_OFFSET));
+        memory[0xFFFE - MEMORY_OFFSET] = 0x00; // IRQ vector low
+        memory[0xFFFF - MEMORY_OFFSET] = 0x90; // IRQ vector high (0x9000)
+        memory[0xFFFC - MEMORY_OFFSET] = 0x00; // Reset vector low
+        memory[0xFFFD - MEMORY_OFFSET] = 0x80; // Reset vector high (0x8000)
+        rom = std::make_unique<devices::EEPROM28C256>(memory, bus);
+        bus->addSlave(rom.get());
+    }
+
+    void clock(int cycles) {
+        for (int i = 0; i < cycles; ++i) {
+            cpu->onClockStateChange(core::LOW);
+            cpu->onClockStateChange(core::HIGH);
+        }
+    }
+};
+
+namespace
+{
+    const std::vector<uint8_t> COUNTING_HANDLER = {
+        0xE8,               // 9000:       INX
+        0x4C, 0x01, 0x90,   // 9001: halt: JMP halt
+    };
+
+    // Waits until the clock stops counting cycles, false if it keeps going for a second
+    bool waitForIdleClock(const core::Clock& clock)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        auto cycles = clock.getCycleCount();
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            const auto now = clock.getCycleCount();
+            if (now == cycles)
+            {
+                return true;
+            }
+            cycles = now;
+        }
+        return false;
+    }
+}
+
+TEST_F(WaitTest, WAI_HoldsUntilIRQ) {
+    loadProgram({
+        0x58,               // 8000: CLI
+        0xCB,               //       WAI
+        0xC8,               //       INY
+    }, COUNTING_HANDLER);
+
+    clock(2 + 2 + 3); // Reset, CLI, WAI
+    EXPECT_TRUE(cpu->isWaiting());
+    clock(1000);
+    EXPECT_TRUE(cpu->isWaiting());
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8002);
+    EXPECT_EQ(cpu->getCycleCount(), 1007u);
+
+    cpu->setIRQ(core::LOW);
+    clock(7); // Interrupt sequence
+    EXPECT_FALSE(cpu->isWaiting());
+    EXPECT_EQ(cpu->getProgramCounter(), 0x9000);
+
+    // Returns to the instruction after WAI
+    auto& stack = ram->getMemory();
+    EXPECT_EQ(stack[0x01FF], 0x80);
+    EXPECT_EQ(stack[0x01FE], 0x02);
+}
+
+TEST_F(WaitTest, WAI_ContinuesOnMaskedIRQ) {
+    loadProgram({
+        0x78,               // 8000: SEI
+        0xCB,               //       WAI
+        0xC8,               //       INY
+    }, COUNTING_HANDLER);
+
+    clock(2 + 2 + 3 + 10);
+    EXPECT_TRUE(cpu->isWaiting());
+
+    cpu->setIRQ(core::LOW);
+    clock(2); // INY, fetched at the boundary where WAI ends
+    EXPECT_FALSE(cpu->isWaiting());
+    EXPECT_EQ(cpu->getYRegister(), 1);
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8003);
+}
+
+TEST_F(WaitTest, WAI_WakesOnNMI) {
+    memory[0xFFFA - MEMORY_OFFSET] = 0x00; // NMI vector low
+    memory[0xFFFB - MEMORY_OFFSET] = 0x92; // NMI vector high (0x9200)
+    loadProgram({
+        0x78,               // 8000: SEI
+        0xCB,               //       WAI
+    }, {});
+
+    clock(2 + 2 + 3 + 10);
+    cpu->setNMI(core::LOW);
+    clock(7);
+    EXPECT_FALSE(cpu->isWaiting());
+    EXPECT_EQ(cpu->getProgramCounter(), 0x9200);
+}
+
+TEST_F(WaitTest, STP_HoldsUntilReset) {
+    loadProgram({
+        0xDB,               // 8000: STP
+    }, COUNTING_HANDLER);
+
+    clock(2 + 3);
+    EXPECT_TRUE(cpu->isStopped());
+    cpu->setIRQ(core::LOW);
+    cpu->setNMI(core::LOW);
+    clock(100);
+    EXPECT_TRUE(cpu->isStopped());
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8001);
+
+    cpu->setNMI(core::HIGH);
+    cpu->reset();
+    EXPECT_FALSE(cpu->isStopped());
+    clock(2);
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8000);
+}
+
+TEST_F(WaitTest, WAI_BlocksClockThreadUntilIRQ) {
+    loadProgram({
+        0x58,               // 8000: CLI
+        0xCB,               //       WAI
+    }, COUNTING_HANDLER);
+
+    core::Clock clock(core::Clock::UNTHROTTLED);
+    clock.registerObserver(cpu.get());
+    clock.start();
+
+    ASSERT_TRUE(waitForIdleClock(clock));
+    EXPECT_TRUE(clock.isRunning());
+
+    // As if raised by a device on another thread
+    cpu->setIRQ(core::LOW);
+    const auto blockedAt = clock.getCycleCount();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (clock.getCycleCount() == blockedAt && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    clock.stop();
+
+    EXPECT_GT(clock.getCycleCount(), blockedAt);
+    EXPECT_EQ(cpu->getXRegister(), 1);
+}
+
+TEST_F(WaitTest, WAI_WakesOnIRQFromAnotherThread) {
+    loadProgram({
+        0x58,               // 8000:       CLI
+        0xCB,               // 8001: loop: WAI
+        0x4C, 0x01, 0x80,   //             JMP loop
+    }, {
+        0xE8,               // 9000:       INX
+        0x40,               //             RTI
+    });
+
+    core::Clock clock(core::Clock::UNTHROTTLED);
+    clock.registerObserver(cpu.get());
+    clock.start();
+
+    // A device thread pulses the line each time the clock thread is blocked in waitWhileIdle
+    int wakeups = 0;
+    std::thread device([&] {
+        for (int i = 0; i < 10; ++i)
+        {
+            if (!waitForIdleClock(clock))
+            {
+                return;
+            }
+            cpu->setIRQ(core::LOW);
+            const auto blockedAt = clock.getCycleCount();
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+            while (clock.getCycleCount() < blockedAt + 100 && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            cpu->setIRQ(core::HIGH);
+            wakeups += clock.getCycleCount() >= blockedAt + 100 ? 1 : 0;
+        }
+    });
+    device.join();
+
+    // Back in WAI after the last one
+    EXPECT_TRUE(waitForIdleClock(clock));
+    clock.stop();
+    EXPECT_EQ(wakeups, 10);
+    EXPECT_EQ(cpu->getProgramCounter(), 0x8002);
+}
+
+TEST_F(WaitTest, STP_BlockedClockStops) {
+    loadProgram({
+        0xDB,               // 8000: STP
+    }, {});
+
+    core::Clock clock(core::Clock::UNTHROTTLED);
+    clock.registerObserver(cpu.get());
+    clock.start();
+
+    ASSERT_TRUE(waitForIdleClock(clock));
+    clock.stop();
+    EXPECT_FALSE(clock.isRunning());
+    EXPECT_TRUE(cpu->isStopped());
+}
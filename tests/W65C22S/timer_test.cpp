@@ -0,0 +1,191 @@
+// Test suite for the W65C22S timers and interrupt registers
+#include "core/bus.h"
+#include "core/defines.h"
+#include "devices/EEPROM28C256/EEPROM28C256.h"
+#include "devices/SRAM62256/SRAM62256.h"
+#include "devices/W65C02S/CPUAdapter.h"
+#include "devices/W65C02S/W65C02S.h"
+#include "devices/W65C22S/W65C22S.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using namespace EaterEmulator;
+using Register = devices::W65C22S::Register;
+
+class TimerTest : public ::testing::Test {
+protected:
+    static constexpr uint16_t VIA_BASE = 0x6000;
+
+    std::shared_ptr<core::Bus> bus = std::make_shared<core::Bus>();
+    std::unique_ptr<devices::W65C22S> via = std::make_unique<devices::W65C22S>(bus);
+
+    void SetUp() override
+    {
+        bus->addSlave(via.get());
+    }
+
+    void write(Register reg, uint8_t data)
+    {
+        bus->write(VIA_BASE + static_cast<uint16_t>(reg), data);
+    }
+
+    uint8_t read(Register reg)
+    {
+        return bus->read(VIA_BASE + static_cast<uint16_t>(reg));
+    }
+
+    uint16_t readT1()
+    {
+        uint8_t high = read(Register::T1CH);
+        return static_cast<uint16_t>((high << 8) | read(Register::T1CL));
+    }
+
+    void advanceTo(uint64_t cycle)
+    {
+        bus->getScheduler().advance(cycle);
+    }
+};
+
+TEST_F(TimerTest, T1OneShotSetsFlagOnce)
+{
+    write(Register::T1CL, 0x10);
+    write(Register::T1CH, 0x00); // Load 16 at cycle 0
+
+    advanceTo(10);
+    EXPECT_EQ(read(Register::T1CH), 0x00);
+    EXPECT_EQ(read(Register::T1LL), 0x10);
+    EXPECT_EQ(read(Register::IFR) & devices::W65C22S::IRQ_T1, 0);
+
+    advanceTo(17);
+    EXPECT_EQ(read(Register::IFR) & devices::W65C22S::IRQ_T1, devices::W65C22S::IRQ_T1);
+    EXPECT_EQ(readT1(), 0xFFFF); // Reading T1CL acknowledges the flag
+    EXPECT_EQ(read(Register::IFR) & devices::W65C22S::IRQ_T1, 0);
+
+    // One-shot keeps counting down without interrupting again
+    advanceTo(100'000);
+    EXPECT_EQ(read(Register::IFR) & devices::W65C22S::IRQ_T1, 0);
+    EXPECT_TRUE(bus->getScheduler().empty());
+}
+
+TEST_F(TimerTest, T1CounterIsComputedFromElapsedCycles)
+{
+    write(Register::T1CL, 0x00);
+    write(Register::T1CH, 0x10); // 0x1000
+
+    advanceTo(0x234);
+    EXPECT_EQ(readT1(), 0x1000 - 0x234);
+}
+
+TEST_F(TimerTest, T1FreeRunReloadsEveryNPlus2Cycles)
+{
+    write(Register::ACR, devices::W65C22S::ACR_T1_FREE_RUN);
+    write(Register::T1CL, 98);
+    write(Register::T1CH, 0x00); // Period of 100 cycles
+
+    int interrupts = 0;
+    for (uint64_t cycle = 0; cycle <= 1000; ++cycle)
+    {
+        advanceTo(cycle);
+        if (read(Register::IFR) & devices::W65C22S::IRQ_T1)
+        {
+            interrupts++;
+            write(Register::IFR, devices::W65C22S::IRQ_T1);
+        }
+    }
+    // Expiries at 99, 199, ..., 999
+    EXPECT_EQ(interrupts, 10);
+
+    // Reloaded from the latches on the cycle after the last expiry
+    advanceTo(1000);
+    EXPECT_EQ(readT1(), 98);
+    advanceTo(1001);
+    EXPECT_EQ(readT1(), 97);
+}
+
+TEST_F(TimerTest, T2OneShotAndPulseCounting)
+{
+    write(Register::T2CL, 0x05);
+    write(Register::T2CH, 0x00);
+    advanceTo(6);
+    EXPECT_EQ(read(Register::IFR) & devices::W65C22S::IRQ_T2, devices::W65C22S::IRQ_T2);
+    read(Register::T2CL);
+    EXPECT_EQ(read(Register::IFR) & devices::W65C22S::IRQ_T2, 0);
+
+    write(Register::ACR, devices::W65C22S::ACR_T2_PULSE_COUNT);
+    write(Register::T2CL, 0x03);
+    write(Register::T2CH, 0x00);
+    via->pulsePB6();
+    via->pulsePB6();
+    EXPECT_EQ(read(Register::T2CL), 0x01);
+    EXPECT_EQ(read(Register::IFR) & devices::W65C22S::IRQ_T2, 0);
+    via->pulsePB6();
+    EXPECT_EQ(read(Register::IFR) & devices::W65C22S::IRQ_T2, devices::W65C22S::IRQ_T2);
+}
+
+TEST_F(TimerTest, InterruptEnableRegister)
+{
+    write(Register::IER, devices::W65C22S::IRQ_ANY | devices::W65C22S::IRQ_T1 | devices::W65C22S::IRQ_CA1);
+    EXPECT_EQ(read(Register::IER), devices::W65C22S::IRQ_ANY | devices::W65C22S::IRQ_T1 | devices::W65C22S::IRQ_CA1);
+
+    write(Register::IER, devices::W65C22S::IRQ_CA1);
+    EXPECT_EQ(read(Register::IER), devices::W65C22S::IRQ_ANY | devices::W65C22S::IRQ_T1);
+
+    // IFR bit 7 is only set when an enabled flag is set
+    write(Register::T2CL, 0x00);
+    write(Register::T2CH, 0x00);
+    advanceTo(1);
+    EXPECT_EQ(read(Register::IFR), devices::W65C22S::IRQ_T2);
+    write(Register::T1CL, 0x00);
+    write(Register::T1CH, 0x00);
+    advanceTo(2);
+    EXPECT_EQ(read(Register::IFR), devices::W65C22S::IRQ_ANY | devices::W65C22S::IRQ_T1 | devices::W65C22S::IRQ_T2);
+}
+
+// Free-running T1 interrupt counting ticks in RAM, the way timer firmware for the breadboard computer does
+TEST_F(TimerTest, T1InterruptDrivesCPU)
+{
+    std::vector<uint8_t> image(0x8000, 0xEA);
+    const std::vector<uint8_t> program = {
+        0xA9, 0x40,         // 8000: LDA #$40
+        0x8D, 0x0B, 0x60,   //       STA ACR       ; T1 free run
+        0xA9, 0xE6,         //       LDA #$E6
+        0x8D, 0x04, 0x60,   //       STA T1CL
+        0xA9, 0x03,         //       LDA #$03
+        0x8D, 0x05, 0x60,   //       STA T1CH      ; 998 + 2 = 1000 cycle period
+        0xA9, 0xC0,         //       LDA #$C0
+        0x8D, 0x0E, 0x60,   //       STA IER       ; enable T1
+        0x58,               //       CLI
+        0x4C, 0x15, 0x80,   // loop: JMP loop
+    };
+    const std::vector<uint8_t> isr = {
+        0xE6, 0x00,         // 9000: INC $00
+        0xAD, 0x04, 0x60,   //       LDA T1CL      ; acknowledge
+        0x40,               //       RTI
+    };
+    std::copy(program.begin(), program.end(), image.begin());
+    std::copy(isr.begin(), isr.end(), image.begin() + 0x1000);
+    image[0xFFFC - 0x8000] = 0x00;
+    image[0xFFFD - 0x8000] = 0x80;
+    image[0xFFFE - 0x8000] = 0x00;
+    image[0xFFFF - 0x8000] = 0x90;
+
+    devices::EEPROM28C256 rom(image, bus);
+    bus->addSlave(&rom);
+    devices::SRAM62256 ram(bus);
+    bus->addSlave(&ram);
+    auto cpu = std::make_shared<devices::W65C02S>(bus);
+    cpu->reset();
+    via->connect(devices::W65C22S::Port::IRQ, devices::CPUAdapter(cpu), devices::CPUAdapter::IRQ_PORT);
+
+    while (cpu->getCycleCount() < 100'000)
+    {
+        cpu->step();
+    }
+
+    // About 100 ticks, the first period starts a few instructions in
+    EXPECT_GE(ram.getMemory()[0x00], 98);
+    EXPECT_LE(ram.getMemory()[0x00], 100);
+}
@@ -0,0 +1,184 @@
+// Test suite for the W65C51N receive path
+#include "core/bus.h"
+#include "core/defines.h"
+#include "devices/EEPROM28C256/EEPROM28C256.h"
+#include "devices/SRAM62256/SRAM62256.h"
+#include "devices/W65C02S/W65C02S.h"
+#include "devices/W65C51N/W65C51N.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace EaterEmulator;
+using Register = devices::W65C51N::Register;
+
+class ReceiveTest : public ::testing::Test {
+protected:
+    static constexpr uint16_t ACIA_BASE = 0x5000;
+    static constexpr uint8_t CONTROL_19200_8N1 = 0x1F;
+
+    std::shared_ptr<core::Bus> bus = std::make_shared<core::Bus>();
+    std::unique_ptr<devices::W65C51N> acia = std::make_unique<devices::W65C51N>(bus);
+
+    void SetUp() override
+    {
+        bus->addSlave(acia.get());
+        write(Register::CONTROL, CONTROL_19200_8N1);
+    }
+
+    void write(Register reg, uint8_t data)
+    {
+        bus->write(ACIA_BASE + static_cast<uint16_t>(reg), data);
+    }
+
+    uint8_t read(Register reg)
+    {
+        return bus->read(ACIA_BASE + static_cast<uint16_t>(reg));
+    }
+
+    void receive(const std::string& text)
+    {
+        for (char c : text)
+        {
+            ASSERT_TRUE(acia->receive(static_cast<uint8_t>(c)));
+        }
+    }
+};
+
+TEST_F(ReceiveTest, CharacterTimeFollowsControlRegister)
+{
+    // 1 start + 8 data + 1 stop bits at 19200 baud on a 1 MHz clock
+    EXPECT_EQ(acia->cyclesPerCharacter(), 521u);
+
+    write(Register::CONTROL, 0x80 | 0x40 | 0x0E); // 9600 baud, 6 data bits, 2 stop bits
+    EXPECT_EQ(acia->cyclesPerCharacter(), 938u);
+
+    acia->setClockFrequency(2'000'000);
+    EXPECT_EQ(acia->cyclesPerCharacter(), 1875u);
+}
+
+TEST_F(ReceiveTest, CharactersArriveAtBaudRate)
+{
+    receive("AB");
+
+    // The line was idle, so the first character is available when first polled
+    EXPECT_EQ(read(Register::STATUS) & devices::W65C51N::STATUS_RDRF, devices::W65C51N::STATUS_RDRF);
+    EXPECT_EQ(read(Register::DATA), 'A');
+    EXPECT_EQ(read(Register::STATUS) & devices::W65C51N::STATUS_RDRF, 0);
+
+    bus->getScheduler().advance(520);
+    EXPECT_EQ(read(Register::STATUS) & devices::W65C51N::STATUS_RDRF, 0);
+    bus->getScheduler().advance(521);
+    EXPECT_EQ(read(Register::STATUS) & devices::W65C51N::STATUS_RDRF, devices::W65C51N::STATUS_RDRF);
+    EXPECT_EQ(read(Register::DATA), 'B');
+}
+
+TEST_F(ReceiveTest, FlowControlHoldsOffSenderInsteadOfOverrunning)
+{
+    receive("XYZ");
+    read(Register::STATUS);
+
+    // Nobody reads for many character times
+    bus->getScheduler().advance(100'000);
+    EXPECT_EQ(read(Register::STATUS) & devices::W65C51N::STATUS_OVERRUN, 0);
+    EXPECT_EQ(read(Register::DATA), 'X');
+
+    // The held-off sender needs a full character time for the next one
+    bus->getScheduler().advance(100'520);
+    EXPECT_EQ(read(Register::STATUS) & devices::W65C51N::STATUS_RDRF, 0);
+    bus->getScheduler().advance(100'521);
+    EXPECT_EQ(read(Register::DATA), 'Y');
+}
+
+TEST_F(ReceiveTest, OverrunWithoutFlowControl)
+{
+    acia->setFlowControl(false);
+    receive("XYZ");
+    read(Register::STATUS);
+
+    bus->getScheduler().advance(100'000);
+    EXPECT_EQ(read(Register::STATUS) & devices::W65C51N::STATUS_OVERRUN, devices::W65C51N::STATUS_OVERRUN);
+    // The first character is kept, the ones arriving while it was unread are lost
+    EXPECT_EQ(read(Register::DATA), 'X');
+    EXPECT_EQ(read(Register::STATUS) & (devices::W65C51N::STATUS_OVERRUN | devices::W65C51N::STATUS_RDRF), 0);
+}
+
+TEST_F(ReceiveTest, InterruptsOnReceiveWhenEnabled)
+{
+    constexpr uint8_t RDRF = devices::W65C51N::STATUS_RDRF;
+    constexpr uint8_t IRQ = devices::W65C51N::STATUS_IRQ;
+
+    // Receiver interrupt disabled, as wozmon sets it up: input only moves when the CPU looks
+    write(Register::COMMAND, devices::W65C51N::COMMAND_DTR | devices::W65C51N::COMMAND_IRD);
+    EXPECT_EQ(bus->getScheduler().nextEventCycle(), core::Scheduler::NEVER);
+    receive("A");
+    bus->getScheduler().advance(521);
+    EXPECT_EQ(read(Register::STATUS) & (IRQ | RDRF), RDRF);
+    EXPECT_EQ(read(Register::DATA), 'A');
+
+    // Enabled, the character is picked up without the CPU touching the ACIA
+    write(Register::COMMAND, devices::W65C51N::COMMAND_DTR);
+    receive("B");
+    bus->getScheduler().advance(2 * 521);
+    // Reading the status acknowledges the interrupt, the character stays
+    EXPECT_EQ(read(Register::STATUS) & (IRQ | RDRF), IRQ | RDRF);
+    EXPECT_EQ(read(Register::STATUS) & (IRQ | RDRF), RDRF);
+    EXPECT_EQ(read(Register::DATA), 'B');
+
+    // A programmed reset clears DTR, which disables the interrupt again
+    write(Register::STATUS, 0);
+    receive("C");
+    bus->getScheduler().advance(10 * 521);
+    EXPECT_EQ(bus->getScheduler().nextEventCycle(), core::Scheduler::NEVER);
+    EXPECT_EQ(read(Register::STATUS) & (IRQ | RDRF), RDRF);
+}
+
+// Polled receive loop with a transmit delay as long as wozmon's, which is slower than one character at 19200 baud
+TEST_F(ReceiveTest, PastedInputIsNotLost)
+{
+    std::vector<uint8_t> image(0x8000, 0xEA);
+    const std::vector<uint8_t> program = {
+        0xA9, 0x1F,         // 8000: LDA #$1F
+        0x8D, 0x03, 0x50,   //       STA ACIA_CTRL
+        0xA0, 0x00,         //       LDY #$00
+        0xAD, 0x01, 0x50,   // wait: LDA ACIA_STATUS
+        0x29, 0x08,         //       AND #$08
+        0xF0, 0xF9,         //       BEQ wait
+        0xAD, 0x00, 0x50,   //       LDA ACIA_DATA
+        0x99, 0x00, 0x02,   //       STA $0200,Y
+        0xA2, 0xFF,         //       LDX #$FF
+        0xCA,               // delay:DEX
+        0xD0, 0xFD,         //       BNE delay
+        0xC8,               //       INY
+        0xD0, 0xEB,         //       BNE wait
+        0x4C, 0x1C, 0x80,   // done: JMP done
+    };
+    std::copy(program.begin(), program.end(), image.begin());
+    image[0xFFFC - 0x8000] = 0x00;
+    image[0xFFFD - 0x8000] = 0x80;
+
+    devices::EEPROM28C256 rom(image, bus);
+    bus->addSlave(&rom);
+    devices::SRAM62256 ram(bus);
+    bus->addSlave(&ram);
+    auto cpu = std::make_shared<devices::W65C02S>(bus);
+    cpu->reset();
+
+    std::string dump;
+    for (int i = 0; i < 256; ++i)
+    {
+        dump += "0123456789ABCDEF:"[i % 17];
+    }
+    receive(dump);
+
+    while (cpu->getProgramCounter() != 0x801C && cpu->getCycleCount() < 10'000'000)
+    {
+        cpu->step();
+    }
+
+    ASSERT_EQ(cpu->getProgramCounter(), 0x801C);
+    EXPECT_EQ(std::string(ram.getMemory().begin() + 0x200, ram.getMemory().begin() + 0x300), dump);
+}
@@ -0,0 +1,108 @@
+// Test suite for the W65C51N transmit path
+#include "core/bus.h"
+#include "core/defines.h"
+#include "devices/W65C51N/SerialSink.h"
+#include "devices/W65C51N/W65C51N.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+using namespace EaterEmulator;
+using Register = devices::W65C51N::Register;
+
+class TransmitTest : public ::testing::Test {
+protected:
+    static constexpr uint16_t ACIA_BASE = 0x5000;
+
+    std::shared_ptr<core::Bus> bus = std::make_shared<core::Bus>();
+    std::unique_ptr<devices::W65C51N> acia = std::make_unique<devices::W65C51N>(bus);
+    std::shared_ptr<devices::MemorySink> sink = std::make_shared<devices::MemorySink>();
+
+    void SetUp() override
+    {
+        bus->addSlave(acia.get());
+        acia->setTransmitSink(sink);
+        bus->write(ACIA_BASE + static_cast<uint16_t>(Register::CONTROL), 0x1F); // 19200 8N1
+    }
+
+    void send(const std::string& text)
+    {
+        for (char c : text)
+        {
+            bus->write(ACIA_BASE + static_cast<uint16_t>(Register::DATA), static_cast<uint8_t>(c));
+        }
+    }
+
+    uint8_t status()
+    {
+        return bus->read(ACIA_BASE + static_cast<uint16_t>(Register::STATUS));
+    }
+};
+
+TEST_F(TransmitTest, FlushesOnNewline)
+{
+    send("Hello");
+    EXPECT_EQ(sink->str(), "");
+
+    send(", world\n");
+    EXPECT_EQ(sink->str(), "Hello, world\n");
+}
+
+TEST_F(TransmitTest, FlushesPartialLineAfterInterval)
+{
+    send("\\");
+    bus->getScheduler().advance(1'000'000 / devices::W65C51N::TX_FLUSH_DIVIDER - 1);
+    EXPECT_EQ(sink->str(), "");
+
+    bus->getScheduler().advance(1'000'000 / devices::W65C51N::TX_FLUSH_DIVIDER);
+    EXPECT_EQ(sink->str(), "\\");
+}
+
+TEST_F(TransmitTest, FlushesAtSizeThreshold)
+{
+    send(std::string(devices::W65C51N::TX_FLUSH_THRESHOLD - 1, 'x'));
+    EXPECT_TRUE(sink->data().empty());
+
+    send("x");
+    EXPECT_EQ(sink->data().size(), devices::W65C51N::TX_FLUSH_THRESHOLD);
+}
+
+TEST_F(TransmitTest, FlushesOnDestruction)
+{
+    send("bye");
+    acia.reset();
+
+    EXPECT_EQ(sink->str(), "bye");
+}
+
+TEST_F(TransmitTest, TransmitterEmptyIsPacedAtBaudRate)
+{
+    EXPECT_EQ(status() & devices::W65C51N::STATUS_TDRE, devices::W65C51N::STATUS_TDRE);
+
+    send("A");
+    EXPECT_EQ(status() & devices::W65C51N::STATUS_TDRE, 0);
+    bus->getScheduler().advance(520);
+    EXPECT_EQ(status() & devices::W65C51N::STATUS_TDRE, 0);
+    bus->getScheduler().advance(521);
+    EXPECT_EQ(status() & devices::W65C51N::STATUS_TDRE, devices::W65C51N::STATUS_TDRE);
+}
+
+TEST(FileDescriptorSinkTest, WritesToPipe)
+{
+    std::array<int, 2> fds;
+    ASSERT_EQ(pipe(fds.data()), 0);
+    {
+        devices::FileDescriptorSink sink(fds[1], true);
+        const std::string text = "8000: A9 FF\n";
+        sink.write(std::span(reinterpret_cast<const uint8_t*>(text.data()), text.size()));
+    }
+
+    std::array<char, 32> buffer{};
+    const auto count = read(fds[0], buffer.data(), buffer.size());
+    close(fds[0]);
+    EXPECT_EQ(std::string(buffer.data(), static_cast<size_t>(count)), "8000: A9 FF\n");
+}
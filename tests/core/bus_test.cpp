@@ -0,0 +1,158 @@
+// Test suite for the bus page table and direct memory pages
+#include "core/bus.h"
+#include "core/bus_slave.h"
+#include "core/defines.h"
+#include "devices/EEPROM28C256/EEPROM28C256.h"
+#include "devices/SRAM62256/SRAM62256.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace EaterEmulator;
+
+// Slave that records the addresses it was notified of
+class RecordingSlave : public core::BusSlave
+{
+public:
+    RecordingSlave(std::shared_ptr<core::Bus> bus, std::vector<core::AddressRange> ranges)
+        : core::BusSlave(bus), _ranges(std::move(ranges)) {}
+
+    void handleBusNotification(uint16_t address, [[maybe_unused]] uint8_t rwb) override
+    {
+        accesses.push_back(address);
+    }
+
+    std::vector<core::AddressRange> getAddressRanges() const override { return _ranges; }
+    std::string getName() const override { return "RecordingSlave"; }
+
+    std::vector<uint16_t> accesses;
+
+private:
+    std::vector<core::AddressRange> _ranges;
+};
+
+class BusTest : public ::testing::Test {
+protected:
+    std::shared_ptr<core::Bus> bus = std::make_shared<core::Bus>();
+
+    void access(uint16_t address)
+    {
+        bus->setAddress(address);
+        bus->notifySlaves(core::READ);
+    }
+};
+
+TEST_F(BusTest, DispatchesOnlyToPageOwner)
+{
+    RecordingSlave low(bus, { {0x0000, 0x3FFF} });
+    RecordingSlave high(bus, { {0x8000, 0xFFFF} });
+    bus->addSlave(&low);
+    bus->addSlave(&high);
+
+    access(0x3FFF);
+    access(0x8000);
+    access(0x4000); // Unmapped
+
+    EXPECT_EQ(low.accesses, std::vector<uint16_t>({ 0x3FFF }));
+    EXPECT_EQ(high.accesses, std::vector<uint16_t>({ 0x8000 }));
+    EXPECT_EQ(bus->getSlaveForAddress(0x1234), &low);
+    EXPECT_EQ(bus->getSlaveForAddress(0x4000), nullptr);
+}
+
+TEST_F(BusTest, SlaveWithoutRangesSeesEveryAccess)
+{
+    RecordingSlave ram(bus, { {0x0000, 0x00FF} });
+    RecordingSlave monitor(bus, {});
+    bus->addSlave(&ram);
+    bus->addSlave(&monitor);
+
+    access(0x0010);
+    access(0x6000);
+
+    EXPECT_EQ(monitor.accesses, std::vector<uint16_t>({ 0x0010, 0x6000 }));
+    EXPECT_EQ(bus->getSlaveForAddress(0x6000), nullptr);
+}
+
+TEST_F(BusTest, OverlappingRangeThrows)
+{
+    RecordingSlave via(bus, { {0x6000, 0x6FFF} });
+    RecordingSlave other(bus, { {0x5000, 0x5FFF}, {0x6F00, 0x70FF} });
+    bus->addSlave(&via);
+
+    EXPECT_THROW(bus->addSlave(&other), std::runtime_error);
+    // The rejected slave must not have mapped any of its pages
+    EXPECT_EQ(bus->getSlaveForAddress(0x5000), nullptr);
+    EXPECT_EQ(bus->getSlaveForAddress(0x7000), nullptr);
+    EXPECT_EQ(bus->getSlaveForAddress(0x6F00), &via);
+}
+
+TEST_F(BusTest, UnalignedRangeThrows)
+{
+    RecordingSlave slave(bus, { {0x5000, 0x500F} });
+
+    EXPECT_THROW(bus->addSlave(&slave), std::runtime_error);
+}
+
+TEST_F(BusTest, RamPagesAreReadWrite)
+{
+    devices::SRAM62256 ram(bus);
+    bus->addSlave(&ram);
+
+    bus->write(0x1234, 0x5A);
+    EXPECT_EQ(ram.getMemory()[0x1234], 0x5A);
+
+    ram.getMemory()[0x0042] = 0xA5;
+    EXPECT_EQ(bus->read(0x0042), 0xA5);
+
+    uint8_t data = 0;
+    bus->getData(data);
+    EXPECT_EQ(data, 0xA5);
+}
+
+TEST_F(BusTest, RomPagesIgnoreWrites)
+{
+    std::vector<uint8_t> image(0x8000, 0xEA);
+    devices::EEPROM28C256 rom(image, bus);
+    bus->addSlave(&rom);
+
+    bus->write(0x8000, 0x00);
+    EXPECT_EQ(rom.getMemory()[0x0000], 0xEA);
+    EXPECT_EQ(bus->read(0x8000), 0xEA);
+}
+
+TEST_F(BusTest, MonitorSeesDirectMemoryAccesses)
+{
+    devices::SRAM62256 ram(bus);
+    RecordingSlave monitor(bus, {});
+    bus->addSlave(&ram);
+    bus->addSlave(&monitor);
+
+    bus->write(0x0010, 0x77);
+
+    EXPECT_EQ(ram.getMemory()[0x0010], 0x77);
+    EXPECT_EQ(monitor.accesses, std::vector<uint16_t>({ 0x0010 }));
+}
+
+TEST_F(BusTest, OnlyRomPagesAreConstant)
+{
+    std::vector<uint8_t> image(0x8000, 0xEA);
+    devices::EEPROM28C256 rom(image, bus);
+    devices::SRAM62256 ram(bus);
+    bus->addSlave(&rom);
+    bus->addSlave(&ram);
+
+    ASSERT_NE(bus->getConstantPage(0x80), nullptr);
+    EXPECT_EQ(bus->getConstantPage(0x80)[0], 0xEA);
+    EXPECT_EQ(bus->getConstantPage(0x00), nullptr);
+    EXPECT_EQ(bus->getConstantPage(0x40), nullptr);
+
+    // A monitor has to see instruction fetches, so nothing stays constant
+    const auto generation = bus->getMapGeneration();
+    RecordingSlave monitor(bus, {});
+    bus->addSlave(&monitor);
+    EXPECT_EQ(bus->getConstantPage(0x80), nullptr);
+    EXPECT_NE(bus->getMapGeneration(), generation);
+}
@@ -0,0 +1,99 @@
+// Test suite for the binary bus trace recorder
+#include "core/bus.h"
+#include "core/bus_trace.h"
+#include "core/defines.h"
+#include "devices/ArduinoMega/ArduinoMega.h"
+#include "devices/SRAM62256/SRAM62256.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+using namespace EaterEmulator;
+
+class BusTraceTest : public ::testing::Test {
+protected:
+    std::string path = (std::filesystem::temp_directory_path() / ("bus_trace_test_" + std::to_string(getpid()) + ".bin")).string();
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+};
+
+TEST_F(BusTraceTest, EncodeDecodeRoundTrip)
+{
+    const core::BusTraceRecord record{ 0x0123456789ABCDEF, 0x8000, 0xFFFC, 0xA9, core::READ };
+    std::array<uint8_t, core::bus_trace::RECORD_SIZE> bytes{};
+    core::bus_trace::encode(record, bytes.data());
+
+    EXPECT_EQ(bytes[0], 0xEF); // Little-endian cycle
+    EXPECT_EQ(bytes[13], core::bus_trace::FLAG_READ);
+    EXPECT_EQ(core::bus_trace::decode(bytes.data()), record);
+}
+
+TEST_F(BusTraceTest, FormatsLikeArduinoMonitor)
+{
+    EXPECT_EQ(core::bus_trace::formatArduino({ 0, 0x8000, 0, 0xA9, core::READ }), "1000000000000000   8000  r a9   10101001");
+    EXPECT_EQ(core::bus_trace::formatArduino({ 0, 0x01FF, 0, 0x05, core::WRITE }), "0000000111111111   01ff  W 05   00000101");
+}
+
+TEST_F(BusTraceTest, WriterStreamsEveryRecordToFile)
+{
+    // More records than the ring holds, so the writer has to keep up or hold the producer off
+    constexpr uint64_t COUNT = core::BusTraceWriter::RING_CAPACITY * 3 + 17;
+    {
+        core::BusTraceWriter writer(path);
+        for (uint64_t i = 0; i < COUNT; ++i)
+        {
+            writer.record({ i, static_cast<uint16_t>(i), static_cast<uint16_t>(~i), static_cast<uint8_t>(i * 7), (i & 1) ? core::READ : core::WRITE });
+        }
+        writer.close();
+        EXPECT_EQ(writer.getRecordCount(), COUNT);
+    }
+
+    EXPECT_EQ(std::filesystem::file_size(path), core::bus_trace::HEADER_SIZE + COUNT * core::bus_trace::RECORD_SIZE);
+    core::BusTraceReader reader(path);
+    uint64_t expected = 0;
+    while (auto record = reader.next())
+    {
+        ASSERT_EQ(record->cycle, expected);
+        ASSERT_EQ(record->address, static_cast<uint16_t>(expected));
+        ASSERT_EQ(record->data, static_cast<uint8_t>(expected * 7));
+        ++expected;
+    }
+    EXPECT_EQ(expected, COUNT);
+}
+
+TEST_F(BusTraceTest, ReaderRejectsOtherFiles)
+{
+    std::ofstream(path) << "not a bus trace";
+    EXPECT_THROW(core::BusTraceReader reader(path), std::runtime_error);
+}
+
+TEST_F(BusTraceTest, ArduinoMegaRecordsBusAccesses)
+{
+    auto bus = std::make_shared<core::Bus>();
+    devices::SRAM62256 sram(bus);
+    bus->addSlave(&sram);
+    {
+        devices::ArduinoMega arduino(bus, path);
+        bus->addSlave(&arduino);
+        bus->write(0x0010, 0x42);
+        EXPECT_EQ(bus->read(0x0010), 0x42);
+    }
+
+    core::BusTraceReader reader(path);
+    auto write = reader.next();
+    auto read = reader.next();
+    ASSERT_TRUE(write && read);
+    EXPECT_EQ(core::bus_trace::formatArduino(*write), "0000000000010000   0010  W 42   01000010");
+    EXPECT_EQ(core::bus_trace::formatArduino(*read), "0000000000010000   0010  r 42   01000010");
+    EXPECT_FALSE(reader.next());
+}
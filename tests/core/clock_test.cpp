@@ -0,0 +1,69 @@
+// Test suite for core::Clock pacing
+#include "core/clock.h"
+#include "core/defines.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace EaterEmulator;
+
+// Observer counting clock edges and checking they alternate LOW/HIGH
+class EdgeCounter : public core::ClockObserver
+{
+public:
+    void onClockStateChange(core::State newState) override
+    {
+        alternating = alternating && newState != last;
+        last = newState;
+        newState == core::HIGH ? ++high : ++low;
+    }
+
+    core::State last = core::HIGH;
+    bool alternating = true;
+    uint64_t low = 0;
+    uint64_t high = 0;
+};
+
+static void waitForStop(const core::Clock& clock)
+{
+    while (clock.isRunning())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+TEST(ClockTest, UnthrottledStopsAtCycleLimit)
+{
+    EdgeCounter counter;
+    core::Clock clock(core::Clock::UNTHROTTLED);
+    clock.registerObserver(&counter);
+    clock.setCycleLimit(10'000);
+
+    clock.start();
+    waitForStop(clock);
+    clock.stop();
+
+    EXPECT_EQ(clock.getCycleCount(), 10'000u);
+    EXPECT_EQ(counter.low, 10'000u);
+    EXPECT_EQ(counter.high, 10'000u);
+    EXPECT_TRUE(counter.alternating);
+}
+
+TEST(ClockTest, ThrottledRunsNoFasterThanFrequency)
+{
+    EdgeCounter counter;
+    core::Clock clock(1'000'000);
+    clock.registerObserver(&counter);
+    clock.setCycleLimit(100'000); // 100 ms of real time
+
+    const auto start = std::chrono::steady_clock::now();
+    clock.start();
+    waitForStop(clock);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(counter.high, 100'000u);
+    // Each batch sleeps to its deadline, including the last one, allowing for timer granularity
+    EXPECT_GE(elapsed, std::chrono::milliseconds(99));
+}
@@ -0,0 +1,51 @@
+// Test suite for parsing machine configs
+#include "core/machine_config.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+using namespace EaterEmulator;
+
+TEST(MachineConfigParseTest, DefaultsToBenEatersBoard)
+{
+    const auto config = core::MachineConfig::parse("# Nothing but comments\n\n");
+    EXPECT_EQ(config.rom.start, 0x8000);
+    EXPECT_EQ(config.rom.end, 0xFFFF);
+    EXPECT_EQ(config.ram.start, 0x0000);
+    EXPECT_EQ(config.ram.end, 0x3FFF);
+    EXPECT_EQ(config.acia.start, 0x5000);
+    EXPECT_EQ(config.via.start, 0x6000);
+    EXPECT_EQ(config.clockFrequency, 1'000'000u);
+    EXPECT_TRUE(config.romPath.empty());
+}
+
+TEST(MachineConfigParseTest, ParsesEveryKey)
+{
+    const auto config = core::MachineConfig::parse(
+        "rom = C000-FFFF   # 16K\n"
+        "ram=0000-7FFF\n"
+        "  acia = 4000-40FF\r\n"
+        "via = 4100-41ff\n"
+        "clock = 2000000\n"
+        "rom_file = wozmon.bin\n",
+        "roms");
+    EXPECT_EQ(config.rom.start, 0xC000);
+    EXPECT_EQ(config.ram.end, 0x7FFF);
+    EXPECT_EQ(config.acia.start, 0x4000);
+    EXPECT_EQ(config.acia.end, 0x40FF);
+    EXPECT_EQ(config.via.end, 0x41FF);
+    EXPECT_EQ(config.clockFrequency, 2'000'000u);
+    EXPECT_EQ(config.romPath, "roms/wozmon.bin");
+}
+
+TEST(MachineConfigParseTest, RejectsInvalidLines)
+{
+    EXPECT_THROW(core::MachineConfig::parse("rom 8000-FFFF\n"), std::runtime_error);
+    EXPECT_THROW(core::MachineConfig::parse("eeprom = 8000-FFFF\n"), std::runtime_error);
+    EXPECT_THROW(core::MachineConfig::parse("rom = 8000\n"), std::runtime_error);
+    EXPECT_THROW(core::MachineConfig::parse("rom = FFFF-8000\n"), std::runtime_error);
+    EXPECT_THROW(core::MachineConfig::parse("ram = 0000-1FFFF\n"), std::runtime_error);
+    EXPECT_THROW(core::MachineConfig::parse("clock = 0\n"), std::runtime_error);
+    EXPECT_THROW(core::MachineConfig::load("does/not/exist.cfg"), std::runtime_error);
+}
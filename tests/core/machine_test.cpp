@@ -0,0 +1,328 @@
+// Test suite for running and forking whole machines
+#include "core/clock.h"
+#include "core/machine.h"
+#include "devices/W65C51N/SerialSink.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace EaterEmulator;
+
+namespace
+{
+    // Counts in zero page and copies the count to the ACIA and into the page at $0200
+    const std::vector<uint8_t> PROGRAM = {
+        0xA9, 0x00,         // 8000:       LDA #$00
+        0x85, 0x21,         //             STA $21
+        0xA9, 0x02,         //             LDA #$02
+        0x85, 0x22,         //             STA $22     ; ($21) points to $0200
+        0xE6, 0x10,         // 8008: loop: INC $10
+        0xA5, 0x10,         //             LDA $10
+        0x8D, 0x00, 0x50,   //             STA $5000   ; ACIA data
+        0xA4, 0x10,         //             LDY $10
+        0x91, 0x21,         //             STA ($21),Y
+        0x4C, 0x08, 0x80,   //             JMP loop
+    };
+
+    // Stores each character read from the ACIA at $0200
+    const std::vector<uint8_t> POLLING_PROGRAM = {
+        0xAD, 0x01, 0x50,   // 8000: wait: LDA $5001   ; ACIA status
+        0x29, 0x08,         //             AND #$08    ; Receiver full
+        0xF0, 0xF9,         //             BEQ wait
+        0xAD, 0x00, 0x50,   //             LDA $5000   ; ACIA data
+        0x8D, 0x00, 0x02,   //             STA $0200
+        0x4C, 0x00, 0x80,   //             JMP wait
+    };
+
+    std::vector<uint8_t> makeRom(const std::vector<uint8_t>& program = PROGRAM)
+    {
+        std::vector<uint8_t> image(0x8000, 0xEA);
+        std::copy(program.begin(), program.end(), image.begin());
+        image[0xFFFC - 0x8000] = 0x00;
+        image[0xFFFD - 0x8000] = 0x80;
+        return image;
+    }
+
+    void waitForStop(const core::Clock& clock)
+    {
+        while (clock.isRunning())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    uint8_t peek(core::Machine& machine, uint16_t address)
+    {
+        return machine.getBus().read(address);
+    }
+}
+
+class MachineTest : public ::testing::Test {
+protected:
+    core::Machine machine{makeRom()};
+    std::shared_ptr<devices::MemorySink> sink = std::make_shared<devices::MemorySink>();
+
+    void SetUp() override
+    {
+        machine.getACIA().setTransmitSink(sink);
+        machine.getCPU().runInstructions(500);
+    }
+};
+
+TEST_F(MachineTest, ForkSharesROMAndRAM)
+{
+    auto fork = machine.fork();
+    EXPECT_EQ(fork->getROM().getImage(), machine.getROM().getImage());
+    EXPECT_EQ(fork->getRAM().getPrivatePageCount(), 0u);
+    EXPECT_EQ(machine.getRAM().getPrivatePageCount(), 0u);
+    EXPECT_EQ(fork->getCPU().getProgramCounter(), machine.getCPU().getProgramCounter());
+    EXPECT_EQ(fork->getCPU().getCycleCount(), machine.getCPU().getCycleCount());
+    EXPECT_EQ(fork->saveState(), machine.saveState());
+}
+
+TEST_F(MachineTest, ForkOnlyCopiesDirtiedPages)
+{
+    auto fork = machine.fork();
+    fork->getCPU().runInstructions(100);
+    // Zero page and the page at $0200
+    EXPECT_EQ(fork->getRAM().getPrivatePageCount(), 2u);
+    EXPECT_EQ(machine.getRAM().getPrivatePageCount(), 0u);
+}
+
+TEST_F(MachineTest, WritesDoNotLeakBetweenForks)
+{
+    const auto count = peek(machine, 0x10);
+    auto fork = machine.fork();
+
+    fork->getCPU().runInstructions(100);
+    EXPECT_EQ(peek(machine, 0x10), count);
+    EXPECT_NE(peek(*fork, 0x10), count);
+
+    machine.getBus().write(0x3000, 0x42);
+    EXPECT_EQ(peek(machine, 0x3000), 0x42);
+    EXPECT_EQ(peek(*fork, 0x3000), 0x00);
+}
+
+TEST_F(MachineTest, ForksRunLikeTheOriginal)
+{
+    auto first = machine.fork();
+    auto second = first->fork();
+    auto firstSink = std::make_shared<devices::MemorySink>();
+    auto secondSink = std::make_shared<devices::MemorySink>();
+    first->getACIA().setTransmitSink(firstSink);
+    second->getACIA().setTransmitSink(secondSink);
+
+    machine.getCPU().runInstructions(2000);
+    first->getCPU().runInstructions(2000);
+    second->getCPU().runInstructions(2000);
+
+    EXPECT_EQ(first->saveState(), machine.saveState());
+    EXPECT_EQ(second->saveState(), machine.saveState());
+    machine.getACIA().flushTransmit();
+    first->getACIA().flushTransmit();
+    second->getACIA().flushTransmit();
+    EXPECT_EQ(firstSink->data(), secondSink->data());
+    ASSERT_LE(firstSink->data().size(), sink->data().size());
+    EXPECT_TRUE(std::equal(firstSink->data().rbegin(), firstSink->data().rend(), sink->data().rbegin()));
+}
+
+TEST_F(MachineTest, ForkOutlivesOriginal)
+{
+    auto parent = machine.fork();
+    auto fork = parent->fork();
+    const auto expected = parent->saveState();
+    parent.reset();
+
+    EXPECT_EQ(fork->saveState(), expected);
+    fork->getCPU().runInstructions(100);
+}
+
+TEST_F(MachineTest, RestoringStopsSharing)
+{
+    const auto state = machine.saveState();
+    const auto count = peek(machine, 0x10);
+    auto fork = machine.fork();
+    fork->loadState(state);
+    fork->getCPU().runInstructions(100);
+    EXPECT_EQ(fork->getRAM().getPrivatePageCount(), 0u);
+    EXPECT_NE(peek(*fork, 0x10), count);
+    EXPECT_EQ(peek(machine, 0x10), count);
+}
+
+TEST_F(MachineTest, RunsWholeInstructionsForCycles)
+{
+    const auto start = machine.getCycleCount();
+    const auto cycles = machine.run(1000);
+    EXPECT_GE(cycles, 1000u);
+    EXPECT_LT(cycles, 1007u);
+    EXPECT_EQ(machine.getCycleCount(), start + cycles);
+    EXPECT_EQ(machine.run(0), 0u);
+}
+
+TEST_F(MachineTest, RunsUntilPredicate)
+{
+    EXPECT_TRUE(machine.runUntil([&] { return machine.read(0x10) == 0x80; }));
+    EXPECT_EQ(machine.read(0x10), 0x80);
+    // Stopped right after the increment, before the store
+    EXPECT_EQ(machine.read(0x027F), 0x7F);
+    EXPECT_EQ(machine.read(0x0280), 0x00);
+
+    const auto start = machine.getCycleCount();
+    EXPECT_FALSE(machine.runUntil([] { return false; }, 500));
+    EXPECT_GE(machine.getCycleCount() - start, 500u);
+}
+
+TEST(MachineIdleTest, FastForwardsWhilePollingTheACIA)
+{
+    core::Machine machine(makeRom(POLLING_PROGRAM));
+
+    EXPECT_GE(machine.run(1'000'000), 1'000'000u);
+    EXPECT_GT(machine.getCPU().getFastForwardedCycles(), 990'000u);
+
+    // Waiting input is seen on the next poll
+    machine.getACIA().receive('A');
+    machine.run(100);
+    EXPECT_EQ(machine.read(0x0200), 'A');
+}
+
+TEST(MachineIdleTest, ClockFastForwardsWhilePollingTheACIA)
+{
+    // Driven like the interactive emulator, in real time by a clock with the CPU as its only observer
+    core::Machine machine(makeRom(POLLING_PROGRAM));
+    core::Clock clock(1'000'000);
+    clock.registerObserver(&machine.getCPU());
+    clock.setCycleLimit(100'000); // 100 ms
+
+    clock.start();
+    waitForStop(clock);
+    EXPECT_GE(clock.getCycleCount(), 100'000u);
+    EXPECT_EQ(machine.getCycleCount(), clock.getCycleCount());
+    // Each batch runs a few iterations of the loop before skipping the rest
+    EXPECT_GT(machine.getCPU().getFastForwardedCycles(), 90'000u);
+
+    machine.getACIA().receive('A');
+    clock.setCycleLimit(clock.getCycleCount() + 10'000);
+    clock.start();
+    waitForStop(clock);
+    EXPECT_EQ(machine.read(0x0200), 'A');
+}
+
+TEST(MachineInterruptTest, WAIWakesOnSerialInput)
+{
+    std::vector<uint8_t> rom = makeRom({
+        0xA9, 0x09,         // 8000:       LDA #$09    ; DTR, receiver interrupt enabled
+        0x8D, 0x02, 0x50,   //             STA $5002   ; ACIA command
+        0x58,               //             CLI
+        0xCB,               // 8006: loop: WAI
+        0x4C, 0x06, 0x80,   //             JMP loop
+    });
+    const std::vector<uint8_t> handler = {
+        0xAD, 0x01, 0x50,   // 9000:       LDA $5001   ; Acknowledge
+        0xAD, 0x00, 0x50,   //             LDA $5000
+        0x8D, 0x00, 0x02,   //             STA $0200
+        0x40,               //             RTI
+    };
+    std::copy(handler.begin(), handler.end(), rom.begin() + 0x1000);
+    rom[0xFFFE - 0x8000] = 0x00;
+    rom[0xFFFF - 0x8000] = 0x90;
+    core::Machine machine(rom);
+
+    // Driven like the interactive emulator
+    core::Clock clock(1'000'000);
+    clock.registerObserver(&machine.getCPU());
+    clock.setCycleLimit(50'000);
+    clock.start();
+    waitForStop(clock);
+    EXPECT_TRUE(machine.getCPU().isWaiting());
+    EXPECT_EQ(machine.read(0x0200), 0x00);
+
+    machine.getACIA().receive('A');
+    clock.setCycleLimit(clock.getCycleCount() + 10'000);
+    clock.start();
+    waitForStop(clock);
+    EXPECT_EQ(machine.read(0x0200), 'A');
+    // Back in WAI with the interrupt acknowledged
+    EXPECT_TRUE(machine.getCPU().isWaiting());
+    EXPECT_EQ(machine.getCPU().getProgramCounter(), 0x8007);
+}
+
+TEST(MachineReservedOpcodeTest, RunsThroughReservedOpcodes)
+{
+    // Every opcode the W65C02S assigns no instruction to, with its operand bytes
+    const std::vector<std::vector<uint8_t>> reserved = {
+        { 0x02, 0xFF }, { 0x03 }, { 0x0B }, { 0x13 }, { 0x1B }, { 0x22, 0xFF }, { 0x23 }, { 0x2B },
+        { 0x33 }, { 0x3B }, { 0x42, 0xFF }, { 0x43 }, { 0x44, 0x10 }, { 0x4B }, { 0x53 },
+        { 0x54, 0x10 }, { 0x5B }, { 0x5C, 0x34, 0x12 }, { 0x62, 0xFF }, { 0x63 }, { 0x6B }, { 0x73 },
+        { 0x7B }, { 0x82, 0xFF }, { 0x83 }, { 0x8B }, { 0x93 }, { 0x9B }, { 0xA3 }, { 0xAB }, { 0xB3 },
+        { 0xBB }, { 0xC2, 0xFF }, { 0xC3 }, { 0xD3 }, { 0xD4, 0x10 }, { 0xDC, 0x00, 0x02 }, { 0xE2, 0xFF },
+        { 0xE3 }, { 0xEB }, { 0xF3 }, { 0xF4, 0x10 }, { 0xFB }, { 0xFC, 0x00, 0x02 },
+    };
+    std::vector<uint8_t> program;
+    for (const auto& instruction : reserved)
+    {
+        program.insert(program.end(), instruction.begin(), instruction.end());
+    }
+    const auto storeAt = static_cast<uint16_t>(0x8000 + program.size());
+    program.insert(program.end(), {
+        0xA9, 0x42,         // LDA #$42
+        0x8D, 0x00, 0x03,   // STA $0300
+        0x4C,               // JMP *
+        static_cast<uint8_t>((storeAt + 5) & 0xFF),
+        static_cast<uint8_t>((storeAt + 5) >> 8),
+    });
+    std::vector<uint8_t> rom(0x8000, 0xEA);
+    std::copy(program.begin(), program.end(), rom.begin());
+    rom[0xFFFC - 0x8000] = 0x00;
+    rom[0xFFFD - 0x8000] = 0x80;
+    core::Machine machine(rom);
+
+    // Each one takes cycles and moves on, so run() returns and the code after them executes
+    EXPECT_GE(machine.run(1000), 1000u);
+    EXPECT_EQ(machine.read(0x0300), 0x42);
+    EXPECT_EQ(machine.getCPU().getProgramCounter(), storeAt + 5);
+}
+
+TEST(MachineConfigTest, RunsWithConfiguredMemoryMap)
+{
+    // The same program in a 16K ROM at 0xC000, which is the upper half of the image, with all 32K of RAM
+    // and the ACIA at 0x8000
+    auto program = PROGRAM;
+    program[0x05] = 0x40;   // ($21) points to $4000, beyond the RAM of Ben Eater's board
+    program[0x0D] = 0x00;
+    program[0x0E] = 0x80;   // STA $8000    ; ACIA data
+    program[0x15] = 0xC0;   // JMP loop at $C008
+    std::vector<uint8_t> rom(0x8000, 0xEA);
+    std::copy(program.begin(), program.end(), rom.begin() + 0x4000);
+    rom[0xFFFC - 0x8000] = 0x00;
+    rom[0xFFFD - 0x8000] = 0xC0;
+
+    const auto config = core::MachineConfig::parse("rom = C000-FFFF\nram = 0000-7FFF\nacia = 8000-80FF\nvia = 9000-90FF\n");
+    core::Machine machine(rom, config);
+    auto sink = std::make_shared<devices::MemorySink>();
+    machine.getACIA().setTransmitSink(sink);
+    EXPECT_TRUE(machine.runUntil([&] { return machine.read(0x10) == 0x20; }, 100'000));
+    machine.getACIA().flushTransmit();
+
+    EXPECT_EQ(machine.read(0x401F), 0x1F);
+    ASSERT_FALSE(sink->data().empty());
+    EXPECT_EQ(sink->data()[0], 0x01);
+
+    // Forks keep the memory map
+    auto fork = machine.fork();
+    EXPECT_EQ(fork->read(0x401F), 0x1F);
+    fork->write(0x7800, 0x42);
+    EXPECT_EQ(fork->read(0x7800), 0x42);
+    EXPECT_EQ(machine.read(0x7800), 0x00);
+}
+
+TEST(MachineConfigTest, RejectsOverlappingDevices)
+{
+    const auto config = core::MachineConfig::parse("ram = 0000-7FFF\n");
+    EXPECT_THROW(core::Machine(makeRom(), config), std::runtime_error);
+}
@@ -0,0 +1,88 @@
+// Test suite for the cycle-stamped event scheduler
+#include "core/scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace EaterEmulator;
+
+TEST(SchedulerTest, FiresDueEventsInCycleOrder)
+{
+    core::Scheduler scheduler;
+    std::vector<int> fired;
+    scheduler.schedule(30, [&](uint64_t) { fired.push_back(3); });
+    scheduler.schedule(10, [&](uint64_t) { fired.push_back(1); });
+    scheduler.schedule(20, [&](uint64_t) { fired.push_back(2); });
+    EXPECT_EQ(scheduler.nextEventCycle(), 10u);
+
+    scheduler.advance(9);
+    EXPECT_TRUE(fired.empty());
+
+    scheduler.advance(25);
+    EXPECT_EQ(fired, std::vector<int>({ 1, 2 }));
+    EXPECT_EQ(scheduler.nextEventCycle(), 30u);
+
+    scheduler.advance(30);
+    EXPECT_EQ(fired, std::vector<int>({ 1, 2, 3 }));
+    EXPECT_EQ(scheduler.nextEventCycle(), core::Scheduler::NEVER);
+    EXPECT_TRUE(scheduler.empty());
+}
+
+TEST(SchedulerTest, SameCycleEventsFireInScheduleOrder)
+{
+    core::Scheduler scheduler;
+    std::vector<int> fired;
+    for (int i = 0; i < 5; ++i)
+    {
+        scheduler.schedule(100, [&fired, i](uint64_t) { fired.push_back(i); });
+    }
+
+    scheduler.advance(100);
+
+    EXPECT_EQ(fired, std::vector<int>({ 0, 1, 2, 3, 4 }));
+}
+
+TEST(SchedulerTest, CallbackReceivesScheduledCycle)
+{
+    core::Scheduler scheduler;
+    uint64_t firedAt = 0;
+    scheduler.advance(40);
+    scheduler.scheduleIn(10, [&](uint64_t cycle) { firedAt = cycle; });
+
+    scheduler.advance(57); // Late boundary, e.g. in the middle of a long instruction
+
+    EXPECT_EQ(firedAt, 50u);
+}
+
+TEST(SchedulerTest, CancelledEventsDoNotFire)
+{
+    core::Scheduler scheduler;
+    int fired = 0;
+    auto first = scheduler.schedule(10, [&](uint64_t) { fired++; });
+    scheduler.schedule(20, [&](uint64_t) { fired++; });
+
+    EXPECT_TRUE(scheduler.cancel(first));
+    EXPECT_FALSE(scheduler.cancel(first));
+    EXPECT_EQ(scheduler.nextEventCycle(), 20u);
+
+    scheduler.advance(20);
+    EXPECT_EQ(fired, 1);
+}
+
+TEST(SchedulerTest, PeriodicEventReschedulesItself)
+{
+    core::Scheduler scheduler;
+    std::vector<uint64_t> fired;
+    std::function<void(uint64_t)> tick = [&](uint64_t cycle) {
+        fired.push_back(cycle);
+        scheduler.schedule(cycle + 100, tick);
+    };
+    scheduler.schedule(100, tick);
+
+    scheduler.advance(350);
+
+    EXPECT_EQ(fired, std::vector<uint64_t>({ 100, 200, 300 }));
+    EXPECT_EQ(scheduler.nextEventCycle(), 400u);
+}
@@ -0,0 +1,72 @@
+// Test suite for the lock-free SPSC ring buffer
+#include "core/spsc_ring.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+
+using namespace EaterEmulator;
+
+TEST(SpscRingTest, PushPopInOrderUntilFull)
+{
+    core::SpscRing<int, 4> ring;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_FALSE(ring.pop().has_value());
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(ring.push(i));
+    }
+    EXPECT_FALSE(ring.push(4));
+    EXPECT_EQ(ring.size(), 4u);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_EQ(ring.pop(), i);
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingTest, WrapsAround)
+{
+    core::SpscRing<uint8_t, 8> ring;
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(ring.push(static_cast<uint8_t>(i)));
+        ASSERT_EQ(ring.pop(), static_cast<uint8_t>(i));
+    }
+}
+
+TEST(SpscRingTest, ConcurrentProducerAndConsumer)
+{
+    constexpr uint32_t COUNT = 200'000;
+    core::SpscRing<uint32_t, 64> ring;
+
+    std::jthread producer([&ring]() {
+        for (uint32_t i = 0; i < COUNT; )
+        {
+            if (ring.push(i))
+            {
+                ++i;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (uint32_t expected = 0; expected < COUNT; )
+    {
+        if (auto value = ring.pop())
+        {
+            ASSERT_EQ(*value, expected);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,207 @@
+// Test suite for saving and restoring machine state
+#include "core/bus.h"
+#include "core/state.h"
+#include "devices/EEPROM28C256/EEPROM28C256.h"
+#include "devices/HD44780LCD/HD44780LCD.h"
+#include "devices/SRAM62256/SRAM62256.h"
+#include "devices/W65C02S/W65C02S.h"
+#include "devices/W65C22S/W65C22S.h"
+#include "devices/W65C51N/SerialSink.h"
+#include "devices/W65C51N/W65C51N.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace EaterEmulator;
+
+namespace
+{
+    // Starts VIA T1 as a free-running timer, then counts in RAM and sends the count to the ACIA
+    const std::vector<uint8_t> PROGRAM = {
+        0xA9, 0x40,         // 8000:       LDA #$40
+        0x8D, 0x0B, 0x60,   //             STA $600B   ; ACR, T1 free run
+        0xA9, 0x34,         //             LDA #$34
+        0x8D, 0x04, 0x60,   //             STA $6004   ; T1CL
+        0xA9, 0x01,         //             LDA #$01
+        0x8D, 0x05, 0x60,   //             STA $6005   ; T1CH, starts T1
+        0xE6, 0x10,         // 800F: loop: INC $10
+        0xA5, 0x10,         //             LDA $10
+        0x8D, 0x00, 0x50,   //             STA $5000   ; ACIA data
+        0x9D, 0x00, 0x02,   //             STA $0200,X
+        0xE8,               //             INX
+        0x4C, 0x0F, 0x80,   //             JMP loop
+    };
+}
+
+class StateTest : public ::testing::Test {
+protected:
+    std::shared_ptr<core::Bus> bus = std::make_shared<core::Bus>();
+    std::shared_ptr<devices::W65C02S> cpu = std::make_shared<devices::W65C02S>(bus);
+    std::unique_ptr<devices::EEPROM28C256> rom;
+    devices::SRAM62256 ram{bus};
+    devices::W65C22S via{bus};
+    devices::W65C51N acia{bus};
+    devices::HD44780LCD lcd;
+    std::shared_ptr<devices::MemorySink> sink = std::make_shared<devices::MemorySink>();
+
+    void SetUp() override
+    {
+        std::vector<uint8_t> image(0x8000, 0xEA);
+        std::copy(PROGRAM.begin(), PROGRAM.end(), image.begin());
+        image[0xFFFC - 0x8000] = 0x00;
+        image[0xFFFD - 0x8000] = 0x80;
+        rom = std::make_unique<devices::EEPROM28C256>(image, bus);
+        bus->addSlave(rom.get());
+        bus->addSlave(&ram);
+        bus->addSlave(&via);
+        bus->addSlave(&acia);
+        acia.setTransmitSink(sink);
+        cpu->reset();
+    }
+
+    std::array<const core::Stateful*, 6> components() const { return { bus.get(), cpu.get(), &ram, &via, &acia, &lcd }; }
+    std::array<core::Stateful*, 6> mutableComponents() { return { bus.get(), cpu.get(), &ram, &via, &acia, &lcd }; }
+
+    std::vector<uint8_t> save() const { return core::machine_state::save(components()); }
+    void load(const std::vector<uint8_t>& state) { core::machine_state::load(state, mutableComponents()); }
+
+    void writeLCD(uint8_t rs, uint8_t data)
+    {
+        lcd.writeDataLines(data);
+        lcd.setControlLines(rs, 0, true);
+        lcd.setControlLines(rs, 0, false);
+    }
+};
+
+TEST_F(StateTest, RestoredMachineRunsTheSame)
+{
+    writeLCD(0, 0x38); // Function set, 8-bit two lines
+    writeLCD(0, 0x0E); // Display and cursor on
+    writeLCD(1, 'A');
+    cpu->runInstructions(1000);
+    const auto checkpoint = save();
+
+    writeLCD(1, 'B');
+    cpu->runInstructions(5000);
+    acia.flushTransmit();
+    const auto expected = save();
+    const auto expectedOutput = sink->data();
+
+    load(checkpoint);
+    EXPECT_EQ(save(), checkpoint);
+    sink->clear();
+    writeLCD(1, 'B');
+    cpu->runInstructions(5000);
+    acia.flushTransmit();
+
+    EXPECT_EQ(save(), expected);
+    // The output from the checkpoint on is sent again, including what was buffered at the time
+    const auto& output = sink->data();
+    ASSERT_LE(output.size(), expectedOutput.size());
+    EXPECT_TRUE(std::equal(output.begin(), output.end(), expectedOutput.end() - static_cast<std::ptrdiff_t>(output.size())));
+}
+
+TEST_F(StateTest, RestoresInstructionCount)
+{
+    cpu->runInstructions(1000);
+    const auto checkpoint = save();
+    const auto instructions = cpu->getInstructionCount();
+    EXPECT_GT(instructions, 0u);
+
+    cpu->runInstructions(500);
+    load(checkpoint);
+    EXPECT_EQ(cpu->getInstructionCount(), instructions);
+    cpu->runInstructions(1);
+    EXPECT_EQ(cpu->getInstructionCount(), instructions + 1);
+}
+
+TEST_F(StateTest, RestoreReschedulesTimers)
+{
+    cpu->runInstructions(10);
+    EXPECT_FALSE(bus->getScheduler().empty());
+    const auto checkpoint = save();
+
+    load(checkpoint);
+    EXPECT_FALSE(bus->getScheduler().empty());
+    cpu->runInstructions(1000);
+    EXPECT_NE(bus->read(0x600D) & devices::W65C22S::IRQ_T1, 0);
+}
+
+TEST_F(StateTest, RestoresLCDDisplay)
+{
+    writeLCD(0, 0x38);
+    writeLCD(0, 0x0C);
+    writeLCD(1, 'H');
+    writeLCD(1, 'i');
+    const auto checkpoint = save();
+
+    writeLCD(0, 0x01); // Clear display
+    lcd.takeSnapshot();
+    const auto generation = lcd.getGeneration();
+    load(checkpoint);
+
+    const auto snapshot = lcd.takeSnapshot();
+    EXPECT_GT(snapshot.generation, generation);
+    EXPECT_EQ(snapshot.ddram[0], 'H');
+    EXPECT_EQ(snapshot.ddram[1], 'i');
+    EXPECT_EQ(snapshot.addressCounter, 2);
+    EXPECT_TRUE(snapshot.displayOn);
+    EXPECT_TRUE(snapshot.twoLines);
+    EXPECT_TRUE(snapshot.dirtyCells.all());
+}
+
+TEST_F(StateTest, RejectsForeignData)
+{
+    auto state = save();
+    state[0] = 'X';
+    EXPECT_THROW(load(state), std::runtime_error);
+}
+
+TEST_F(StateTest, RejectsOtherVersions)
+{
+    auto state = save();
+    state[sizeof(core::machine_state::MAGIC)]++;
+    EXPECT_THROW(load(state), std::runtime_error);
+}
+
+TEST_F(StateTest, RejectsTruncatedState)
+{
+    auto state = save();
+    state.resize(state.size() - 1);
+    EXPECT_THROW(load(state), std::runtime_error);
+}
+
+TEST_F(StateTest, RejectsDifferentMachine)
+{
+    const auto state = save();
+    std::array<core::Stateful*, 6> reordered = { bus.get(), cpu.get(), &via, &ram, &acia, &lcd };
+    EXPECT_THROW(core::machine_state::load(state, reordered), std::runtime_error);
+
+    std::array<core::Stateful*, 2> fewer = { bus.get(), cpu.get() };
+    EXPECT_THROW(core::machine_state::load(state, fewer), std::runtime_error);
+}
+
+TEST(StateReaderTest, ValuesRoundTripLittleEndian)
+{
+    std::vector<uint8_t> buffer;
+    core::StateWriter writer(buffer);
+    writer.write(uint16_t{0x1234});
+    writer.write(true);
+    writer.write(int32_t{-2});
+    writer.write(uint64_t{0x0102030405060708});
+    EXPECT_EQ(buffer[0], 0x34);
+    EXPECT_EQ(buffer[1], 0x12);
+
+    core::StateReader reader(buffer);
+    EXPECT_EQ(reader.read<uint16_t>(), 0x1234);
+    EXPECT_TRUE(reader.read<bool>());
+    EXPECT_EQ(reader.read<int32_t>(), -2);
+    EXPECT_EQ(reader.read<uint64_t>(), 0x0102030405060708u);
+    EXPECT_EQ(reader.remaining(), 0u);
+    EXPECT_THROW(reader.read<uint8_t>(), std::runtime_error);
+}
@@ -0,0 +1,126 @@
+// Test suite for the work-stealing task pool
+#include "core/task_pool.h"
+#include "core/machine.h"
+#include "devices/W65C51N/SerialSink.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace EaterEmulator;
+
+TEST(TaskPoolTest, RunsEveryTask)
+{
+    core::TaskPool pool(4);
+    EXPECT_EQ(pool.getThreadCount(), 4u);
+    std::atomic<int> count = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        pool.submit([&] { ++count; });
+    }
+    pool.wait();
+    EXPECT_EQ(count, 1000);
+
+    // The pool can be reused after waiting
+    pool.submit([&] { ++count; });
+    pool.wait();
+    EXPECT_EQ(count, 1001);
+}
+
+TEST(TaskPoolTest, WaitsForNestedTasks)
+{
+    core::TaskPool pool(3);
+    std::atomic<int> count = 0;
+    pool.submit([&] {
+        for (int i = 0; i < 100; ++i)
+        {
+            pool.submit([&] {
+                pool.submit([&] { ++count; });
+            });
+        }
+    });
+    pool.wait();
+    EXPECT_EQ(count, 100);
+}
+
+TEST(TaskPoolTest, IdleWorkersStealQueuedTasks)
+{
+    core::TaskPool pool(4);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    // Everything is queued on the one worker running the first task
+    pool.submit([&] {
+        for (int i = 0; i < 16; ++i)
+        {
+            pool.submit([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                std::lock_guard lock(mutex);
+                threads.insert(std::this_thread::get_id());
+            });
+        }
+    });
+    pool.wait();
+    EXPECT_GT(threads.size(), 1u);
+}
+
+TEST(TaskPoolTest, WaitRethrowsTaskException)
+{
+    core::TaskPool pool(2);
+    std::atomic<int> count = 0;
+    pool.submit([] { throw std::runtime_error("failed"); });
+    for (int i = 0; i < 10; ++i)
+    {
+        pool.submit([&] { ++count; });
+    }
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_EQ(count, 10);
+
+    pool.submit([&] { ++count; });
+    EXPECT_NO_THROW(pool.wait());
+}
+
+TEST(TaskPoolTest, MachinesRunIndependently)
+{
+    // Writes the X register to the ACIA forever
+    std::vector<uint8_t> rom(0x8000, 0xEA);
+    const std::vector<uint8_t> program = {
+        0x8E, 0x00, 0x50,   // 8000: loop: STX $5000
+        0xE8,               //             INX
+        0x4C, 0x00, 0x80,   //             JMP loop
+    };
+    std::copy(program.begin(), program.end(), rom.begin());
+    rom[0xFFFC - 0x8000] = 0x00;
+    rom[0xFFFD - 0x8000] = 0x80;
+    const auto image = std::make_shared<devices::EEPROM28C256::Image>();
+    std::copy(rom.begin(), rom.end(), image->begin());
+
+    constexpr size_t JOBS = 8;
+    std::vector<std::vector<uint8_t>> outputs(JOBS);
+    core::TaskPool pool(4);
+    for (size_t i = 0; i < JOBS; ++i)
+    {
+        pool.submit([&, i] {
+            core::Machine machine(image);
+            auto sink = std::make_shared<devices::MemorySink>();
+            machine.getACIA().setTransmitSink(sink);
+            machine.getCPU().runInstructions(3000);
+            machine.getACIA().flushTransmit();
+            outputs[i] = sink->data();
+        });
+    }
+    pool.wait();
+
+    ASSERT_FALSE(outputs[0].empty());
+    for (const auto& output : outputs)
+    {
+        EXPECT_EQ(output, outputs[0]);
+    }
+}
@@ -0,0 +1,84 @@
+// Test suite for the trace channel
+#include "core/trace.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace EaterEmulator;
+
+class TraceTest : public ::testing::Test {
+protected:
+    std::vector<std::string> lines;
+
+    void SetUp() override
+    {
+        core::trace::drain([](std::string_view) {});
+    }
+
+    void TearDown() override
+    {
+        core::trace::setEnabled(false);
+    }
+
+    size_t drain()
+    {
+        return core::trace::drain([this](std::string_view line) { lines.emplace_back(line); });
+    }
+};
+
+TEST_F(TraceTest, DrainFormatsRecords)
+{
+    core::trace::emit("Plain");
+    core::trace::emit("Address {:#06x} data {:#04x}", uint16_t{0x8000}, uint8_t{0x2A});
+
+    EXPECT_EQ(drain(), 2u);
+    EXPECT_EQ(lines, (std::vector<std::string>{ "Plain", "Address 0x8000 data 0x2a" }));
+    EXPECT_EQ(drain(), 0u);
+}
+
+TEST_F(TraceTest, DisabledTracePointSkipsArguments)
+{
+    int evaluations = 0;
+    EATER_TRACE("Value {}", ++evaluations);
+
+    EXPECT_EQ(evaluations, 0);
+    EXPECT_EQ(drain(), 0u);
+}
+
+TEST_F(TraceTest, EnabledTracePointIsRecordedWhenCompiledIn)
+{
+    core::trace::setEnabled(true);
+    EATER_TRACE("Value {}", 5);
+
+    EXPECT_EQ(drain(), core::trace::isCompiledIn() ? 1u : 0u);
+}
+
+TEST_F(TraceTest, FullRingDropsRecords)
+{
+    const auto droppedBefore = core::trace::droppedCount();
+    for (size_t i = 0; i < core::trace::RING_CAPACITY + 10; ++i)
+    {
+        core::trace::emit("Record {}", i);
+    }
+
+    EXPECT_EQ(core::trace::droppedCount() - droppedBefore, 10u);
+    EXPECT_EQ(drain(), core::trace::RING_CAPACITY);
+    EXPECT_EQ(lines.front(), "Record 0");
+}
+
+TEST_F(TraceTest, DrainsRecordsFromOtherThreads)
+{
+    std::thread producer([]() {
+        for (int i = 0; i < 3; ++i)
+        {
+            core::trace::emit("Thread {}", i);
+        }
+    });
+    producer.join();
+
+    EXPECT_EQ(drain(), 3u);
+    EXPECT_EQ(lines.back(), "Thread 2");
+}
@@ -0,0 +1,341 @@
+// Runs many ROMs, or one ROM against many serial inputs, each on its own machine across all cores
+#include "core/machine.h"
+#include "core/task_pool.h"
+#include "devices/W65C51N/SerialSink.h"
+
+#include "spdlog/sinks/base_sink.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace EaterEmulator;
+
+namespace
+{
+    constexpr uint64_t DEFAULT_MAX_CYCLES = 100'000'000;
+    constexpr uint64_t CYCLES_PER_SLICE = 30'000; // Between checks for input, output and errors
+
+    struct Options
+    {
+        std::vector<std::string> jobs; // "rom" or "rom:input"
+        size_t threads = 0;
+        uint64_t maxCycles = DEFAULT_MAX_CYCLES;
+        uint64_t cpuFrequency = 1'000'000; // Sets the ACIA's character timing
+        std::string until; // Stop a job once its serial output contains this
+        std::string outputDir; // Also write each job's serial output to <dir>/<job>.out
+    };
+
+    struct Job
+    {
+        std::string romPath;
+        std::string inputPath; // Empty for no serial input
+        std::shared_ptr<const devices::EEPROM28C256::Image> rom;
+        std::string input;
+    };
+
+    struct Result
+    {
+        std::string exit; // "until", "cycle-limit" or "error"
+        std::string error;
+        uint64_t cycles = 0;
+        uint64_t instructions = 0;
+        double seconds = 0.0;
+        std::string output;
+    };
+
+    // Remembers the first error a machine logs, which ends its job
+    class ErrorSink : public spdlog::sinks::base_sink<spdlog::details::null_mutex>
+    {
+    public:
+        const std::optional<std::string>& getError() const { return _error; }
+
+    protected:
+        void sink_it_(const spdlog::details::log_msg& message) override
+        {
+            if (!_error && message.level >= spdlog::level::err)
+            {
+                _error = std::string(message.payload.data(), message.payload.size());
+            }
+        }
+        void flush_() override {}
+
+    private:
+        std::optional<std::string> _error;
+    };
+
+    void printUsage(const char* program)
+    {
+        spdlog::info("Usage: {} [options] <rom>[:<input>]...", program);
+        spdlog::info("  --jobs <path>        File with one <rom> [<input>] job per line");
+        spdlog::info("  --threads <n>        Worker threads (default one per hardware thread)");
+        spdlog::info("  --max-cycles <n>     Stop each job after n clock cycles (default {})", DEFAULT_MAX_CYCLES);
+        spdlog::info("  --hz <frequency>     Emulated clock frequency for the serial timing (default 1000000)");
+        spdlog::info("  --until <text>       Stop a job once its serial output contains text");
+        spdlog::info("  --output-dir <path>  Write each job's serial output to <path>/<job>.out");
+        spdlog::info("Each input is sent to the ACIA as the job runs. Results are printed as one JSON object per line.");
+    }
+
+    std::string readFile(const std::string& path)
+    {
+        std::ifstream ifs(path, std::ios::binary);
+        if (!ifs)
+        {
+            throw std::runtime_error("Error reading file: " + path);
+        }
+        return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+
+    void readJobFile(const std::string& path, std::vector<std::string>& jobs)
+    {
+        std::ifstream ifs(path);
+        if (!ifs)
+        {
+            throw std::runtime_error("Error reading job file: " + path);
+        }
+        std::string line;
+        while (std::getline(ifs, line))
+        {
+            const auto start = line.find_first_not_of(" \t");
+            if (start == std::string::npos || line[start] == '#')
+            {
+                continue;
+            }
+            const auto end = line.find_last_not_of(" \t\r");
+            line = line.substr(start, end - start + 1);
+            const auto separator = line.find_first_of(" \t");
+            if (separator != std::string::npos)
+            {
+                line = line.substr(0, separator) + ":" + line.substr(line.find_first_not_of(" \t", separator));
+            }
+            jobs.push_back(line);
+        }
+    }
+
+    std::optional<Options> parseOptions(int argc, char* argv[])
+    {
+        Options options;
+        try
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                std::string_view arg = argv[i];
+                auto value = [&]() -> std::string {
+                    if (i + 1 >= argc)
+                    {
+                        throw std::invalid_argument(std::string(arg) + " requires a value");
+                    }
+                    return argv[++i];
+                };
+
+                if (arg == "--jobs") readJobFile(value(), options.jobs);
+                else if (arg == "--threads") options.threads = std::stoul(value());
+                else if (arg == "--max-cycles") options.maxCycles = std::stoull(value());
+                else if (arg == "--hz") options.cpuFrequency = std::stoull(value());
+                else if (arg == "--until") options.until = value();
+                else if (arg == "--output-dir") options.outputDir = value();
+                else if (arg == "--help" || arg == "-h") return std::nullopt;
+                else if (!arg.starts_with("--")) options.jobs.emplace_back(arg);
+                else throw std::invalid_argument("Unknown option " + std::string(arg));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("Invalid arguments: {}", e.what());
+            return std::nullopt;
+        }
+
+        if (options.jobs.empty())
+        {
+            spdlog::error("No jobs specified.");
+            return std::nullopt;
+        }
+        if (options.cpuFrequency == 0)
+        {
+            spdlog::error("Clock frequency must be positive.");
+            return std::nullopt;
+        }
+        return options;
+    }
+
+    // Reads every ROM and input up front, each ROM once however many jobs use it
+    std::vector<Job> loadJobs(const std::vector<std::string>& specs)
+    {
+        std::map<std::string, std::shared_ptr<const devices::EEPROM28C256::Image>> roms;
+        std::vector<Job> jobs;
+        for (const auto& spec : specs)
+        {
+            Job job;
+            const auto separator = spec.find(':');
+            job.romPath = spec.substr(0, separator);
+            if (separator != std::string::npos)
+            {
+                job.inputPath = spec.substr(separator + 1);
+                job.input = readFile(job.inputPath);
+            }
+
+            auto& rom = roms[job.romPath];
+            if (!rom)
+            {
+                rom = devices::EEPROM28C256::loadImage(job.romPath);
+            }
+            job.rom = rom;
+            jobs.push_back(std::move(job));
+        }
+        return jobs;
+    }
+
+    Result runJob(const Job& job, const Options& options)
+    {
+        Result result;
+        const auto startTime = std::chrono::steady_clock::now();
+
+        core::Machine machine(job.rom);
+        auto errors = std::make_shared<ErrorSink>();
+        machine.setLogger(std::make_shared<spdlog::logger>("machine", errors));
+        auto sink = std::make_shared<devices::MemorySink>();
+        machine.getACIA().setTransmitSink(sink);
+        machine.getACIA().setClockFrequency(options.cpuFrequency);
+
+        size_t inputPosition = 0;
+        result.exit = "cycle-limit";
+        while (machine.getCycleCount() < options.maxCycles)
+        {
+            while (inputPosition < job.input.size() && machine.getACIA().receive(static_cast<uint8_t>(job.input[inputPosition])))
+            {
+                ++inputPosition;
+            }
+            machine.run(std::min(CYCLES_PER_SLICE, options.maxCycles - machine.getCycleCount()));
+
+            if (errors->getError())
+            {
+                result.exit = "error";
+                result.error = *errors->getError();
+                break;
+            }
+            if (!options.until.empty())
+            {
+                machine.getACIA().flushTransmit();
+                if (sink->str().find(options.until) != std::string::npos)
+                {
+                    result.exit = "until";
+                    break;
+                }
+            }
+        }
+        machine.getACIA().flushTransmit();
+
+        result.cycles = machine.getCycleCount();
+        result.instructions = machine.getCPU().getInstructionCount();
+        result.output = sink->str();
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        return result;
+    }
+
+    std::string jsonString(std::string_view text)
+    {
+        std::string json = "\"";
+        for (unsigned char c : text)
+        {
+            switch (c)
+            {
+                case '"': json += "\\\""; break;
+                case '\\': json += "\\\\"; break;
+                case '\n': json += "\\n"; break;
+                case '\r': json += "\\r"; break;
+                case '\t': json += "\\t"; break;
+                default:
+                    if (c < 0x20 || c >= 0x7F)
+                    {
+                        json += fmt::format("\\u{:04x}", c);
+                    }
+                    else
+                    {
+                        json += static_cast<char>(c);
+                    }
+            }
+        }
+        return json + "\"";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    spdlog::set_pattern("[%H:%M:%S %z] [%n] [%^---%L---%$] %v");
+    auto options = parseOptions(argc, argv);
+    if (!options)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<Job> jobs;
+    try
+    {
+        jobs = loadJobs(options->jobs);
+        if (!options->outputDir.empty())
+        {
+            std::filesystem::create_directories(options->outputDir);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        spdlog::error("{}", e.what());
+        return 1;
+    }
+
+    std::vector<Result> results(jobs.size());
+    core::TaskPool pool(options->threads);
+    const auto startTime = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        pool.submit([&, i] {
+            try
+            {
+                results[i] = runJob(jobs[i], *options);
+            }
+            catch (const std::exception& e)
+            {
+                results[i].exit = "error";
+                results[i].error = e.what();
+            }
+        });
+    }
+    pool.wait();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    int failed = 0;
+    uint64_t totalCycles = 0;
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        const auto& job = jobs[i];
+        const auto& result = results[i];
+        totalCycles += result.cycles;
+        failed += result.exit == "error";
+        std::printf("{\"job\":%zu,\"rom\":%s,\"input\":%s,\"exit\":\"%s\",\"error\":%s,\"cycles\":%llu,\"instructions\":%llu,\"seconds\":%.6f,\"output\":%s}\n",
+            i, jsonString(job.romPath).c_str(), jsonString(job.inputPath).c_str(), result.exit.c_str(), jsonString(result.error).c_str(),
+            static_cast<unsigned long long>(result.cycles), static_cast<unsigned long long>(result.instructions), result.seconds,
+            jsonString(result.output).c_str());
+
+        if (!options->outputDir.empty())
+        {
+            std::ofstream(std::filesystem::path(options->outputDir) / fmt::format("{}.out", i), std::ios::binary) << result.output;
+        }
+    }
+    std::fflush(stdout);
+
+    spdlog::info("Ran {} jobs on {} threads in {:.3f} s, {} cycles, effective {:.3f} MHz, {} failed", jobs.size(), pool.getThreadCount(),
+        elapsed.count(), totalCycles, static_cast<double>(totalCycles) / elapsed.count() / 1e6, failed);
+    return failed == 0 ? 0 : 2;
+}
@@ -0,0 +1,57 @@
+// Prints a binary bus trace in the Arduino Mega monitor's text format
+#include "core/bus_trace.h"
+
+#include "spdlog/spdlog.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace EaterEmulator;
+
+int main(int argc, char* argv[])
+{
+    bool verbose = false;
+    std::string path;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg = argv[i];
+        if (arg == "--verbose" || arg == "-v") verbose = true;
+        else if (!arg.starts_with("-") && path.empty()) path = arg;
+        else
+        {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty())
+    {
+        spdlog::info("Usage: {} [--verbose] <trace file>", argv[0]);
+        spdlog::info("  --verbose   Prefix each line with the cycle and program counter");
+        return 1;
+    }
+
+    try
+    {
+        core::BusTraceReader reader(path);
+        std::string line;
+        while (auto record = reader.next())
+        {
+            line.clear();
+            if (verbose)
+            {
+                line = fmt::format("{:>12}  {:04x}  ", record->cycle, record->pc);
+            }
+            line += core::bus_trace::formatArduino(*record);
+            line += '\n';
+            std::fwrite(line.data(), 1, line.size(), stdout);
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        spdlog::error("{}", e.what());
+        return 1;
+    }
+    return 0;
+}